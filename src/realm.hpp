@@ -21,6 +21,9 @@
 
 #include <realm/db.hpp>
 #include <realm/obj.hpp>
+#include <realm/column_scan.hpp>
+#include <realm/projection.hpp>
+#include <realm/arrow_export.hpp>
 #include <realm/list.hpp>
 #include <realm/table_view.hpp>
 #include <realm/query.hpp>
@@ -0,0 +1,681 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/arrow_export.hpp>
+#include <realm/array_basic.hpp>
+#include <realm/array_binary.hpp>
+#include <realm/array_bool.hpp>
+#include <realm/array_integer.hpp>
+#include <realm/array_key.hpp>
+#include <realm/array_object_id.hpp>
+#include <realm/array_string.hpp>
+#include <realm/array_timestamp.hpp>
+#include <realm/query.hpp>
+#include <realm/table_view.hpp>
+#include <realm/util/safe_int_ops.hpp>
+
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+using namespace realm;
+
+namespace {
+
+// The private data of an exported array. The buffers are held by type erased
+// shared pointers, so that vectors of any element type can be handed over
+// without copying.
+struct ArrayData {
+    std::vector<std::shared_ptr<void>> owned_buffers;
+    std::vector<const void*> buffers;
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray*> child_pointers;
+
+    ~ArrayData()
+    {
+        // Children moved away by the consumer have been marked as released
+        for (auto& child : children) {
+            if (child.release)
+                child.release(&child);
+        }
+    }
+
+    template <class T>
+    void add_buffer(std::vector<T>&& buffer)
+    {
+        auto owned = std::make_shared<std::vector<T>>(std::move(buffer));
+        buffers.push_back(owned->data());
+        owned_buffers.push_back(std::move(owned));
+    }
+};
+
+struct SchemaData {
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema*> child_pointers;
+
+    ~SchemaData()
+    {
+        for (auto& child : children) {
+            if (child.release)
+                child.release(&child);
+        }
+    }
+};
+
+void release_array(ArrowArray* array)
+{
+    delete static_cast<ArrayData*>(array->private_data);
+    array->release = nullptr;
+}
+
+void release_schema(ArrowSchema* schema)
+{
+    delete static_cast<SchemaData*>(schema->private_data);
+    schema->release = nullptr;
+}
+
+void init_array(ArrowArray& array, std::unique_ptr<ArrayData> data, size_t length, size_t null_count)
+{
+    for (auto& child : data->children)
+        data->child_pointers.push_back(&child);
+
+    array.length = int64_t(length);
+    array.null_count = int64_t(null_count);
+    array.offset = 0;
+    array.n_buffers = int64_t(data->buffers.size());
+    array.n_children = int64_t(data->children.size());
+    array.buffers = data->buffers.data();
+    array.children = data->child_pointers.empty() ? nullptr : data->child_pointers.data();
+    array.dictionary = nullptr;
+    array.release = release_array;
+    array.private_data = data.release();
+}
+
+void init_schema(ArrowSchema& schema, std::unique_ptr<SchemaData> data, int64_t flags)
+{
+    for (auto& child : data->children)
+        data->child_pointers.push_back(&child);
+
+    schema.format = data->format.c_str();
+    schema.name = data->name.c_str();
+    schema.metadata = nullptr;
+    schema.flags = flags;
+    schema.n_children = int64_t(data->children.size());
+    schema.children = data->child_pointers.empty() ? nullptr : data->child_pointers.data();
+    schema.dictionary = nullptr;
+    schema.release = release_schema;
+    schema.private_data = data.release();
+}
+
+// Bits in the order used by Arrow, least significant bit first
+class Bitmap {
+public:
+    void add(bool value)
+    {
+        if ((m_size & 7) == 0)
+            m_bytes.push_back(0);
+        if (value)
+            m_bytes.back() |= uint8_t(1) << (m_size & 7);
+        ++m_size;
+    }
+
+    std::vector<uint8_t> release()
+    {
+        m_size = 0;
+        return std::move(m_bytes);
+    }
+
+private:
+    std::vector<uint8_t> m_bytes;
+    size_t m_size = 0;
+};
+
+class ColumnExporter {
+public:
+    ColumnExporter(ColKey col_key, bool nullable)
+        : m_col_key(col_key)
+        , m_nullable(nullable)
+    {
+    }
+    virtual ~ColumnExporter() = default;
+
+    virtual void init_leaf(const Cluster& cluster) = 0;
+    /// Appends the values of the first \a size objects of the current leaf
+    virtual void append_leaf(size_t size) = 0;
+    /// Appends the values of the objects at the given indexes in the current leaf
+    virtual void append_rows(const std::vector<size_t>& ndxs) = 0;
+
+    /// Hands the values over to \a array and describes them in \a schema
+    void finish(ArrowArray& array, ArrowSchema& schema, size_t length, StringData name)
+    {
+        auto array_data = std::make_unique<ArrayData>();
+        auto schema_data = std::make_unique<SchemaData>();
+        // The validity bitmap may be left out if there are no nulls
+        if (m_null_count) {
+            array_data->add_buffer(m_validity.release());
+        }
+        else {
+            array_data->buffers.push_back(nullptr);
+        }
+        schema_data->format = add_buffers(*array_data);
+        schema_data->name = name;
+        init_array(array, std::move(array_data), length, m_null_count);
+        init_schema(schema, std::move(schema_data), m_nullable ? ARROW_FLAG_NULLABLE : 0);
+    }
+
+protected:
+    ColKey m_col_key;
+    bool m_nullable;
+
+    void add_validity(bool valid)
+    {
+        if (m_nullable) {
+            m_validity.add(valid);
+            if (!valid)
+                ++m_null_count;
+        }
+    }
+
+    /// Adds the buffers following the validity bitmap and returns the format
+    virtual std::string add_buffers(ArrayData& data) = 0;
+
+private:
+    Bitmap m_validity;
+    size_t m_null_count = 0;
+};
+
+template <class Derived>
+class ColumnExporterBase : public ColumnExporter {
+public:
+    using ColumnExporter::ColumnExporter;
+
+    void append_leaf(size_t size) override
+    {
+        for (size_t i = 0; i < size; ++i)
+            static_cast<Derived*>(this)->append(i);
+    }
+    void append_rows(const std::vector<size_t>& ndxs) override
+    {
+        for (size_t ndx : ndxs)
+            static_cast<Derived*>(this)->append(ndx);
+    }
+};
+
+class IntExporter : public ColumnExporterBase<IntExporter> {
+public:
+    IntExporter(ColKey col_key, Allocator& alloc)
+        : ColumnExporterBase(col_key, col_key.is_nullable())
+        , m_leaf(alloc)
+        , m_null_leaf(alloc)
+    {
+    }
+
+    void init_leaf(const Cluster& cluster) override
+    {
+        if (m_nullable) {
+            cluster.init_leaf(m_col_key, &m_null_leaf);
+        }
+        else {
+            cluster.init_leaf(m_col_key, &m_leaf);
+        }
+    }
+    void append(size_t ndx)
+    {
+        if (m_nullable) {
+            auto value = m_null_leaf.get(ndx);
+            add_validity(bool(value));
+            m_values.push_back(value ? *value : 0);
+        }
+        else {
+            m_values.push_back(m_leaf.get(ndx));
+        }
+    }
+    void append_leaf(size_t size) override
+    {
+        // The values are decoded 8 at a time, so the buffer is rounded up
+        // while decoding
+        size_t begin = m_values.size();
+        m_values.resize(begin + ((size + 7) & ~size_t(7)));
+        int64_t* values = m_values.data() + begin;
+        if (m_nullable) {
+            // The first element of the array holds the value representing null
+            const Array& array = m_null_leaf;
+            int64_t null_value = m_null_leaf.null_value();
+            for (size_t i = 0; i < size; i += 8)
+                array.get_chunk(i + 1, values + i);
+            for (size_t i = 0; i < size; ++i) {
+                bool valid = values[i] != null_value;
+                add_validity(valid);
+                if (!valid)
+                    values[i] = 0;
+            }
+        }
+        else {
+            for (size_t i = 0; i < size; i += 8)
+                m_leaf.get_chunk(i, values + i);
+        }
+        m_values.resize(begin + size);
+    }
+
+private:
+    ArrayInteger m_leaf;
+    ArrayIntNull m_null_leaf;
+    std::vector<int64_t> m_values;
+
+    std::string add_buffers(ArrayData& data) override
+    {
+        data.add_buffer(std::move(m_values));
+        return "l";
+    }
+};
+
+template <class T>
+class FloatExporter : public ColumnExporterBase<FloatExporter<T>> {
+public:
+    FloatExporter(ColKey col_key, Allocator& alloc)
+        : ColumnExporterBase<FloatExporter<T>>(col_key, col_key.is_nullable())
+        , m_leaf(alloc)
+    {
+    }
+
+    void init_leaf(const Cluster& cluster) override
+    {
+        cluster.init_leaf(this->m_col_key, &m_leaf);
+    }
+    void append(size_t ndx)
+    {
+        T value = m_leaf.BasicArray<T>::get(ndx);
+        this->add_validity(!null::is_null_float(value));
+        m_values.push_back(value);
+    }
+    void append_leaf(size_t size) override
+    {
+        // The values are stored unpacked, so they can be copied as they are
+        auto data = reinterpret_cast<const T*>(Array::get_data_from_header(m_leaf.get_header()));
+        m_values.insert(m_values.end(), data, data + size);
+        if (this->m_nullable) {
+            for (size_t i = 0; i < size; ++i)
+                this->add_validity(!null::is_null_float(data[i]));
+        }
+    }
+
+private:
+    BasicArrayNull<T> m_leaf;
+    std::vector<T> m_values;
+
+    std::string add_buffers(ArrayData& data) override
+    {
+        data.add_buffer(std::move(m_values));
+        return std::is_same<T, float>::value ? "f" : "g";
+    }
+};
+
+class BoolExporter : public ColumnExporterBase<BoolExporter> {
+public:
+    BoolExporter(ColKey col_key, Allocator& alloc)
+        : ColumnExporterBase(col_key, col_key.is_nullable())
+        , m_leaf(alloc)
+    {
+    }
+
+    void init_leaf(const Cluster& cluster) override
+    {
+        // The nullable leaf shares the layout of the non-nullable one
+        cluster.init_leaf(m_col_key, &m_leaf);
+    }
+    void append(size_t ndx)
+    {
+        auto value = m_leaf.get(ndx);
+        add_validity(bool(value));
+        m_values.add(value && *value);
+    }
+
+private:
+    ArrayBoolNull m_leaf;
+    Bitmap m_values;
+
+    std::string add_buffers(ArrayData& data) override
+    {
+        data.add_buffer(m_values.release());
+        return "b";
+    }
+};
+
+class TimestampExporter : public ColumnExporterBase<TimestampExporter> {
+public:
+    TimestampExporter(ColKey col_key, Allocator& alloc)
+        : ColumnExporterBase(col_key, col_key.is_nullable())
+        , m_leaf(alloc)
+    {
+    }
+
+    void init_leaf(const Cluster& cluster) override
+    {
+        cluster.init_leaf(m_col_key, &m_leaf);
+    }
+    void append(size_t ndx)
+    {
+        bool valid = !m_leaf.is_null(ndx);
+        add_validity(valid);
+        int64_t value = 0;
+        if (valid) {
+            Timestamp ts = m_leaf.get(ndx);
+            value = ts.get_seconds();
+            if (util::int_multiply_with_overflow_detect(value, 1000000000) ||
+                util::int_add_with_overflow_detect(value, ts.get_nanoseconds()))
+                throw std::overflow_error("Timestamp out of range of Arrow timestamp");
+        }
+        m_values.push_back(value);
+    }
+
+private:
+    ArrayTimestamp m_leaf;
+    std::vector<int64_t> m_values;
+
+    std::string add_buffers(ArrayData& data) override
+    {
+        data.add_buffer(std::move(m_values));
+        return "tsn:";
+    }
+};
+
+class ObjectIdExporter : public ColumnExporterBase<ObjectIdExporter> {
+public:
+    ObjectIdExporter(ColKey col_key, Allocator& alloc)
+        : ColumnExporterBase(col_key, col_key.is_nullable())
+        , m_leaf(alloc)
+    {
+    }
+
+    void init_leaf(const Cluster& cluster) override
+    {
+        // The nullable leaf shares the layout of the non-nullable one
+        cluster.init_leaf(m_col_key, &m_leaf);
+    }
+    void append(size_t ndx)
+    {
+        auto value = m_leaf.get(ndx);
+        add_validity(bool(value));
+        auto bytes = value ? value->to_bytes() : ObjectId::ObjectIdBytes{};
+        m_values.insert(m_values.end(), bytes.begin(), bytes.end());
+    }
+
+private:
+    ArrayObjectIdNull m_leaf;
+    std::vector<uint8_t> m_values;
+
+    std::string add_buffers(ArrayData& data) override
+    {
+        data.add_buffer(std::move(m_values));
+        return "w:" + std::to_string(sizeof(ObjectId::ObjectIdBytes));
+    }
+};
+
+class LinkExporter : public ColumnExporterBase<LinkExporter> {
+public:
+    // Links may always be null
+    LinkExporter(ColKey col_key, Allocator& alloc)
+        : ColumnExporterBase(col_key, true)
+        , m_leaf(alloc)
+    {
+    }
+
+    void init_leaf(const Cluster& cluster) override
+    {
+        cluster.init_leaf(m_col_key, &m_leaf);
+    }
+    void append(size_t ndx)
+    {
+        ObjKey key = m_leaf.get(ndx);
+        bool valid = key && !key.is_unresolved();
+        add_validity(valid);
+        m_values.push_back(valid ? key.value : 0);
+    }
+
+private:
+    ArrayKey m_leaf;
+    std::vector<int64_t> m_values;
+
+    std::string add_buffers(ArrayData& data) override
+    {
+        data.add_buffer(std::move(m_values));
+        return "l";
+    }
+};
+
+// Strings and binaries are packed into a data buffer and a buffer of offsets
+// into it
+template <class LeafType>
+class BlobExporter : public ColumnExporterBase<BlobExporter<LeafType>> {
+public:
+    static constexpr bool is_string = std::is_same<LeafType, ArrayString>::value;
+
+    BlobExporter(ColKey col_key, Allocator& alloc)
+        : ColumnExporterBase<BlobExporter<LeafType>>(col_key, col_key.is_nullable())
+        , m_leaf(alloc)
+    {
+        m_offsets.push_back(0);
+    }
+
+    void init_leaf(const Cluster& cluster) override
+    {
+        cluster.init_leaf(this->m_col_key, &m_leaf);
+    }
+    void append(size_t ndx)
+    {
+        auto value = m_leaf.get(ndx);
+        this->add_validity(!value.is_null());
+        m_data.insert(m_data.end(), value.data(), value.data() + value.size());
+        m_offsets.push_back(int64_t(m_data.size()));
+    }
+
+private:
+    LeafType m_leaf;
+    std::vector<int64_t> m_offsets;
+    std::vector<char> m_data;
+
+    std::string add_buffers(ArrayData& data) override
+    {
+        // Use 32 bit offsets unless the data is too large for them
+        bool large = m_data.size() > size_t(std::numeric_limits<int32_t>::max());
+        if (large) {
+            data.add_buffer(std::move(m_offsets));
+        }
+        else {
+            data.add_buffer(std::vector<int32_t>(m_offsets.begin(), m_offsets.end()));
+        }
+        data.add_buffer(std::move(m_data));
+        if (is_string)
+            return large ? "U" : "u";
+        return large ? "Z" : "z";
+    }
+};
+
+std::unique_ptr<ColumnExporter> create_exporter(ColKey col_key, Allocator& alloc)
+{
+    switch (col_key.get_type()) {
+        case col_type_Int:
+            return std::make_unique<IntExporter>(col_key, alloc);
+        case col_type_Bool:
+            return std::make_unique<BoolExporter>(col_key, alloc);
+        case col_type_Float:
+            return std::make_unique<FloatExporter<float>>(col_key, alloc);
+        case col_type_Double:
+            return std::make_unique<FloatExporter<double>>(col_key, alloc);
+        case col_type_String:
+            return std::make_unique<BlobExporter<ArrayString>>(col_key, alloc);
+        case col_type_Binary:
+            return std::make_unique<BlobExporter<ArrayBinary>>(col_key, alloc);
+        case col_type_Timestamp:
+            return std::make_unique<TimestampExporter>(col_key, alloc);
+        case col_type_ObjectId:
+            return std::make_unique<ObjectIdExporter>(col_key, alloc);
+        case col_type_Link:
+            return std::make_unique<LinkExporter>(col_key, alloc);
+        default:
+            break;
+    }
+    throw LogicError(LogicError::type_mismatch);
+}
+
+} // anonymous namespace
+
+namespace realm {
+
+// Collects the values of the exported objects one leaf at a time
+class ArrowExporter {
+public:
+    ArrowExporter(const Table& table, const std::vector<ColKey>& col_keys)
+        : m_table(table)
+        , m_col_keys(col_keys)
+        , m_leaf(0, table.get_alloc(), table.m_clusters)
+        , m_state(m_leaf)
+    {
+        if (m_col_keys.empty()) {
+            for (auto col_key : table.get_column_keys())
+                m_col_keys.push_back(col_key);
+        }
+        for (auto col_key : m_col_keys) {
+            m_table.check_column(col_key);
+            if (col_key.is_list())
+                throw LogicError(LogicError::list_type_mismatch);
+            m_columns.push_back(create_exporter(col_key, m_table.get_alloc()));
+        }
+    }
+
+    void add_all()
+    {
+        m_table.traverse_clusters([&](const Cluster* cluster) {
+            size_t sz = cluster->node_size();
+            for (auto& column : m_columns) {
+                column->init_leaf(*cluster);
+                column->append_leaf(sz);
+            }
+            m_length += sz;
+            return false;
+        });
+    }
+
+    // Null keys are skipped
+    void add(ObjKey key)
+    {
+        if (!key)
+            return;
+        if (m_has_leaf) {
+            // Stay in the current leaf if it holds the object
+            int64_t relative = key.value - int64_t(m_leaf.get_offset());
+            if (relative >= 0 && relative <= m_leaf.get_last_key_value()) {
+                size_t ndx = m_leaf.lower_bound_key(ObjKey(relative));
+                if (ndx < m_leaf.node_size() && m_leaf.get_real_key(ndx) == key) {
+                    m_ndxs.push_back(ndx);
+                    return;
+                }
+            }
+        }
+
+        flush();
+        m_has_leaf = false;
+        if (key.is_unresolved() || !m_table.m_clusters.get_leaf(key, m_state) ||
+            m_leaf.get_real_key(m_state.m_current_index) != key)
+            throw KeyNotFound("No such object");
+        m_has_leaf = true;
+        for (auto& column : m_columns)
+            column->init_leaf(m_leaf);
+        m_ndxs.push_back(m_state.m_current_index);
+    }
+
+    void finish(ArrowArray* array, ArrowSchema* schema)
+    {
+        flush();
+        size_t num_cols = m_columns.size();
+        auto array_data = std::make_unique<ArrayData>();
+        auto schema_data = std::make_unique<SchemaData>();
+        array_data->children.resize(num_cols);
+        schema_data->children.resize(num_cols);
+        for (size_t i = 0; i < num_cols; ++i) {
+            m_columns[i]->finish(array_data->children[i], schema_data->children[i], m_length,
+                                 m_table.get_column_name(m_col_keys[i]));
+        }
+        // A struct array has no buffers besides the validity bitmap, which
+        // is left out as all objects are present
+        array_data->buffers.push_back(nullptr);
+        schema_data->format = "+s";
+        init_array(*array, std::move(array_data), m_length, 0);
+        init_schema(*schema, std::move(schema_data), 0);
+    }
+
+private:
+    const Table& m_table;
+    std::vector<ColKey> m_col_keys;
+    std::vector<std::unique_ptr<ColumnExporter>> m_columns;
+    Cluster m_leaf;
+    ClusterNode::IteratorState m_state;
+    bool m_has_leaf = false;
+    // Indexes in the current leaf of the objects not yet appended
+    std::vector<size_t> m_ndxs;
+    size_t m_length = 0;
+
+    void flush()
+    {
+        if (m_ndxs.empty())
+            return;
+        for (auto& column : m_columns)
+            column->append_rows(m_ndxs);
+        m_length += m_ndxs.size();
+        m_ndxs.clear();
+    }
+};
+
+void export_to_arrow(const Table& table, const std::vector<ColKey>& col_keys, ArrowArray* array,
+                     ArrowSchema* schema)
+{
+    ArrowExporter exporter(table, col_keys);
+    exporter.add_all();
+    exporter.finish(array, schema);
+}
+
+void export_to_arrow(const ConstTableView& view, const std::vector<ColKey>& col_keys, ArrowArray* array,
+                     ArrowSchema* schema)
+{
+    if (!view.is_attached())
+        throw LogicError(LogicError::detached_accessor);
+    ArrowExporter exporter(*view.get_target_table(), col_keys);
+    size_t sz = view.size();
+    for (size_t i = 0; i < sz; ++i)
+        exporter.add(view.get_key(i));
+    exporter.finish(array, schema);
+}
+
+void export_to_arrow(Query& query, const std::vector<ColKey>& col_keys, ArrowArray* array, ArrowSchema* schema)
+{
+    if (!query.get_table())
+        throw LogicError(LogicError::detached_accessor);
+    ArrowExporter exporter(*query.get_table(), col_keys);
+    QueryCursor cursor = query.iterate();
+    std::vector<ObjKey> keys;
+    while (cursor.next_batch(keys)) {
+        for (ObjKey key : keys)
+            exporter.add(key);
+    }
+    exporter.finish(array, schema);
+}
+
+} // namespace realm
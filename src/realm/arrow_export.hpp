@@ -0,0 +1,126 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_ARROW_EXPORT_HPP
+#define REALM_ARROW_EXPORT_HPP
+
+#include <realm/table.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// The structs of the Apache Arrow C Data Interface, declared exactly as in the
+// specification so that they are compatible with the ones of any Arrow
+// implementation (https://arrow.apache.org/docs/format/CDataInterface.html).
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    // Array type description
+    const char* format;
+    const char* name;
+    const char* metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema** children;
+    struct ArrowSchema* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void** buffers;
+    struct ArrowArray** children;
+    struct ArrowArray* dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray*);
+    // Opaque producer-specific data
+    void* private_data;
+};
+
+} // extern "C"
+
+#endif // ARROW_C_DATA_INTERFACE
+
+namespace realm {
+
+class ConstTableView;
+class Query;
+
+/// Exports the values of the given columns of a table as an Arrow struct array
+/// with one child array per column, and its schema. If \a col_keys is empty,
+/// all columns of the table are exported. The objects are exported in the
+/// order of the table, and the fixed width values are copied one leaf at a
+/// time.
+///
+/// The columns are exported as follows:
+///
+///     Int         int64 ("l")
+///     Bool        boolean ("b")
+///     Float       float32 ("f")
+///     Double      float64 ("g")
+///     String      utf8 ("u"), or large utf8 ("U") above 2GB of data
+///     Binary      binary ("z"), or large binary ("Z") above 2GB of data
+///     Timestamp   timestamp in nanoseconds ("tsn:")
+///     ObjectId    fixed size binary of 12 bytes ("w:12")
+///     Link        int64 ("l") holding the key of the target object
+///
+/// Nulls, and links to removed objects, become unset bits of the validity
+/// bitmap of the child array.
+///
+/// The exported arrays own a copy of the data, so they stay valid when the
+/// transaction ends. The caller takes ownership of \a array and \a schema and
+/// must free them by calling their release callbacks, as described by the
+/// specification.
+///
+/// Throws LogicError if one of the columns is a list column or a Decimal or
+/// Mixed column, which have no direct Arrow equivalent, and
+/// std::overflow_error if a timestamp cannot be represented in nanoseconds.
+void export_to_arrow(const Table& table, const std::vector<ColKey>& col_keys, ArrowArray* array,
+                     ArrowSchema* schema);
+
+/// Like the above, but exports the objects of a view in the order of the view.
+/// The objects are looked up one leaf at a time, so this is most efficient for
+/// views sorted by key, like the ones created by a query.
+void export_to_arrow(const ConstTableView& view, const std::vector<ColKey>& col_keys, ArrowArray* array,
+                     ArrowSchema* schema);
+
+/// Like the above, but exports the objects matching a query. The matches are
+/// exported as they are found, leaf by leaf, without creating a view.
+void export_to_arrow(Query& query, const std::vector<ColKey>& col_keys, ArrowArray* array,
+                     ArrowSchema* schema);
+
+} // namespace realm
+
+#endif // REALM_ARROW_EXPORT_HPP
@@ -35,19 +35,10 @@
 #include "realm/replication.hpp"
 #include <iostream>
 #include <cmath>
+#include <numeric>
 
 using namespace realm;
 
-namespace {
-#if REALM_MAX_BPNODE_SIZE > 256
-constexpr int node_shift_factor = 8;
-#else
-constexpr int node_shift_factor = 2;
-#endif
-
-constexpr size_t cluster_node_size = 1 << node_shift_factor;
-}
-
 /*
  * Node-splitting is done in the way that if the new element comes after all the
  * current elements, then the new element is added to the new node as the only
@@ -89,6 +80,7 @@ public:
     }
 
     bool traverse(ClusterTree::TraverseFunction func, int64_t) const;
+    bool traverse_range(ClusterTree::TraverseFunction func, int64_t, int64_t begin, int64_t end) const;
     void update(ClusterTree::UpdateFunction func, int64_t);
 
     size_t node_size() const override
@@ -111,10 +103,12 @@ public:
     void insert_column(ColKey col) override;
     void remove_column(ColKey col) override;
     ref_type insert(ObjKey k, const FieldValues& init_values, State& state) override;
+    ref_type append_leaf(ObjKey first_key, ref_type leaf_ref, size_t leaf_size, State& state) override;
     bool try_get(ObjKey k, State& state) const override;
     ObjKey get(size_t ndx, State& state) const override;
     size_t get_ndx(ObjKey key, size_t ndx) const override;
     size_t erase(ObjKey k, CascadeState& state) override;
+    size_t erase_run(const ObjKey* begin, const ObjKey* end, size_t& erased, CascadeState& state) override;
     void nullify_incoming_links(ObjKey key, CascadeState& state) override;
     void add(ref_type ref, int64_t key_value = 0);
 
@@ -191,6 +185,12 @@ private:
         Array::erase(ndx + s_first_node_index);
     }
     void move(size_t ndx, ClusterNode* new_node, int64_t key_adj) override;
+    // Insert 'new_sibling_ref' after the child described by 'child_info', splitting
+    // this node if it is full. Return reference to new node created (if any)
+    ref_type insert_sibling(ChildInfo& child_info, ref_type new_sibling_ref, ClusterNode::State& state);
+    // Remove the child 'erase_node' if it has become empty, or merge it with its
+    // next sibling if they are both small
+    void remove_or_merge_child(ClusterNode* erase_node, size_t erase_node_size, ChildInfo& child_info);
 
     template <class T, class F>
     T recurse(ObjKey key, F func);
@@ -248,7 +248,7 @@ void ClusterNodeInner::create(int sub_tree_depth)
     Array::set(s_sub_tree_depth_index, RefOrTagged::make_tagged(sub_tree_depth));
     Array::set(s_sub_tree_size, 1); // sub_tree_size = 0 (as tagged value)
     m_sub_tree_depth = sub_tree_depth;
-    m_shift_factor = m_sub_tree_depth * node_shift_factor;
+    m_shift_factor = m_sub_tree_depth * m_tree_top.get_node_shift_factor();
 }
 
 void ClusterNodeInner::init(MemRef mem)
@@ -263,7 +263,7 @@ void ClusterNodeInner::init(MemRef mem)
         m_keys.detach();
     }
     m_sub_tree_depth = int(Array::get(s_sub_tree_depth_index)) >> 1;
-    m_shift_factor = m_sub_tree_depth * node_shift_factor;
+    m_shift_factor = m_sub_tree_depth * m_tree_top.get_node_shift_factor();
 }
 
 void ClusterNodeInner::update_from_parent() noexcept
@@ -322,44 +322,65 @@ ref_type ClusterNodeInner::insert(ObjKey key, const FieldValues& init_values, Cl
             return ref_type(0);
         }
 
-        size_t new_ref_ndx = child_info.ndx + 1;
+        return insert_sibling(child_info, new_sibling_ref, state);
+    });
+}
 
-        int64_t split_key_value = state.split_key + child_info.offset;
-        size_t sz = node_size();
-        if (sz < cluster_node_size) {
-            if (m_keys.is_attached()) {
-                m_keys.insert(new_ref_ndx, split_key_value);
-            }
-            else {
-                if (size_t(split_key_value) != sz << m_shift_factor) {
-                    ensure_general_form();
-                    m_keys.insert(new_ref_ndx, split_key_value);
-                }
-            }
-            _insert_child_ref(new_ref_ndx, new_sibling_ref);
+ref_type ClusterNodeInner::append_leaf(ObjKey first_key, ref_type leaf_ref, size_t leaf_size,
+                                       ClusterNode::State& state)
+{
+    return recurse<ref_type>(first_key, [&](ClusterNode* node, ChildInfo& child_info) {
+        ref_type new_sibling_ref = node->append_leaf(child_info.key, leaf_ref, leaf_size, state);
+
+        set_tree_size(get_tree_size() + leaf_size);
+
+        if (!new_sibling_ref) {
             return ref_type(0);
         }
 
-        ClusterNodeInner child(m_alloc, m_tree_top);
-        child.create(m_sub_tree_depth);
-        if (new_ref_ndx == sz) {
-            child.add(new_sibling_ref);
-            state.split_key = split_key_value;
+        return insert_sibling(child_info, new_sibling_ref, state);
+    });
+}
+
+ref_type ClusterNodeInner::insert_sibling(ChildInfo& child_info, ref_type new_sibling_ref, ClusterNode::State& state)
+{
+    size_t new_ref_ndx = child_info.ndx + 1;
+
+    int64_t split_key_value = state.split_key + child_info.offset;
+    size_t sz = node_size();
+    if (sz < m_tree_top.get_node_size()) {
+        if (m_keys.is_attached()) {
+            m_keys.insert(new_ref_ndx, split_key_value);
         }
         else {
-            int64_t first_key_value = m_keys.get(new_ref_ndx);
-            child.ensure_general_form();
-            move(new_ref_ndx, &child, first_key_value);
-            add(new_sibling_ref, split_key_value); // Throws
-            state.split_key = first_key_value;
+            if (size_t(split_key_value) != sz << m_shift_factor) {
+                ensure_general_form();
+                m_keys.insert(new_ref_ndx, split_key_value);
+            }
         }
+        _insert_child_ref(new_ref_ndx, new_sibling_ref);
+        return ref_type(0);
+    }
 
-        // Some objects has been moved out of this tree - find out how many
-        size_t child_sub_tree_size = child.update_sub_tree_size();
-        set_tree_size(get_tree_size() - child_sub_tree_size);
+    ClusterNodeInner child(m_alloc, m_tree_top);
+    child.create(m_sub_tree_depth);
+    if (new_ref_ndx == sz) {
+        child.add(new_sibling_ref);
+        state.split_key = split_key_value;
+    }
+    else {
+        int64_t first_key_value = m_keys.get(new_ref_ndx);
+        child.ensure_general_form();
+        move(new_ref_ndx, &child, first_key_value);
+        add(new_sibling_ref, split_key_value); // Throws
+        state.split_key = first_key_value;
+    }
 
-        return child.get_ref();
-    });
+    // Some objects has been moved out of this tree - find out how many
+    size_t child_sub_tree_size = child.update_sub_tree_size();
+    set_tree_size(get_tree_size() - child_sub_tree_size);
+
+    return child.get_ref();
 }
 
 bool ClusterNodeInner::try_get(ObjKey key, ClusterNode::State& state) const
@@ -474,62 +495,111 @@ size_t ClusterNodeInner::erase(ObjKey key, CascadeState& state)
 {
     return recurse<size_t>(key, [this, &state](ClusterNode* erase_node, ChildInfo& child_info) {
         size_t erase_node_size = erase_node->erase(child_info.key, state);
-        bool is_leaf = erase_node->is_leaf();
         set_tree_size(get_tree_size() - 1);
+        remove_or_merge_child(erase_node, erase_node_size, child_info);
+        return node_size();
+    });
+}
 
-        if (erase_node_size == 0) {
-            erase_node->destroy_deep();
+size_t ClusterNodeInner::erase_run(const ObjKey* begin, const ObjKey* end, size_t& erased, CascadeState& state)
+{
+    ObjKey key(begin->value - m_offset);
+    ChildInfo child_info;
+    if (!find_child(key, child_info)) {
+        throw KeyNotFound("Child not found in erase_run");
+    }
 
-            ensure_general_form();
-            _erase_child_ref(child_info.ndx);
-            m_keys.erase(child_info.ndx);
-            if (child_info.ndx == 0 && m_keys.size() > 0) {
-                auto first_offset = m_keys.get(0);
-                // Adjust all key values in new first node
-                // We have to make sure that the first key offset value
-                // in all inner nodes is 0
-                adjust_keys_first_child(first_offset);
-            }
-        }
-        else if (erase_node_size < cluster_node_size / 2 && child_info.ndx < (node_size() - 1)) {
-            // Candidate for merge. First calculate if the combined size of current and
-            // next sibling is small enough.
-            size_t sibling_ndx = child_info.ndx + 1;
-            Cluster l2(child_info.offset, m_alloc, m_tree_top);
-            ClusterNodeInner n2(m_alloc, m_tree_top);
-            ClusterNode* sibling_node = is_leaf ? static_cast<ClusterNode*>(&l2) : static_cast<ClusterNode*>(&n2);
-            sibling_node->set_parent(this, sibling_ndx + s_first_node_index);
-            sibling_node->init_from_parent();
-
-            size_t combined_size = sibling_node->node_size() + erase_node_size;
-
-            if (combined_size < cluster_node_size * 3 / 4) {
-                // Calculate value that must be subtracted from the moved keys
-                // (will be negative as the sibling has bigger keys)
-                int64_t key_adj = m_keys.is_attached() ? (m_keys.get(child_info.ndx) - m_keys.get(sibling_ndx))
-                                                       : 0 - (1 << m_shift_factor);
-                // And then move all elements into current node
-                sibling_node->ensure_general_form();
-                erase_node->ensure_general_form();
-                sibling_node->move(0, erase_node, key_adj);
-
-                if (!erase_node->is_leaf()) {
-                    static_cast<ClusterNodeInner*>(erase_node)->update_sub_tree_size();
+    // A subtree holding only objects to be erased is detached as a whole. This
+    // is only possible if no backlinks have to be removed from other tables.
+    bool child_is_leaf = !Array::get_is_inner_bptree_node_from_header(child_info.mem.get_addr());
+    auto table = const_cast<Table*>(m_tree_top.get_owner());
+    if (!child_is_leaf && !table->for_each_public_column([](ColKey col_key) {
+            auto type = col_key.get_type();
+            return type == col_type_Link || type == col_type_LinkList;
+        })) {
+        ClusterNodeInner node(m_alloc, m_tree_top);
+        node.set_parent(this, child_info.ndx + s_first_node_index);
+        node.init(child_info.mem);
+        node.set_offset(child_info.offset + m_offset);
+        size_t subtree_size = node.get_tree_size();
+        ObjKey last_key(node.get_offset() + node.get_last_key_value());
+        if (size_t(std::upper_bound(begin, end, last_key) - begin) == subtree_size) {
+            Replication* repl = table->get_repl();
+            for (auto it = begin; it != begin + subtree_size; ++it) {
+                table->free_local_id_after_hash_collision(*it);
+                if (repl) {
+                    repl->remove_object(table, *it);
                 }
-
-                // Destroy sibling
-                sibling_node->destroy_deep();
-
-                ensure_general_form();
-                _erase_child_ref(sibling_ndx);
-                m_keys.erase(sibling_ndx);
             }
+            erased = subtree_size;
+            set_tree_size(get_tree_size() - erased);
+            remove_or_merge_child(&node, 0, child_info);
+            return node_size();
         }
+    }
 
+    return recurse<size_t>(child_info, [&](ClusterNode* erase_node, ChildInfo& info) {
+        size_t erase_node_size = erase_node->erase_run(begin, end, erased, state);
+        set_tree_size(get_tree_size() - erased);
+        remove_or_merge_child(erase_node, erase_node_size, info);
         return node_size();
     });
 }
 
+void ClusterNodeInner::remove_or_merge_child(ClusterNode* erase_node, size_t erase_node_size, ChildInfo& child_info)
+{
+    bool is_leaf = erase_node->is_leaf();
+
+    if (erase_node_size == 0) {
+        erase_node->destroy_deep();
+
+        ensure_general_form();
+        _erase_child_ref(child_info.ndx);
+        m_keys.erase(child_info.ndx);
+        if (child_info.ndx == 0 && m_keys.size() > 0) {
+            auto first_offset = m_keys.get(0);
+            // Adjust all key values in new first node
+            // We have to make sure that the first key offset value
+            // in all inner nodes is 0
+            adjust_keys_first_child(first_offset);
+        }
+    }
+    else if (erase_node_size < m_tree_top.get_node_size() / 2 && child_info.ndx < (node_size() - 1)) {
+        // Candidate for merge. First calculate if the combined size of current and
+        // next sibling is small enough.
+        size_t sibling_ndx = child_info.ndx + 1;
+        Cluster l2(child_info.offset, m_alloc, m_tree_top);
+        ClusterNodeInner n2(m_alloc, m_tree_top);
+        ClusterNode* sibling_node = is_leaf ? static_cast<ClusterNode*>(&l2) : static_cast<ClusterNode*>(&n2);
+        sibling_node->set_parent(this, sibling_ndx + s_first_node_index);
+        sibling_node->init_from_parent();
+
+        size_t combined_size = sibling_node->node_size() + erase_node_size;
+
+        if (combined_size < m_tree_top.get_node_size() * 3 / 4) {
+            // Calculate value that must be subtracted from the moved keys
+            // (will be negative as the sibling has bigger keys)
+            int64_t key_adj = m_keys.is_attached() ? (m_keys.get(child_info.ndx) - m_keys.get(sibling_ndx))
+                                                   : 0 - (1 << m_shift_factor);
+            // And then move all elements into current node
+            sibling_node->ensure_general_form();
+            erase_node->ensure_general_form();
+            sibling_node->move(0, erase_node, key_adj);
+
+            if (!erase_node->is_leaf()) {
+                static_cast<ClusterNodeInner*>(erase_node)->update_sub_tree_size();
+            }
+
+            // Destroy sibling
+            sibling_node->destroy_deep();
+
+            ensure_general_form();
+            _erase_child_ref(sibling_ndx);
+            m_keys.erase(sibling_ndx);
+        }
+    }
+}
+
 void ClusterNodeInner::nullify_incoming_links(ObjKey key, CascadeState& state)
 {
     recurse<void>(key, [&state](ClusterNode* node, ChildInfo& child_info) {
@@ -716,6 +786,46 @@ bool ClusterNodeInner::traverse(ClusterTree::TraverseFunction func, int64_t key_
     return false;
 }
 
+bool ClusterNodeInner::traverse_range(ClusterTree::TraverseFunction func, int64_t key_offset, int64_t begin,
+                                      int64_t end) const
+{
+    auto sz = node_size();
+
+    for (unsigned i = 0; i < sz; i++) {
+        int64_t offs = (m_keys.is_attached() ? m_keys.get(i) : i << m_shift_factor) + key_offset;
+        // All keys in a child are at least the offset of the child and less
+        // than the offset of the next child
+        if (offs >= end) {
+            break;
+        }
+        if (i + 1 < sz) {
+            int64_t next_offs = (m_keys.is_attached() ? m_keys.get(i + 1) : (i + 1) << m_shift_factor) + key_offset;
+            if (next_offs <= begin) {
+                continue;
+            }
+        }
+        ref_type ref = _get_child_ref(i);
+        char* header = m_alloc.translate(ref);
+        bool child_is_leaf = !Array::get_is_inner_bptree_node_from_header(header);
+        MemRef mem(header, ref, m_alloc);
+        if (child_is_leaf) {
+            Cluster leaf(offs, m_alloc, m_tree_top);
+            leaf.init(mem);
+            if (func(&leaf)) {
+                return true;
+            }
+        }
+        else {
+            ClusterNodeInner node(m_alloc, m_tree_top);
+            node.init(mem);
+            if (node.traverse_range(func, offs, begin, end)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
 void ClusterNodeInner::update(ClusterTree::UpdateFunction func, int64_t key_offset)
 {
     auto sz = node_size();
@@ -1043,6 +1153,205 @@ void Cluster::insert_row(size_t ndx, ObjKey k, const FieldValues& init_values)
     table->for_each_and_every_column(insert_in_column);
 }
 
+template <class T>
+inline void Cluster::do_append_rows(ColKey col, const ColumnValues* values, size_t begin, size_t end,
+                                    bool nullable)
+{
+    using U = typename util::RemoveOptional<typename T::value_type>::type;
+
+    T arr(m_alloc);
+    auto col_ndx = col.get_index();
+    arr.set_parent(this, col_ndx.val + s_first_col_index);
+    set_spec<T>(arr, col_ndx);
+    arr.init_from_parent();
+    for (size_t i = begin; i < end; i++) {
+        Mixed val = values ? values->values[i] : Mixed();
+        if (val.is_null()) {
+            arr.add(T::default_value(nullable));
+        }
+        else {
+            arr.add(val.get<U>());
+        }
+    }
+}
+
+void Cluster::append_rows(const std::vector<ObjKey>& keys, size_t begin, size_t end, int64_t key_offset,
+                          const std::vector<const ColumnValues*>& columns)
+{
+    REALM_ASSERT(node_size() == 0 && end - begin <= m_tree_top.get_node_size());
+    size_t num_rows = end - begin;
+    int64_t last_key_value = keys[end - 1].value - key_offset;
+
+    // Keys are ascending, so they can only be in compact form if they are consecutive
+    if (keys[begin].value == key_offset && size_t(last_key_value) == num_rows - 1) {
+        Array::set(s_key_ref_or_size_index, RefOrTagged::make_tagged(num_rows));
+    }
+    else {
+        m_keys.create(num_rows, uint64_t(last_key_value));
+        m_keys.update_parent();
+        for (size_t i = 0; i < num_rows; i++) {
+            m_keys.set(i, uint64_t(keys[begin + i].value - key_offset));
+        }
+    }
+
+    auto val = columns.begin();
+    auto table = m_tree_top.get_owner();
+    auto append_to_column = [&](ColKey col_key) {
+        auto col_ndx = col_key.get_index();
+        auto attr = col_key.get_attrs();
+        // columns must be sorted in col_ndx order - this is ensured by ClusterTree::bulk_insert()
+        const ColumnValues* values = nullptr;
+        if (val != columns.end() && (*val)->col_key.get_index().val == col_ndx.val) {
+            values = *val;
+            ++val;
+        }
+
+        if (attr.test(col_attr_List)) {
+            ArrayRef arr(m_alloc);
+            arr.set_parent(this, col_ndx.val + s_first_col_index);
+            arr.init_from_parent();
+            for (size_t i = begin; i < end; i++) {
+                arr.add(0);
+            }
+            return false;
+        }
+
+        bool nullable = attr.test(col_attr_Nullable);
+        auto type = col_key.get_type();
+        switch (type) {
+            case col_type_Int:
+                if (attr.test(col_attr_Nullable)) {
+                    do_append_rows<ArrayIntNull>(col_key, values, begin, end, nullable);
+                }
+                else {
+                    do_append_rows<ArrayInteger>(col_key, values, begin, end, nullable);
+                }
+                break;
+            case col_type_Bool:
+                do_append_rows<ArrayBoolNull>(col_key, values, begin, end, nullable);
+                break;
+            case col_type_Float:
+                do_append_rows<ArrayFloatNull>(col_key, values, begin, end, nullable);
+                break;
+            case col_type_Double:
+                do_append_rows<ArrayDoubleNull>(col_key, values, begin, end, nullable);
+                break;
+            case col_type_String:
+                do_append_rows<ArrayString>(col_key, values, begin, end, nullable);
+                break;
+            case col_type_Binary:
+                do_append_rows<ArrayBinary>(col_key, values, begin, end, nullable);
+                break;
+            case col_type_OldMixed: {
+                ArrayMixed arr(m_alloc);
+                arr.set_parent(this, col_ndx.val + s_first_col_index);
+                arr.init_from_parent();
+                for (size_t i = begin; i < end; i++) {
+                    arr.add(values ? values->values[i] : Mixed());
+                }
+                break;
+            }
+            case col_type_Timestamp:
+                do_append_rows<ArrayTimestamp>(col_key, values, begin, end, nullable);
+                break;
+            case col_type_Decimal:
+                do_append_rows<ArrayDecimal128>(col_key, values, begin, end, nullable);
+                break;
+            case col_type_ObjectId:
+                do_append_rows<ArrayObjectIdNull>(col_key, values, begin, end, nullable);
+                break;
+            case col_type_Link: {
+                // Backlinks are added by ClusterTree::bulk_insert() once the leaf is attached
+                ArrayKey arr(m_alloc);
+                arr.set_parent(this, col_ndx.val + s_first_col_index);
+                arr.init_from_parent();
+                for (size_t i = begin; i < end; i++) {
+                    Mixed v = values ? values->values[i] : Mixed();
+                    arr.add(v.is_null() ? ObjKey() : v.get<ObjKey>());
+                }
+                break;
+            }
+            case col_type_BackLink: {
+                ArrayBacklink arr(m_alloc);
+                arr.set_parent(this, col_ndx.val + s_first_col_index);
+                arr.init_from_parent();
+                for (size_t i = begin; i < end; i++) {
+                    arr.add(0);
+                }
+                break;
+            }
+            default:
+                REALM_ASSERT(false);
+                break;
+        }
+        return false;
+    };
+    table->for_each_and_every_column(append_to_column);
+}
+
+template <class T>
+inline void Cluster::do_set_rows(ColKey col, const std::vector<size_t>& ndxs, const std::vector<Mixed>& values,
+                                 bool nullable)
+{
+    using U = typename util::RemoveOptional<typename T::value_type>::type;
+
+    T arr(m_alloc);
+    auto col_ndx = col.get_index();
+    arr.set_parent(this, col_ndx.val + s_first_col_index);
+    set_spec<T>(arr, col_ndx);
+    arr.init_from_parent();
+    for (size_t i = 0; i < ndxs.size(); i++) {
+        if (values[i].is_null()) {
+            arr.set(ndxs[i], T::default_value(nullable));
+        }
+        else {
+            arr.set(ndxs[i], values[i].get<U>());
+        }
+    }
+}
+
+void Cluster::set_rows(ColKey col_key, const std::vector<size_t>& ndxs, const std::vector<Mixed>& values)
+{
+    bool nullable = col_key.get_attrs().test(col_attr_Nullable);
+    switch (col_key.get_type()) {
+        case col_type_Int:
+            if (nullable) {
+                do_set_rows<ArrayIntNull>(col_key, ndxs, values, nullable);
+            }
+            else {
+                do_set_rows<ArrayInteger>(col_key, ndxs, values, nullable);
+            }
+            break;
+        case col_type_Bool:
+            do_set_rows<ArrayBoolNull>(col_key, ndxs, values, nullable);
+            break;
+        case col_type_Float:
+            do_set_rows<ArrayFloatNull>(col_key, ndxs, values, nullable);
+            break;
+        case col_type_Double:
+            do_set_rows<ArrayDoubleNull>(col_key, ndxs, values, nullable);
+            break;
+        case col_type_String:
+            do_set_rows<ArrayString>(col_key, ndxs, values, nullable);
+            break;
+        case col_type_Binary:
+            do_set_rows<ArrayBinary>(col_key, ndxs, values, nullable);
+            break;
+        case col_type_Timestamp:
+            do_set_rows<ArrayTimestamp>(col_key, ndxs, values, nullable);
+            break;
+        case col_type_Decimal:
+            do_set_rows<ArrayDecimal128>(col_key, ndxs, values, nullable);
+            break;
+        case col_type_ObjectId:
+            do_set_rows<ArrayObjectIdNull>(col_key, ndxs, values, nullable);
+            break;
+        default:
+            // Links and mixed values are set through Obj, see Table::set_column_values()
+            REALM_UNREACHABLE();
+    }
+}
+
 template <class T>
 inline void Cluster::do_move(size_t ndx, ColKey col_key, Cluster* to)
 {
@@ -1161,37 +1470,128 @@ void Cluster::ensure_general_form()
     }
 }
 
+namespace {
+
+// Create a leaf holding 'size' default values in one allocation, for the leaf
+// types where the default value has a fixed bit pattern. For most of them the
+// pattern is all zeroes, so only the header of the leaf is written. Returns 0
+// for the other types, which are filled one value at a time. The leaf is still
+// created eagerly, as all accessors expect a valid ref in the cluster.
 template <class T>
-inline void Cluster::do_insert_column(ColKey col_key, bool nullable)
+ref_type create_default_leaf(size_t, bool, Allocator&)
 {
-    size_t sz = node_size();
+    return 0;
+}
 
-    T arr(m_alloc);
-    arr.create();
-    auto val = T::default_value(nullable);
-    for (size_t i = 0; i < sz; i++) {
-        arr.add(val);
-    }
-    auto col_ndx = col_key.get_index();
-    unsigned ndx = col_ndx.val + s_first_col_index;
+template <>
+ref_type create_default_leaf<ArrayInteger>(size_t size, bool, Allocator& alloc)
+{
+    return Array::create_array(Array::type_Normal, false, size, 0, alloc).get_ref();
+}
 
-    // Fill up if indexes are not consecutive
-    while (size() < ndx)
-        Array::add(0);
+template <>
+ref_type create_default_leaf<ArrayIntNull>(size_t size, bool nullable, Allocator& alloc)
+{
+    if (!nullable)
+        return 0;
+    // All values are equal to the null value stored in front of them
+    return ArrayIntNull::create_array(Array::type_Normal, false, size, alloc).get_ref();
+}
 
-    if (ndx == size())
-        Array::insert(ndx, from_ref(arr.get_ref()));
-    else
-        Array::set(ndx, from_ref(arr.get_ref()));
+template <>
+ref_type create_default_leaf<ArrayBoolNull>(size_t size, bool nullable, Allocator& alloc)
+{
+    if (nullable)
+        return 0;
+    return Array::create_array(Array::type_Normal, false, size, 0, alloc).get_ref();
 }
 
-void Cluster::insert_column(ColKey col_key)
+template <>
+ref_type create_default_leaf<ArrayKey>(size_t size, bool, Allocator& alloc)
 {
-    auto attr = col_key.get_attrs();
-    if (attr.test(col_attr_List)) {
-        size_t sz = node_size();
+    return Array::create_array(Array::type_Normal, false, size, 0, alloc).get_ref();
+}
 
-        ArrayRef arr(m_alloc);
+template <>
+ref_type create_default_leaf<ArrayBacklink>(size_t size, bool, Allocator& alloc)
+{
+    return Array::create_array(Array::type_HasRefs, false, size, 0, alloc).get_ref();
+}
+
+template <>
+ref_type create_default_leaf<ArrayFloatNull>(size_t size, bool nullable, Allocator& alloc)
+{
+    return BasicArray<float>::create_array(Array::type_Normal, false, size, ArrayFloatNull::default_value(nullable),
+                                           alloc)
+        .get_ref();
+}
+
+template <>
+ref_type create_default_leaf<ArrayDoubleNull>(size_t size, bool nullable, Allocator& alloc)
+{
+    return BasicArray<double>::create_array(Array::type_Normal, false, size,
+                                            ArrayDoubleNull::default_value(nullable), alloc)
+        .get_ref();
+}
+
+template <>
+ref_type create_default_leaf<ArrayString>(size_t size, bool nullable, Allocator& alloc)
+{
+    if (!nullable)
+        return 0;
+    // A short string leaf without payload holds nulls
+    return ArrayStringShort::create_array(size, alloc).get_ref();
+}
+
+template <>
+ref_type create_default_leaf<ArrayTimestamp>(size_t size, bool nullable, Allocator& alloc)
+{
+    if (!nullable)
+        return 0;
+    Array arr(alloc);
+    arr.create(Array::type_HasRefs, false, 2);
+    arr.set_as_ref(0, ArrayIntNull::create_array(Array::type_Normal, false, size, alloc).get_ref());
+    arr.set_as_ref(1, Array::create_array(Array::type_Normal, false, size, 0, alloc).get_ref());
+    return arr.get_ref();
+}
+
+} // anonymous namespace
+
+template <class T>
+inline void Cluster::do_insert_column(ColKey col_key, bool nullable)
+{
+    size_t sz = node_size();
+
+    ref_type ref = create_default_leaf<T>(sz, nullable, m_alloc);
+    if (!ref) {
+        T arr(m_alloc);
+        arr.create();
+        auto val = T::default_value(nullable);
+        for (size_t i = 0; i < sz; i++) {
+            arr.add(val);
+        }
+        ref = arr.get_ref();
+    }
+    auto col_ndx = col_key.get_index();
+    unsigned ndx = col_ndx.val + s_first_col_index;
+
+    // Fill up if indexes are not consecutive
+    while (size() < ndx)
+        Array::add(0);
+
+    if (ndx == size())
+        Array::insert(ndx, from_ref(ref));
+    else
+        Array::set(ndx, from_ref(ref));
+}
+
+void Cluster::insert_column(ColKey col_key)
+{
+    auto attr = col_key.get_attrs();
+    if (attr.test(col_attr_List)) {
+        size_t sz = node_size();
+
+        ArrayRef arr(m_alloc);
         arr.create(sz);
         auto col_ndx = col_key.get_index();
         unsigned idx = col_ndx.val + s_first_col_index;
@@ -1257,7 +1657,7 @@ void Cluster::remove_column(ColKey col_key)
     unsigned idx = col_ndx.val + s_first_col_index;
     ref_type ref = to_ref(Array::get(idx));
     if (ref != 0) {
-        Array::destroy_deep(ref, m_alloc);
+        get_owning_table()->destroy_deep_deferred(ref);
     }
     if (idx == size() - 1)
         Array::erase(idx);
@@ -1288,15 +1688,15 @@ ref_type Cluster::insert(ObjKey k, const FieldValues& init_values, ClusterNode::
         }
         // Key value is bigger than all other values, should be put last
         ndx = sz;
-        if (uint64_t(k.value) > sz && sz < cluster_node_size) {
+        if (uint64_t(k.value) > sz && sz < m_tree_top.get_node_size()) {
             ensure_general_form();
         }
     }
 
     ref_type ret = 0;
 
-    REALM_ASSERT_DEBUG(sz <= cluster_node_size);
-    if (REALM_LIKELY(sz < cluster_node_size)) {
+    REALM_ASSERT_DEBUG(sz <= m_tree_top.get_node_size());
+    if (REALM_LIKELY(sz < m_tree_top.get_node_size())) {
         insert_row(ndx, k, init_values); // Throws
         state.mem = get_mem();
         state.index = ndx;
@@ -1327,6 +1727,14 @@ ref_type Cluster::insert(ObjKey k, const FieldValues& init_values, ClusterNode::
     return ret;
 }
 
+ref_type Cluster::append_leaf(ObjKey first_key, ref_type leaf_ref, size_t, ClusterNode::State& state)
+{
+    REALM_ASSERT_DEBUG(first_key.value > get_last_key_value());
+    // The leaf becomes the next sibling of this one
+    state.split_key = first_key.value;
+    return leaf_ref;
+}
+
 bool Cluster::try_get(ObjKey k, ClusterNode::State& state) const
 {
     state.mem = get_mem();
@@ -1361,6 +1769,19 @@ inline void Cluster::do_erase(size_t ndx, ColKey col_key)
     values.erase(ndx);
 }
 
+template <class T>
+inline void Cluster::do_erase_rows(const std::vector<size_t>& ndxs, ColKey col_key)
+{
+    auto col_ndx = col_key.get_index();
+    T values(m_alloc);
+    values.set_parent(this, col_ndx.val + s_first_col_index);
+    set_spec<T>(values, col_ndx);
+    values.init_from_parent();
+    for (auto it = ndxs.rbegin(); it != ndxs.rend(); ++it) {
+        values.erase(*it);
+    }
+}
+
 inline void Cluster::do_erase_key(size_t ndx, ColKey col_key, CascadeState& state)
 {
     ArrayKey values(m_alloc);
@@ -1514,6 +1935,140 @@ size_t Cluster::erase(ObjKey key, CascadeState& state)
     return node_size();
 }
 
+size_t Cluster::erase_run(const ObjKey* begin, const ObjKey* end, size_t& erased, CascadeState& state)
+{
+    // Only the objects themselves are erased, no cascading
+    REALM_ASSERT(state.m_mode == CascadeState::Mode::None);
+
+    std::vector<size_t> ndxs;
+    int64_t last_key_value = int64_t(m_offset) + get_last_key_value();
+    for (auto it = begin; it != end && it->value <= last_key_value; ++it) {
+        ndxs.push_back(get_ndx(ObjKey(it->value - m_offset), 0));
+    }
+    erased = ndxs.size();
+    // If all objects are erased, the columns are left as they are as the
+    // leaf will be destroyed as a whole
+    bool whole_leaf = erased == node_size();
+
+    auto table = m_tree_top.get_owner();
+    Replication* repl = table->get_repl();
+    for (auto ndx : ndxs) {
+        ObjKey real_key = get_real_key(ndx);
+        const_cast<Table*>(table)->free_local_id_after_hash_collision(real_key);
+        if (repl) {
+            repl->remove_object(table, real_key);
+        }
+    }
+
+    auto erase_in_column = [&](ColKey col_key) {
+        auto col_type = col_key.get_type();
+        auto col_ndx = col_key.get_index();
+        auto attr = col_key.get_attrs();
+        if (attr.test(col_attr_List)) {
+            ArrayRef values(m_alloc);
+            values.set_parent(this, col_ndx.val + s_first_col_index);
+            values.init_from_parent();
+            for (auto it = ndxs.rbegin(); it != ndxs.rend(); ++it) {
+                ref_type ref = values.get(*it);
+                if (ref && col_type == col_type_LinkList) {
+                    BPlusTree<ObjKey> links(m_alloc);
+                    links.init_from_ref(ref);
+                    if (links.size() > 0) {
+                        remove_backlinks(get_real_key(*it), col_key, links.get_all(), state);
+                    }
+                }
+                if (!whole_leaf) {
+                    if (ref)
+                        Array::destroy_deep(ref, m_alloc);
+                    values.erase(*it);
+                }
+            }
+            return false;
+        }
+
+        if (col_type == col_type_Link) {
+            ArrayKey values(m_alloc);
+            values.set_parent(this, col_ndx.val + s_first_col_index);
+            values.init_from_parent();
+            for (auto it = ndxs.rbegin(); it != ndxs.rend(); ++it) {
+                ObjKey key = values.get(*it);
+                if (key != null_key) {
+                    remove_backlinks(get_real_key(*it), col_key, {key}, state);
+                }
+                if (!whole_leaf)
+                    values.erase(*it);
+            }
+            return false;
+        }
+
+        if (whole_leaf)
+            return false;
+
+        switch (col_type) {
+            case col_type_Int:
+                if (attr.test(col_attr_Nullable)) {
+                    do_erase_rows<ArrayIntNull>(ndxs, col_key);
+                }
+                else {
+                    do_erase_rows<ArrayInteger>(ndxs, col_key);
+                }
+                break;
+            case col_type_Bool:
+                do_erase_rows<ArrayBoolNull>(ndxs, col_key);
+                break;
+            case col_type_Float:
+                do_erase_rows<ArrayFloatNull>(ndxs, col_key);
+                break;
+            case col_type_Double:
+                do_erase_rows<ArrayDoubleNull>(ndxs, col_key);
+                break;
+            case col_type_String:
+                do_erase_rows<ArrayString>(ndxs, col_key);
+                break;
+            case col_type_Binary:
+                do_erase_rows<ArrayBinary>(ndxs, col_key);
+                break;
+            case col_type_OldMixed:
+                do_erase_rows<ArrayMixed>(ndxs, col_key);
+                break;
+            case col_type_Timestamp:
+                do_erase_rows<ArrayTimestamp>(ndxs, col_key);
+                break;
+            case col_type_Decimal:
+                do_erase_rows<ArrayDecimal128>(ndxs, col_key);
+                break;
+            case col_type_ObjectId:
+                do_erase_rows<ArrayObjectIdNull>(ndxs, col_key);
+                break;
+            case col_type_BackLink:
+                do_erase_rows<ArrayBacklink>(ndxs, col_key);
+                break;
+            default:
+                REALM_ASSERT(false);
+                break;
+        }
+        return false;
+    };
+    table->for_each_and_every_column(erase_in_column);
+
+    if (whole_leaf)
+        return 0;
+
+    size_t current_size = node_size();
+    if (!m_keys.is_attached() && ndxs.front() == current_size - erased) {
+        // When erasing the last objects, we can still maintain compact form
+        set(0, RefOrTagged::make_tagged(current_size - erased));
+    }
+    else {
+        ensure_general_form();
+        for (auto it = ndxs.rbegin(); it != ndxs.rend(); ++it) {
+            m_keys.erase(*it);
+        }
+    }
+
+    return node_size();
+}
+
 void Cluster::nullify_incoming_links(ObjKey key, CascadeState& state)
 {
     size_t ndx = get_ndx(key, 0);
@@ -1991,8 +2546,22 @@ void ClusterTree::replace_root(std::unique_ptr<ClusterNode> new_root)
     }
 }
 
+void ClusterTree::update_node_shift_factor() noexcept
+{
+    size_t node_size = m_owner->get_stored_cluster_node_size();
+    int shift_factor = s_default_node_shift_factor;
+    if (node_size) {
+        shift_factor = 0;
+        while ((size_t(1) << shift_factor) < node_size)
+            ++shift_factor;
+    }
+    m_node_shift_factor = shift_factor;
+}
+
 void ClusterTree::init_from_ref(ref_type ref)
 {
+    // Must be known before the inner nodes are initialized
+    update_node_shift_factor();
     auto new_root = create_root_from_ref(m_alloc, ref);
     new_root->set_parent(&m_owner->m_top, m_top_position_for_cluster_tree);
     m_root = std::move(new_root);
@@ -2007,6 +2576,7 @@ void ClusterTree::init_from_parent()
 
 void ClusterTree::update_from_parent() noexcept
 {
+    update_node_shift_factor();
     m_root->update_from_parent();
     m_size = m_root->get_tree_size();
 }
@@ -2052,6 +2622,85 @@ void ClusterTree::clear(CascadeState& state)
     m_size = 0;
 }
 
+namespace {
+
+void insert_in_index(StringIndex* index, ObjKey key, ColKey col_key, Mixed init_value)
+{
+    auto type = col_key.get_type();
+    auto attr = col_key.get_attrs();
+    bool nullable = attr.test(col_attr_Nullable);
+    switch (type) {
+        case col_type_Int:
+            if (init_value.is_null()) {
+                index->insert(key, ArrayIntNull::default_value(nullable));
+            }
+            else {
+                index->insert(key, init_value.get<int64_t>());
+            }
+            break;
+        case col_type_Bool:
+            if (init_value.is_null()) {
+                index->insert(key, ArrayBoolNull::default_value(nullable));
+            }
+            else {
+                index->insert(key, init_value.get<bool>());
+            }
+            break;
+        case col_type_String:
+            if (init_value.is_null()) {
+                index->insert(key, ArrayString::default_value(nullable));
+            }
+            else {
+                index->insert(key, init_value.get<String>());
+            }
+            break;
+        case col_type_Timestamp:
+            if (init_value.is_null()) {
+                index->insert(key, ArrayTimestamp::default_value(nullable));
+            }
+            else {
+                index->insert(key, init_value.get<Timestamp>());
+            }
+            break;
+        case col_type_ObjectId:
+            if (init_value.is_null()) {
+                index->insert(key, ArrayObjectIdNull::default_value(nullable));
+            }
+            else {
+                index->insert(key, init_value.get<ObjectId>());
+            }
+            break;
+        case col_type_Float:
+            if (init_value.is_null()) {
+                index->insert(key, ArrayFloatNull::default_value(nullable));
+            }
+            else {
+                index->insert(key, init_value.get<float>());
+            }
+            break;
+        case col_type_Double:
+            if (init_value.is_null()) {
+                index->insert(key, ArrayDoubleNull::default_value(nullable));
+            }
+            else {
+                index->insert(key, init_value.get<double>());
+            }
+            break;
+        case col_type_Decimal:
+            if (init_value.is_null()) {
+                index->insert(key, ArrayDecimal128::default_value(nullable));
+            }
+            else {
+                index->insert(key, init_value.get<Decimal128>());
+            }
+            break;
+        default:
+            REALM_UNREACHABLE();
+    }
+}
+
+} // anonymous namespace
+
 void ClusterTree::insert_fast(ObjKey k, const FieldValues& init_values, ClusterNode::State& state)
 {
     ref_type new_sibling_ref = m_root->insert(k, init_values, state);
@@ -2092,54 +2741,12 @@ Obj ClusterTree::insert(ObjKey k, const FieldValues& values)
                 ++value;
             }
 
+            // A new list is empty, so there is nothing to add to its index
+            if (col_key.is_list())
+                return false;
+
             if (StringIndex* index = table->get_search_index(col_key)) {
-                auto type = col_key.get_type();
-                auto attr = col_key.get_attrs();
-                bool nullable = attr.test(col_attr_Nullable);
-                switch (type) {
-                    case col_type_Int:
-                        if (init_value.is_null()) {
-                            index->insert(k, ArrayIntNull::default_value(nullable));
-                        }
-                        else {
-                            index->insert(k, init_value.get<int64_t>());
-                        }
-                        break;
-                    case col_type_Bool:
-                        if (init_value.is_null()) {
-                            index->insert(k, ArrayBoolNull::default_value(nullable));
-                        }
-                        else {
-                            index->insert(k, init_value.get<bool>());
-                        }
-                        break;
-                    case col_type_String:
-                        if (init_value.is_null()) {
-                            index->insert(k, ArrayString::default_value(nullable));
-                        }
-                        else {
-                            index->insert(k, init_value.get<String>());
-                        }
-                        break;
-                    case col_type_Timestamp:
-                        if (init_value.is_null()) {
-                            index->insert(k, ArrayTimestamp::default_value(nullable));
-                        }
-                        else {
-                            index->insert(k, init_value.get<Timestamp>());
-                        }
-                        break;
-                    case col_type_ObjectId:
-                        if (init_value.is_null()) {
-                            index->insert(k, ArrayObjectIdNull::default_value(nullable));
-                        }
-                        else {
-                            index->insert(k, init_value.get<ObjectId>());
-                        }
-                        break;
-                    default:
-                        REALM_UNREACHABLE();
-                }
+                insert_in_index(index, k, col_key, init_value);
             }
             return false;
         };
@@ -2166,6 +2773,224 @@ Obj ClusterTree::insert(ObjKey k, const FieldValues& values)
     return Obj(get_table_ref(), state.mem, k, state.index);
 }
 
+void ClusterTree::append_leaf(ObjKey first_key, ref_type leaf_ref, size_t leaf_size)
+{
+    ClusterNode::State state;
+    ref_type new_sibling_ref = m_root->append_leaf(first_key, leaf_ref, leaf_size, state);
+    if (new_sibling_ref) {
+        auto new_root = std::make_unique<ClusterNodeInner>(m_root->get_alloc(), *this);
+        new_root->create(m_root->get_sub_tree_depth() + 1);
+
+        new_root->add(m_root->get_ref());                // Throws
+        new_root->add(new_sibling_ref, state.split_key); // Throws
+        new_root->update_sub_tree_size();
+
+        replace_root(std::move(new_root));
+    }
+    m_size += leaf_size;
+}
+
+void ClusterTree::bulk_insert(const std::vector<ObjKey>& keys, const std::vector<ColumnValues>& columns)
+{
+    REALM_ASSERT(std::is_sorted(keys.begin(), keys.end()));
+    if (keys.empty())
+        return;
+    REALM_ASSERT(keys.front().value > get_last_key_value());
+    const Table* table = get_owner();
+
+    // Sort columns according to index
+    std::vector<const ColumnValues*> sorted_columns;
+    for (auto& c : columns) {
+        REALM_ASSERT(c.values.size() == keys.size());
+        sorted_columns.push_back(&c);
+    }
+    std::sort(sorted_columns.begin(), sorted_columns.end(),
+              [](auto a, auto b) { return a->col_key.get_index().val < b->col_key.get_index().val; });
+
+    // Build full leaves and attach each of them in one step. The keys of a leaf
+    // are stored relative to its first key, except for a leaf replacing an
+    // empty root.
+    size_t nb_leaf_columns = table->num_leaf_cols();
+    size_t begin = 0;
+    while (begin < keys.size()) {
+        size_t end = std::min(begin + get_node_size(), keys.size());
+        if (m_size == 0 && m_root->is_leaf()) {
+            auto leaf = std::make_unique<Cluster>(0, m_alloc, *this);
+            leaf->create(nb_leaf_columns);
+            leaf->append_rows(keys, begin, end, 0, sorted_columns);
+            m_root->destroy_deep();
+            replace_root(std::move(leaf));
+            m_size = end - begin;
+        }
+        else {
+            Cluster leaf(0, m_alloc, *this);
+            leaf.create(nb_leaf_columns);
+            leaf.append_rows(keys, begin, end, keys[begin].value, sorted_columns);
+            append_leaf(keys[begin], leaf.get_ref(), end - begin);
+        }
+        begin = end;
+    }
+
+    // Update backlinks, search indexes and replication
+    Replication* repl = table->get_repl();
+    if (repl) {
+        for (auto k : keys) {
+            repl->create_object(table, GlobalKey(k, 0));
+        }
+    }
+    for (auto c : sorted_columns) {
+        ColKey col_key = c->col_key;
+        auto& values = c->values;
+        if (col_key.get_type() == col_type_Link) {
+            TableRef opp_table = table->get_opposite_table(col_key);
+            ColKey opp_col = table->get_opposite_column(col_key);
+            for (size_t i = 0; i < keys.size(); i++) {
+                if (!values[i].is_null()) {
+                    opp_table->get_object(values[i].get<ObjKey>()).add_backlink(opp_col, keys[i]);
+                }
+            }
+        }
+        if (StringIndex* index = table->get_search_index(col_key)) {
+            for (size_t i = 0; i < keys.size(); i++) {
+                insert_in_index(index, keys[i], col_key, values[i]);
+            }
+        }
+        if (repl) {
+            for (size_t i = 0; i < keys.size(); i++) {
+                if (values[i].is_null()) {
+                    repl->set_null(table, col_key, keys[i], _impl::instr_Set);
+                }
+                else {
+                    repl->set(table, col_key, keys[i], values[i], _impl::instr_Set);
+                }
+            }
+        }
+    }
+    // Indexed columns without values hold the default value
+    auto insert_defaults = [&](ColKey col_key) {
+        if (col_key.is_list())
+            return false;
+        if (StringIndex* index = table->get_search_index(col_key)) {
+            bool has_values = std::any_of(sorted_columns.begin(), sorted_columns.end(),
+                                          [&](auto c) { return c->col_key == col_key; });
+            if (!has_values) {
+                for (auto k : keys) {
+                    insert_in_index(index, k, col_key, Mixed());
+                }
+            }
+        }
+        return false;
+    };
+    table->for_each_public_column(insert_defaults);
+
+    bump_content_version();
+    bump_storage_version();
+}
+
+void ClusterTree::set_values(ColKey col_key, const std::vector<ObjKey>& keys,
+                             util::FunctionRef<Mixed(size_t)> value_at)
+{
+    const Table* table = get_owner();
+    bool nullable = col_key.get_attrs().test(col_attr_Nullable);
+    DataType type = DataType(col_key.get_type());
+
+    // Visit the keys in ascending order, so that the objects of a leaf are set
+    // together. If a key is given more than once, the last value is used.
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (!std::is_sorted(keys.begin(), keys.end())) {
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return keys[a] < keys[b]; });
+    }
+    size_t num_keys = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        if (num_keys > 0 && keys[order[num_keys - 1]] == keys[order[i]]) {
+            order[num_keys - 1] = order[i];
+        }
+        else {
+            order[num_keys++] = order[i];
+        }
+    }
+    order.resize(num_keys);
+
+    // Find the position of each object in its leaf, and check the keys and the
+    // values before anything is changed
+    std::vector<size_t> ndxs(order.size());
+    std::vector<size_t> leaf_begins;
+    Cluster current(0, m_alloc, *this);
+    ClusterNode::IteratorState state(current);
+    int64_t last_key_value = -1;
+    for (size_t i = 0; i < order.size(); i++) {
+        ObjKey key = keys[order[i]];
+        if (i == 0 || key.value > last_key_value) {
+            if (key.value < 0 || !get_leaf(key, state))
+                throw KeyNotFound("No such object");
+            last_key_value = state.m_key_offset + current.get_last_key_value();
+            leaf_begins.push_back(i);
+        }
+        size_t ndx = key.value < state.m_key_offset
+                         ? current.node_size()
+                         : current.lower_bound_key(ObjKey(key.value - state.m_key_offset));
+        if (ndx == current.node_size() || current.get_real_key(ndx) != key)
+            throw KeyNotFound("No such object");
+        ndxs[i] = ndx;
+
+        Mixed value = value_at(order[i]);
+        if (value.is_null()) {
+            if (!nullable)
+                throw LogicError(LogicError::column_not_nullable);
+        }
+        else if (value.get_type() != type) {
+            throw LogicError(LogicError::illegal_type);
+        }
+    }
+    leaf_begins.push_back(order.size());
+
+    std::vector<ObjKey> sorted_keys(order.size());
+    for (size_t i = 0; i < order.size(); i++)
+        sorted_keys[i] = keys[order[i]];
+    StringIndex* index = table->get_search_index(col_key);
+    if (index)
+        index->erase(sorted_keys);
+
+    // Make each leaf writeable once and write its values in one go
+    Cluster fallback(0, m_alloc, *this);
+    Cluster* leaf = m_root->is_leaf() ? static_cast<Cluster*>(m_root.get()) : &fallback;
+    std::vector<size_t> leaf_ndxs;
+    std::vector<Mixed> leaf_values;
+    for (size_t l = 0; l + 1 < leaf_begins.size(); l++) {
+        size_t begin = leaf_begins[l];
+        size_t end = leaf_begins[l + 1];
+        MemRef mem = ensure_writeable(sorted_keys[begin]);
+        if (leaf == &fallback)
+            fallback.init(mem);
+        leaf_ndxs.assign(ndxs.begin() + begin, ndxs.begin() + end);
+        leaf_values.clear();
+        for (size_t i = begin; i < end; i++)
+            leaf_values.push_back(value_at(order[i]));
+        leaf->set_rows(col_key, leaf_ndxs, leaf_values);
+    }
+
+    Replication* repl = table->get_repl();
+    if (index || repl) {
+        for (size_t i = 0; i < order.size(); i++) {
+            Mixed value = value_at(order[i]);
+            if (index)
+                insert_in_index(index, sorted_keys[i], col_key, value);
+            if (repl) {
+                if (value.is_null()) {
+                    repl->set_null(table, col_key, sorted_keys[i], _impl::instr_Set);
+                }
+                else {
+                    repl->set(table, col_key, sorted_keys[i], value, _impl::instr_Set);
+                }
+            }
+        }
+    }
+
+    bump_content_version();
+    bump_storage_version();
+}
+
 bool ClusterTree::is_valid(ObjKey k) const
 {
     ClusterNode::State state;
@@ -2243,6 +3068,53 @@ void ClusterTree::erase(ObjKey k, CascadeState& state)
     }
 }
 
+void ClusterTree::erase(const std::vector<ObjKey>& keys, CascadeState& state)
+{
+    if (keys.empty())
+        return;
+
+    size_t num_cols = get_spec().get_public_column_count();
+    for (size_t col_ndx = 0; col_ndx < num_cols; col_ndx++) {
+        auto col_key = m_owner->spec_ndx2colkey(col_ndx);
+        if (StringIndex* index = m_owner->get_search_index(col_key)) {
+            index->erase(keys);
+        }
+    }
+
+    // Erase the objects leaf by leaf
+    const ObjKey* begin = keys.data();
+    const ObjKey* end = begin + keys.size();
+    while (begin != end) {
+        size_t erased = 0;
+        size_t root_size = m_root->erase_run(begin, end, erased, state);
+        REALM_ASSERT(erased > 0);
+        begin += erased;
+        m_size -= erased;
+        if (m_root->is_leaf() && root_size == 0) {
+            // The root leaf may have been left with the values of the erased objects
+            m_root->destroy_deep();
+            auto leaf = std::make_unique<Cluster>(0, m_alloc, *this);
+            leaf->create(m_owner->num_leaf_cols());
+            replace_root(std::move(leaf));
+        }
+        while (!m_root->is_leaf() && root_size == 1) {
+            ClusterNodeInner* node = static_cast<ClusterNodeInner*>(m_root.get());
+
+            REALM_ASSERT(node->get_first_key_value() == 0);
+            ref_type new_root_ref = node->clear_first_child_ref();
+            node->destroy_deep();
+
+            auto new_root = get_node(new_root_ref);
+
+            replace_root(std::move(new_root));
+            root_size = m_root->node_size();
+        }
+    }
+
+    bump_content_version();
+    bump_storage_version();
+}
+
 bool ClusterTree::get_leaf(ObjKey key, ClusterNode::IteratorState& state) const noexcept
 {
     state.clear();
@@ -2272,6 +3144,16 @@ bool ClusterTree::traverse(TraverseFunction func) const
     }
 }
 
+bool ClusterTree::traverse_range(ObjKey begin, ObjKey end, TraverseFunction func) const
+{
+    if (m_root->is_leaf()) {
+        return func(static_cast<Cluster*>(m_root.get()));
+    }
+    else {
+        return static_cast<ClusterNodeInner*>(m_root.get())->traverse_range(func, 0, begin.value, end.value);
+    }
+}
+
 void ClusterTree::update(UpdateFunction func)
 {
     if (m_root->is_leaf()) {
@@ -2451,6 +3333,28 @@ ClusterTree::ConstIterator::ConstIterator(const ClusterTree& t, size_t ndx)
     }
 }
 
+ClusterTree::ConstIterator::ConstIterator(const ClusterTree& t, ObjKey key)
+    : m_tree(t)
+    , m_leaf(0, t.get_alloc(), t)
+    , m_state(m_leaf)
+    , m_instance_version(t.get_instance_version())
+    , m_leaf_invalid(false)
+    , m_position(0)
+{
+    // Descend directly to the leaf holding the key or its successor. All keys
+    // in the tree are positive.
+    m_key = load_leaf(ObjKey(std::max(key.value, int64_t(0))));
+    if (m_key) {
+        m_position = t.get_ndx(m_key);
+        m_leaf_start_pos = m_position - m_state.m_current_index;
+    }
+    else {
+        // end
+        m_position = t.size();
+        m_leaf_invalid = true;
+    }
+}
+
 ClusterTree::ConstIterator::ConstIterator(const ConstIterator& other)
     : m_tree(other.m_tree)
     , m_leaf(0, m_tree.get_alloc(), m_tree)
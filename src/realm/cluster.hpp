@@ -49,6 +49,17 @@ struct FieldValue {
 
 using FieldValues = std::vector<FieldValue>;
 
+/// The values of one column for a range of new objects, see Table::bulk_insert()
+struct ColumnValues {
+    ColumnValues(ColKey k, std::vector<Mixed> vals)
+        : col_key(k)
+        , values(std::move(vals))
+    {
+    }
+    ColKey col_key;
+    std::vector<Mixed> values;
+};
+
 class ClusterNode : public Array {
 public:
     // This structure is used to bring information back to the upper nodes when
@@ -124,6 +135,11 @@ public:
     /// Create a new object identified by 'key' and update 'state' accordingly
     /// Return reference to new node created (if any)
     virtual ref_type insert(ObjKey k, const FieldValues& init_values, State& state) = 0;
+    /// Attach the leaf 'leaf_ref' holding 'leaf_size' objects after all objects in
+    /// this subtree. The keys in the leaf are relative to 'first_key', which must be
+    /// bigger than all keys in this subtree.
+    /// Return reference to new node created (if any)
+    virtual ref_type append_leaf(ObjKey first_key, ref_type leaf_ref, size_t leaf_size, State& state) = 0;
     /// Locate object identified by 'key' and update 'state' accordingly
     void get(ObjKey key, State& state) const;
     /// Locate object identified by 'key' and update 'state' accordingly
@@ -136,6 +152,11 @@ public:
 
     /// Erase element identified by 'key'
     virtual size_t erase(ObjKey key, CascadeState& state) = 0;
+    /// Erase the elements identified by the ascending keys in ['begin', 'end')
+    /// which are in the same leaf as the first one. The keys are not relative
+    /// to the offset of this node. The number of elements erased is returned in
+    /// 'erased' and the new size of this node is returned.
+    virtual size_t erase_run(const ObjKey* begin, const ObjKey* end, size_t& erased, CascadeState& state) = 0;
 
     /// Nullify links pointing to element identified by 'key'
     virtual void nullify_incoming_links(ObjKey key, CascadeState& state) = 0;
@@ -244,10 +265,12 @@ public:
         return size() - s_first_col_index;
     }
     ref_type insert(ObjKey k, const FieldValues& init_values, State& state) override;
+    ref_type append_leaf(ObjKey first_key, ref_type leaf_ref, size_t leaf_size, State& state) override;
     bool try_get(ObjKey k, State& state) const override;
     ObjKey get(size_t, State& state) const override;
     size_t get_ndx(ObjKey key, size_t ndx) const override;
     size_t erase(ObjKey k, CascadeState& state) override;
+    size_t erase_run(const ObjKey* begin, const ObjKey* end, size_t& erased, CascadeState& state) override;
     void nullify_incoming_links(ObjKey key, CascadeState& state) override;
     void upgrade_string_to_enum(ColKey col, ArrayString& keys);
 
@@ -267,6 +290,9 @@ private:
     }
     friend class ClusterTree;
     void insert_row(size_t ndx, ObjKey k, const FieldValues& init_values);
+    void append_rows(const std::vector<ObjKey>& keys, size_t begin, size_t end, int64_t key_offset,
+                     const std::vector<const ColumnValues*>& columns);
+    void set_rows(ColKey col, const std::vector<size_t>& ndxs, const std::vector<Mixed>& values);
     void move(size_t ndx, ClusterNode* new_node, int64_t key_adj) override;
     template <class T>
     void do_create(ColKey col);
@@ -275,9 +301,15 @@ private:
     template <class T>
     void do_insert_row(size_t ndx, ColKey col, Mixed init_val, bool nullable);
     template <class T>
+    void do_append_rows(ColKey col, const ColumnValues* values, size_t begin, size_t end, bool nullable);
+    template <class T>
+    void do_set_rows(ColKey col, const std::vector<size_t>& ndxs, const std::vector<Mixed>& values, bool nullable);
+    template <class T>
     void do_move(size_t ndx, ColKey col, Cluster* to);
     template <class T>
     void do_erase(size_t ndx, ColKey col);
+    template <class T>
+    void do_erase_rows(const std::vector<size_t>& ndxs, ColKey col);
     void remove_backlinks(ObjKey origin_key, ColKey col, const std::vector<ObjKey>& keys, CascadeState& state) const;
     void do_erase_key(size_t ndx, ColKey col, CascadeState& state);
     void do_insert_key(size_t ndx, ColKey col, Mixed init_val, ObjKey origin_key);
@@ -55,6 +55,22 @@ public:
     TableRef get_table_ref() const;
     const Spec& get_spec() const;
 
+#if REALM_MAX_BPNODE_SIZE > 256
+    static constexpr int s_default_node_shift_factor = 8;
+#else
+    static constexpr int s_default_node_shift_factor = 2;
+#endif
+    /// The max number of objects in a cluster, and of children of an inner
+    /// node, is 2^shift factor. See Table::set_cluster_node_size().
+    int get_node_shift_factor() const noexcept
+    {
+        return m_node_shift_factor;
+    }
+    size_t get_node_size() const noexcept
+    {
+        return size_t(1) << m_node_shift_factor;
+    }
+
     void init_from_ref(ref_type ref);
     void init_from_parent();
     void update_from_parent() noexcept;
@@ -123,8 +139,16 @@ public:
     void insert_fast(ObjKey k, const FieldValues& init_values, ClusterNode::State& state);
     // Create and return object
     Obj insert(ObjKey k, const FieldValues&);
+    // Create objects for ascending keys bigger than all existing keys, building
+    // whole leaves from the column values
+    void bulk_insert(const std::vector<ObjKey>& keys, const std::vector<ColumnValues>& columns);
+    // Set the value of one column for the objects with the given keys, writing
+    // the values of each leaf together. Not for link and mixed columns.
+    void set_values(ColKey col_key, const std::vector<ObjKey>& keys, util::FunctionRef<Mixed(size_t)> value_at);
     // Delete object with given key
     void erase(ObjKey k, CascadeState& state);
+    // Delete objects with the given ascending keys without cascading
+    void erase(const std::vector<ObjKey>& keys, CascadeState& state);
     // Check if an object with given key exists
     bool is_valid(ObjKey k) const;
     // Lookup and return read-only object
@@ -142,6 +166,10 @@ public:
     // Visit all leaves and call the supplied function. Stop when function returns true.
     // Not allowed to modify the tree
     bool traverse(TraverseFunction func) const;
+    // Visit the leaves that may hold objects with keys in [begin, end). Leaves
+    // in subtrees entirely outside the range are skipped. Stop when function
+    // returns true.
+    bool traverse_range(ObjKey begin, ObjKey end, TraverseFunction func) const;
     // Visit all leaves and call the supplied function. The function can modify the leaf.
     void update(UpdateFunction func);
 
@@ -157,13 +185,20 @@ private:
     friend class Obj;
     friend class Cluster;
     friend class ClusterNodeInner;
+    friend class Table;
     Table* m_owner;
     Allocator& m_alloc;
     std::unique_ptr<ClusterNode> m_root;
     size_t m_top_position_for_cluster_tree;
+    int m_node_shift_factor = s_default_node_shift_factor;
+
+    // Read the node size of the owning table
+    void update_node_shift_factor() noexcept;
     size_t m_size = 0;
 
     void replace_root(std::unique_ptr<ClusterNode> leaf);
+    // Attach a leaf holding objects with keys bigger than all existing keys
+    void append_leaf(ObjKey first_key, ref_type leaf_ref, size_t leaf_size);
 
     std::unique_ptr<ClusterNode> create_root_from_mem(Allocator& alloc, MemRef mem);
     std::unique_ptr<ClusterNode> create_root_from_ref(Allocator& alloc, ref_type ref)
@@ -185,6 +220,8 @@ public:
     typedef const Obj& reference;
 
     ConstIterator(const ClusterTree& t, size_t ndx);
+    // Iterator pointing to the first object with a key not less than 'key'
+    ConstIterator(const ClusterTree& t, ObjKey key);
     ConstIterator(const ConstIterator& other);
 
     ConstIterator& operator=(const ConstIterator& other)
@@ -255,6 +292,10 @@ public:
         : ConstIterator(t, ndx)
     {
     }
+    Iterator(const ClusterTree& t, ObjKey key)
+        : ConstIterator(t, key)
+    {
+    }
 
     reference operator*() const
     {
@@ -0,0 +1,193 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_COLUMN_SCAN_HPP
+#define REALM_COLUMN_SCAN_HPP
+
+#include <realm/table.hpp>
+#include <realm/array_basic.hpp>
+#include <realm/array_integer.hpp>
+
+#include <type_traits>
+#include <vector>
+
+namespace realm {
+
+/// The values of a column in one leaf of a table, see Table::scan().
+template <class T>
+struct ColumnSpan {
+    const T* data = nullptr;
+    size_t size = 0;
+    /// One bit per value, set if the value is null. Null if the column is not
+    /// nullable. The value of a null is 0 for integers and NaN otherwise.
+    const uint64_t* nulls = nullptr;
+
+    const T& operator[](size_t ndx) const noexcept
+    {
+        return data[ndx];
+    }
+    bool is_null(size_t ndx) const noexcept
+    {
+        return nulls && ((nulls[ndx >> 6] >> (ndx & 63)) & 1);
+    }
+};
+
+/// Yields the values of an Int, Float or Double column one leaf at a time,
+/// without creating an object accessor per row. Float and Double values are
+/// read in place, while the bit packed values of Int columns are decoded into
+/// a buffer owned by the scan. A span is valid until the next call to next(),
+/// and the table must not be modified while scanning.
+///
+///     ColumnScan<Int> scan = table->scan<Int>(col);
+///     ColumnSpan<Int> span;
+///     while (scan.next(span))
+///         for (size_t i = 0; i < span.size; ++i)
+///             sum += span[i];
+template <class T>
+class ColumnScan {
+public:
+    static_assert(std::is_same<T, int64_t>::value || std::is_same<T, float>::value ||
+                      std::is_same<T, double>::value,
+                  "Only Int, Float and Double columns can be scanned");
+
+    ColumnScan(const Table& table, ColKey col_key);
+
+    /// Sets \a span to the values of the next leaf. Returns false if there are
+    /// no more leaves.
+    bool next(ColumnSpan<T>& span);
+
+    /// The key of the object at \a ndx in the last span
+    ObjKey get_key(size_t ndx) const
+    {
+        return m_leaf.get_real_key(ndx);
+    }
+
+private:
+    using FloatLeaf = BasicArrayNull<typename std::conditional<std::is_same<T, int64_t>::value, float, T>::type>;
+
+    const Table& m_table;
+    ColKey m_col_key;
+    bool m_nullable;
+    Cluster m_leaf;
+    ClusterNode::IteratorState m_state;
+    // Key to continue from, null when all leaves have been visited
+    ObjKey m_next_key = ObjKey(0);
+    ArrayInteger m_int_leaf;
+    ArrayIntNull m_int_null_leaf;
+    FloatLeaf m_float_leaf;
+    std::vector<int64_t> m_values;
+    std::vector<uint64_t> m_nulls;
+
+    void load_ints(ColumnSpan<int64_t>& span);
+    void load_floats(ColumnSpan<T>& span);
+};
+
+template <class T>
+ColumnScan<T>::ColumnScan(const Table& table, ColKey col_key)
+    : m_table(table)
+    , m_col_key(col_key)
+    , m_leaf(0, table.get_alloc(), table.m_clusters)
+    , m_state(m_leaf)
+    , m_int_leaf(table.get_alloc())
+    , m_int_null_leaf(table.get_alloc())
+    , m_float_leaf(table.get_alloc())
+{
+    table.check_column(col_key);
+    if (col_key.get_type() != ColumnTypeTraits<T>::column_id || col_key.is_list())
+        throw LogicError(LogicError::type_mismatch);
+    m_nullable = col_key.is_nullable();
+}
+
+template <class T>
+bool ColumnScan<T>::next(ColumnSpan<T>& span)
+{
+    if (!m_next_key || !m_table.m_clusters.get_leaf(m_next_key, m_state)) {
+        m_next_key = ObjKey();
+        return false;
+    }
+
+    if constexpr (std::is_same<T, int64_t>::value) {
+        load_ints(span);
+    }
+    else {
+        load_floats(span);
+    }
+    size_t sz = m_leaf.node_size();
+    m_next_key = ObjKey(m_leaf.get_real_key(sz - 1).value + 1);
+    return true;
+}
+
+template <class T>
+void ColumnScan<T>::load_ints(ColumnSpan<int64_t>& span)
+{
+    // The values are decoded 8 at a time, so the buffer is rounded up
+    size_t sz = m_leaf.node_size();
+    m_values.resize((sz + 7) & ~size_t(7));
+    span.nulls = nullptr;
+    if (m_nullable) {
+        m_leaf.init_leaf(m_col_key, &m_int_null_leaf);
+        // The first element of the array holds the value representing null
+        const Array& values = m_int_null_leaf;
+        int64_t null_value = m_int_null_leaf.null_value();
+        for (size_t i = 0; i < sz; i += 8)
+            values.get_chunk(i + 1, &m_values[i]);
+        m_nulls.assign((sz + 63) >> 6, 0);
+        for (size_t i = 0; i < sz; ++i) {
+            if (m_values[i] == null_value) {
+                m_values[i] = 0;
+                m_nulls[i >> 6] |= uint64_t(1) << (i & 63);
+            }
+        }
+        span.nulls = m_nulls.data();
+    }
+    else {
+        m_leaf.init_leaf(m_col_key, &m_int_leaf);
+        for (size_t i = 0; i < sz; i += 8)
+            m_int_leaf.get_chunk(i, &m_values[i]);
+    }
+    span.data = m_values.data();
+    span.size = sz;
+}
+
+template <class T>
+void ColumnScan<T>::load_floats(ColumnSpan<T>& span)
+{
+    m_leaf.init_leaf(m_col_key, &m_float_leaf);
+    size_t sz = m_float_leaf.size();
+    span.data = reinterpret_cast<const T*>(Array::get_data_from_header(m_float_leaf.get_header()));
+    span.size = sz;
+    span.nulls = nullptr;
+    if (m_nullable) {
+        m_nulls.assign((sz + 63) >> 6, 0);
+        for (size_t i = 0; i < sz; ++i) {
+            if (null::is_null_float(span.data[i]))
+                m_nulls[i >> 6] |= uint64_t(1) << (i & 63);
+        }
+        span.nulls = m_nulls.data();
+    }
+}
+
+template <class T>
+ColumnScan<T> Table::scan(ColKey col_key) const
+{
+    return ColumnScan<T>(*this, col_key);
+}
+
+} // namespace realm
+
+#endif // REALM_COLUMN_SCAN_HPP
@@ -0,0 +1,220 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/column_statistics.hpp>
+#include <realm/decimal128.hpp>
+#include <realm/object_id.hpp>
+#include <realm/utilities.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace realm;
+
+namespace {
+
+uint64_t mix(uint64_t x)
+{
+    // Finalizer of splitmix64
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+uint64_t hash_bytes(const char* data, size_t size)
+{
+    // FNV-1a
+    uint64_t h = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= uint8_t(data[i]);
+        h *= 0x100000001b3ULL;
+    }
+    return mix(h);
+}
+
+uint64_t hash_double(double d)
+{
+    if (d == 0)
+        d = 0; // -0.0 and 0.0 are the same value
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    return mix(bits);
+}
+
+uint64_t hash_value(Mixed value)
+{
+    switch (value.get_type()) {
+        case type_Int:
+            return mix(uint64_t(value.get_int()));
+        case type_Bool:
+            return mix(value.get_bool() ? 1 : 2);
+        case type_Float:
+            return hash_double(value.get_float());
+        case type_Double:
+            return hash_double(value.get_double());
+        case type_String: {
+            StringData str = value.get_string();
+            return hash_bytes(str.data(), str.size());
+        }
+        case type_Binary: {
+            BinaryData bin = value.get_binary();
+            return hash_bytes(bin.data(), bin.size());
+        }
+        case type_Timestamp: {
+            Timestamp ts = value.get_timestamp();
+            return mix(uint64_t(ts.get_seconds()) ^ mix(uint64_t(ts.get_nanoseconds())));
+        }
+        case type_Decimal: {
+            Decimal128 d = value.get<Decimal128>();
+            return mix(d.raw()->w[0] ^ mix(d.raw()->w[1]));
+        }
+        case type_ObjectId: {
+            std::string str = value.get<ObjectId>().to_string();
+            return hash_bytes(str.data(), str.size());
+        }
+        case type_Link:
+            return mix(uint64_t(value.get<ObjKey>().value));
+        default:
+            break;
+    }
+    return 0;
+}
+
+int highest_bit(uint64_t x)
+{
+    return (x >> 32) ? 32 + log2(size_t(x >> 32)) : log2(size_t(x));
+}
+
+} // anonymous namespace
+
+double ColumnStatistics::null_fraction() const
+{
+    return row_count ? double(null_count) / row_count : 0;
+}
+
+double ColumnStatistics::equal_fraction(util::Optional<double> value) const
+{
+    if (row_count == 0 || distinct_count == 0)
+        return 0;
+    if (value && !histogram.empty() && (*value < histogram.front() || *value > histogram.back()))
+        return 0;
+    return double(row_count - null_count) / row_count / distinct_count;
+}
+
+double ColumnStatistics::less_fraction(double value, bool or_equal) const
+{
+    if (histogram.empty())
+        return -1;
+    double non_null = 1 - null_fraction();
+    if (value < histogram.front() || (value == histogram.front() && !or_equal))
+        return 0;
+    if (value > histogram.back() || (value == histogram.back() && or_equal))
+        return non_null;
+
+    // Interpolate within the bucket holding the value
+    size_t buckets = histogram.size() - 1;
+    size_t ndx = std::upper_bound(histogram.begin(), histogram.end(), value) - histogram.begin() - 1;
+    if (ndx >= buckets)
+        return non_null;
+    double lo = histogram[ndx];
+    double hi = histogram[ndx + 1];
+    double within = hi > lo ? (value - lo) / (hi - lo) : 0.5;
+    double fraction = (ndx + within) / buckets * non_null;
+    if (or_equal)
+        fraction += equal_fraction(value);
+    return std::min(fraction, non_null);
+}
+
+ColumnStatisticsBuilder::ColumnStatisticsBuilder()
+    : m_registers(size_t(1) << precision, 0)
+{
+}
+
+void ColumnStatisticsBuilder::add(Mixed value)
+{
+    ++m_row_count;
+    if (value.is_null()) {
+        ++m_null_count;
+        return;
+    }
+
+    uint64_t h = hash_value(value);
+    size_t ndx = size_t(h >> (64 - precision));
+    uint64_t rest = h & ((uint64_t(1) << (64 - precision)) - 1);
+    uint8_t rank = uint8_t(rest ? (64 - precision) - highest_bit(rest) : (64 - precision) + 1);
+    m_registers[ndx] = std::max(m_registers[ndx], rank);
+
+    switch (value.get_type()) {
+        case type_Int:
+            m_numeric_values.push_back(double(value.get_int()));
+            break;
+        case type_Float:
+            m_numeric_values.push_back(value.get_float());
+            break;
+        case type_Double:
+            m_numeric_values.push_back(value.get_double());
+            break;
+        default:
+            m_is_numeric = false;
+            break;
+    }
+}
+
+ColumnStatistics ColumnStatisticsBuilder::get() const
+{
+    ColumnStatistics stats;
+    stats.row_count = m_row_count;
+    stats.null_count = m_null_count;
+
+    uint64_t non_null = m_row_count - m_null_count;
+    if (non_null) {
+        double m = double(m_registers.size());
+        double sum = 0;
+        size_t zeros = 0;
+        for (auto r : m_registers) {
+            sum += std::ldexp(1.0, -int(r));
+            if (r == 0)
+                ++zeros;
+        }
+        double alpha = 0.7213 / (1 + 1.079 / m);
+        double estimate = alpha * m * m / sum;
+        // Small range correction
+        if (estimate <= 2.5 * m && zeros)
+            estimate = m * std::log(m / zeros);
+        stats.distinct_count = std::max(uint64_t(1), std::min(non_null, uint64_t(std::llround(estimate))));
+    }
+
+    if (m_is_numeric && !m_numeric_values.empty()) {
+        std::vector<double> values = m_numeric_values;
+        values.erase(std::remove_if(values.begin(), values.end(), [](double d) { return std::isnan(d); }),
+                     values.end());
+        if (!values.empty()) {
+            std::sort(values.begin(), values.end());
+            size_t buckets = std::min(num_buckets, values.size());
+            for (size_t i = 0; i < buckets; ++i)
+                stats.histogram.push_back(values[i * values.size() / buckets]);
+            stats.histogram.push_back(values.back());
+        }
+    }
+
+    return stats;
+}
@@ -0,0 +1,76 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_COLUMN_STATISTICS_HPP
+#define REALM_COLUMN_STATISTICS_HPP
+
+#include <realm/mixed.hpp>
+#include <realm/util/optional.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace realm {
+
+/// Statistics about the values of a column, as computed by
+/// Table::update_statistics(). They are a snapshot taken at that time and are
+/// not maintained as the table changes.
+struct ColumnStatistics {
+    /// Number of objects in the table when the statistics were computed
+    uint64_t row_count = 0;
+    uint64_t null_count = 0;
+    /// Estimated number of distinct non-null values
+    uint64_t distinct_count = 0;
+    /// Boundaries of the buckets of an equi-depth histogram over the non-null
+    /// values, each bucket holding about the same number of values. Only
+    /// computed for integer, float and double columns, empty otherwise.
+    std::vector<double> histogram;
+
+    /// Fraction of the objects having a null value
+    double null_fraction() const;
+    /// Estimated fraction of the objects having a given non-null value. If the
+    /// value is given, it is checked against the range of the histogram.
+    double equal_fraction(util::Optional<double> value = util::none) const;
+    /// Estimated fraction of the objects with a non-null value less than (or
+    /// equal to) the given value. Negative if there is no histogram.
+    double less_fraction(double value, bool or_equal) const;
+};
+
+/// Collects the values of a column to produce its statistics. The number of
+/// distinct values is estimated with a HyperLogLog sketch.
+class ColumnStatisticsBuilder {
+public:
+    ColumnStatisticsBuilder();
+
+    void add(Mixed value);
+    ColumnStatistics get() const;
+
+private:
+    static constexpr unsigned precision = 10;
+    static constexpr size_t num_buckets = 16;
+
+    uint64_t m_row_count = 0;
+    uint64_t m_null_count = 0;
+    std::vector<uint8_t> m_registers;
+    std::vector<double> m_numeric_values;
+    bool m_is_numeric = true;
+};
+
+} // namespace realm
+
+#endif // REALM_COLUMN_STATISTICS_HPP
@@ -54,8 +54,11 @@ enum ColumnAttr {
     /// `col_attr_Indexed`.
     col_attr_Unique = 2,
 
-    /// Reserved for future use.
-    col_attr_Reserved = 4,
+    /// Specifies that the search index of this column stores the words of the
+    /// case folded strings. It requires `col_attr_Indexed`. The bit was
+    /// reserved for future use up to file format 20, so it is only set in
+    /// files of format 21 or later.
+    col_attr_FullText_Indexed = 4,
 
     /// Specifies that the links of this column are strong, not weak. Applies
     /// only to link columns (`type_Link` and `type_LinkList`).
@@ -65,9 +68,25 @@ enum ColumnAttr {
     col_attr_Nullable = 16,
 
     /// Each element is a list of values
-    col_attr_List = 32
+    col_attr_List = 32,
+
+    /// Specifies that the search index of this column stores case folded
+    /// strings. It requires `col_attr_Indexed`.
+    col_attr_CaseInsensitive_Indexed = 64,
+
+    /// Specifies that the search index of this column stores the n-grams of
+    /// the case folded strings. It requires `col_attr_Indexed`.
+    col_attr_NGram_Indexed = 128
 };
 
+/// The kind of search index on a column. A general index is used for exact
+/// matching. A case insensitive index stores case folded strings, so that a
+/// case insensitive equality query can be answered by a single lookup. An
+/// n-gram index narrows down the candidates for substring and wildcard
+/// queries (contains, begins_with, ends_with and like). A full-text index
+/// maps each word to the objects containing it and answers text_match queries.
+enum class IndexType { None, General, CaseInsensitive, NGram, Fulltext };
+
 class ColumnAttrMask {
 public:
     ColumnAttrMask()
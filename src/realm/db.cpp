@@ -768,6 +768,10 @@ void DB::do_open(const std::string& path, bool no_create_file, bool is_backend,
     }
 #endif // REALM_METRICS
 
+    if (options.query_result_cache_size) {
+        m_query_result_cache = std::make_shared<QueryResultCache>(options.query_result_cache_size);
+    }
+
     Replication::HistoryType openers_hist_type = Replication::hist_None;
     int openers_hist_schema_version = 0;
     bool opener_is_sync_agent = false;
@@ -1065,6 +1069,7 @@ void DB::do_open(const std::string& path, bool no_create_file, bool is_backend,
                 case 10:
                 case 11:
                 case 20:
+                case 21:
                     file_format_ok = true;
                     break;
             }
@@ -2060,6 +2065,9 @@ void DB::do_end_write() noexcept
 
 Replication::version_type DB::do_commit(Transaction& transaction)
 {
+    // Free a bounded part of the nodes left by removed tables and columns
+    transaction.destroy_deferred(Group::s_deferred_destroy_chunk_size); // Throws
+
     version_type current_version;
     {
         std::lock_guard<std::recursive_mutex> lock(m_mutex);
@@ -2372,6 +2380,7 @@ Transaction::Transaction(DBRef _db, SlabAlloc* alloc, DB::ReadLockInfo& rli, DB:
     bool writable = stage == DB::transact_Writing;
     m_transact_stage = DB::transact_Ready;
     set_metrics(db->m_metrics);
+    m_query_result_cache = db->m_query_result_cache;
     set_transact_stage(stage);
     m_alloc.note_reader_start(this);
     attach_shared(m_read_lock.m_top_ref, m_read_lock.m_file_size, writable);
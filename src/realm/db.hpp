@@ -22,6 +22,7 @@
 #include <functional>
 #include <cstdint>
 #include <limits>
+#include <type_traits>
 #include <realm/util/features.h>
 #include <realm/util/thread.hpp>
 #include <realm/util/interprocess_condvar.hpp>
@@ -30,6 +31,7 @@
 #include <realm/handover_defs.hpp>
 #include <realm/impl/transact_log.hpp>
 #include <realm/metrics/metrics.hpp>
+#include <realm/object_change_set.hpp>
 #include <realm/replication.hpp>
 #include <realm/version_id.hpp>
 #include <realm/db_options.hpp>
@@ -348,6 +350,12 @@ public:
         return m_metrics;
     }
 
+    /// The cache of query results, or null if DBOptions::query_result_cache_size was zero
+    QueryResultCache* get_query_result_cache()
+    {
+        return m_query_result_cache.get();
+    }
+
     // Try to grab a exclusive lock of the given realm path's lock file. If the lock
     // can be acquired, the callback will be executed with the lock and then return true.
     // Otherwise false will be returned directly.
@@ -415,6 +423,7 @@ private:
     std::function<void(int, int)> m_upgrade_callback;
 
     std::shared_ptr<metrics::Metrics> m_metrics;
+    std::shared_ptr<QueryResultCache> m_query_result_cache;
     /// Attach this DB instance to the specified database file.
     ///
     /// While at least one instance of DB exists for a specific
@@ -994,7 +1003,15 @@ inline bool Transaction::internal_advance_read(O* observer, VersionID version_id
         ref_type new_top_ref = new_read_lock.m_top_ref;
         size_t new_file_size = new_read_lock.m_file_size;
         _impl::ChangesetInputStream in(hist, old_version, new_version);
+        if constexpr (std::is_base_of_v<ObjectChangeSet, O>) {
+            if (observer)
+                observer->advance_begin(*this);
+        }
         advance_transact(new_top_ref, new_file_size, in, writable); // Throws
+        if constexpr (std::is_base_of_v<ObjectChangeSet, O>) {
+            if (observer)
+                observer->advance_end(*this);
+        }
     }
     g.release();
     db->release_read_lock(m_read_lock);
@@ -101,6 +101,12 @@ struct DBOptions {
     /// is exceeded without being consumed, only the most recent entries will be stored.
     size_t metrics_buffer_size;
 
+    /// The memory, in bytes, which may be used to keep the results of queries
+    /// between transactions. A count, find, find_all or aggregate on a query
+    /// which has run before returns the stored result if none of the tables the
+    /// query depends on have changed since. Zero, the default, disables this.
+    size_t query_result_cache_size = 0;
+
     /// sys_tmp_dir will be used if the temp_dir is empty when creating DBOptions.
     /// It must be writable and allowed to create pipe/fifo file on it.
     /// set_sys_tmp_dir is not a thread-safe call and it is only supposed to be called once
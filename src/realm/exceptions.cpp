@@ -106,6 +106,8 @@ const char* LogicError::message() const noexcept
             return "Search index on a subtable of a subtable is not yet supported";
         case list_type_mismatch:
             return "Instantiating a list object not matching column type";
+        case file_format_too_old:
+            return "Not supported by the file format of the Realm file";
     }
     return "Unknown error";
 }
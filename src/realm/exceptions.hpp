@@ -304,7 +304,12 @@ public:
         subtable_of_subtable_index,
 
         /// You try to instantiate a list object not matching column type
-        list_type_mismatch
+        list_type_mismatch,
+
+        /// The operation would store data which cannot be read by the file
+        /// format of the Realm file. Files are only upgraded to the current
+        /// file format when opened with a history.
+        file_format_too_old
     };
 
     LogicError(ErrorKind message);
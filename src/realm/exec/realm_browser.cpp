@@ -1,4 +1,6 @@
 #include <realm.hpp>
+#include <realm/parser/parser.hpp>
+#include <realm/parser/query_builder.hpp>
 #include <iostream>
 #include <ctime>
 
@@ -15,11 +17,15 @@ bool get_table_ndx(size_t& ndx)
     return *endp == '\0';
 }
 
-bool get_range(size_t size, size_t& begin, size_t& end)
+bool get_range(size_t size, size_t& begin, size_t& end, std::string& query)
 {
-    std::cout << "Size " << size << ". Range? ";
+    std::cout << "Size " << size << ". Range (or ?query)? ";
     std::string inp;
     getline(std::cin, inp);
+    if (inp.size() > 0 && inp[0] == '?') {
+        query = inp.substr(1);
+        return true;
+    }
     if (inp.size() == 0) {
         begin = 0;
         end = size;
@@ -137,6 +143,19 @@ void print_objects(ConstTableRef table, size_t begin, size_t end)
     }
 }
 
+void explain_query(ConstTableRef table, const std::string& query_string)
+{
+    try {
+        Query query = table->where();
+        query_builder::NoArguments args;
+        query_builder::apply_predicate(query, parser::parse(query_string).predicate, args);
+        std::cout << query.explain_analyze().to_string();
+    }
+    catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+    }
+}
+
 int main(int argc, char const* argv[])
 {
     if (argc > 1) {
@@ -152,8 +171,15 @@ int main(int argc, char const* argv[])
             auto sz = table->size();
             size_t begin;
             size_t end;
-            while (get_range(sz, begin, end)) {
-                print_objects(table, begin, end);
+            std::string query;
+            while (get_range(sz, begin, end, query)) {
+                if (query.empty()) {
+                    print_objects(table, begin, end);
+                }
+                else {
+                    explain_query(table, query);
+                    query.clear();
+                }
             }
         }
     }
@@ -316,12 +316,13 @@ int Group::get_target_file_format_version_for_session(int current_file_format_ve
     // Please see Group::get_file_format_version() for information about the
     // individual file format versions.
 
-    if (requested_history_type == Replication::hist_None && current_file_format_version == 11) {
-        // We are able to open file format 11 in RO mode
-        return 11;
+    if (requested_history_type == Replication::hist_None &&
+        (current_file_format_version == 11 || current_file_format_version == 20)) {
+        // We are able to open file format 11 and 20 in RO mode
+        return current_file_format_version;
     }
 
-    return 20;
+    return 21;
 }
 
 void Group::get_version_and_history_info(const Array& top, _impl::History::version_type& version, int& history_type,
@@ -379,7 +380,7 @@ void Transaction::upgrade_file_format(int target_file_format_version)
     // Be sure to revisit the following upgrade logic when a new file format
     // version is introduced. The following assert attempt to help you not
     // forget it.
-    REALM_ASSERT_EX(target_file_format_version == 20, target_file_format_version);
+    REALM_ASSERT_EX(target_file_format_version == 21, target_file_format_version);
 
     int current_file_format_version = get_file_format_version();
     REALM_ASSERT(current_file_format_version < target_file_format_version);
@@ -387,7 +388,8 @@ void Transaction::upgrade_file_format(int target_file_format_version)
     // DB::do_open() must ensure this. Be sure to revisit the
     // following upgrade logic when DB::do_open() is changed (or
     // vice versa).
-    REALM_ASSERT_EX(current_file_format_version >= 5 && current_file_format_version <= 11,
+    REALM_ASSERT_EX((current_file_format_version >= 5 && current_file_format_version <= 11) ||
+                        current_file_format_version == 20,
                     current_file_format_version);
 
 
@@ -525,6 +527,9 @@ void Transaction::upgrade_file_format(int target_file_format_version)
         }
     }
 
+    // Nothing needs to be done to go from 20 to 21, as the slot for deferred
+    // destroys in the top array is optional.
+
     // NOTE: Additional future upgrade steps go here.
 }
 
@@ -547,6 +552,7 @@ void Group::open(ref_type top_ref, const std::string& file_path)
             break;
         case 11:
         case 20:
+        case 21:
             file_format_ok = true;
             break;
     }
@@ -657,7 +663,8 @@ void Group::validate_top_array(const Array& arr, const SlabAlloc& alloc)
         case 7:
         case 9:
         case 10:
-        case 11: {
+        case 11:
+        case 12: {
             ref_type table_names_ref = arr.get_as_ref_or_tagged(s_table_name_ndx).get_as_ref();
             ref_type tables_ref = arr.get_as_ref_or_tagged(s_table_refs_ndx).get_as_ref();
             auto logical_file_size = arr.get_as_ref_or_tagged(s_file_size_ndx).get_as_int();
@@ -890,7 +897,13 @@ Table* Group::do_add_table(StringData name, bool is_embedded, bool do_repl)
 
     using namespace _impl;
     size_t table_ndx = key2ndx(key);
-    ref_type ref = Table::create_empty_table(m_alloc, key); // Throws
+    // Versions of a table are compared between transactions, so they must not repeat those of a
+    // removed table with the same key
+    _impl::History::version_type version = 0;
+    int history_type = 0;
+    int history_schema_version = 0;
+    get_version_and_history_info(m_top, version, history_type, history_schema_version);
+    ref_type ref = Table::create_empty_table(m_alloc, key, version); // Throws
     REALM_ASSERT_3(m_tables.size(), ==, m_table_names.size());
 
     rot = RefOrTagged::make_ref(ref);
@@ -1014,11 +1027,18 @@ void Group::remove_table(size_t table_ndx, TableKey key)
     // involves removal of the corresponding backlink columns. For that reason,
     // we start by removing all columns, which will generate individual
     // replication instructions for each column removal with sufficient
-    // information for Group::TransactAdvancer to handle them.
+    // information for Group::TransactAdvancer to handle them. Only the link
+    // columns need to be removed from the clusters, as they affect other
+    // tables; the leaves of the others go away with the table.
     size_t n = table->get_column_count();
     for (size_t i = n; i > 0; --i) {
         ColKey col_key = table->spec_ndx2colkey(i - 1);
-        table->remove_column(col_key);
+        if (Table::is_link_type(col_key.get_type())) {
+            table->remove_column(col_key);
+        }
+        else if (Replication* repl = *get_repl()) {
+            repl->erase_column(table.unchecked_ptr(), col_key); // Throws
+        }
     }
 
     size_t prior_num_tables = m_tables.size();
@@ -1039,11 +1059,139 @@ void Group::remove_table(size_t table_ndx, TableKey key)
 
     table->detach();
     // Destroy underlying node structure
-    Array::destroy_deep(ref, m_alloc);
+    defer_destroy_deep(ref);
     recycle_table_accessor(table.unchecked_ptr());
 }
 
 
+void Group::defer_destroy_deep(ref_type ref)
+{
+    // Files of earlier formats cannot hold the list of deferred destroys
+    if (!m_is_shared || m_file_format_version < 21) {
+        Array::destroy_deep(ref, m_alloc);
+        return;
+    }
+
+    char* header = m_alloc.translate(ref);
+    if (!m_alloc.is_read_only(ref)) {
+        // Created in this transaction, so the node is not part of any version
+        // and can be freed right away. The children may not be.
+        if (NodeHeader::get_hasrefs_from_header(header)) {
+            Array node(m_alloc);
+            node.init_from_mem(MemRef(header, ref, m_alloc));
+            size_t sz = node.size();
+            for (size_t i = 0; i < sz; ++i) {
+                int64_t value = node.get(i);
+                if (value != 0 && (value & 1) == 0)
+                    defer_destroy_deep(to_ref(value));
+            }
+        }
+        m_alloc.free_(ref, header);
+        return;
+    }
+
+    Array deferred(m_alloc);
+    deferred.set_parent(&m_top, s_deferred_destroy_ndx);
+    if (m_top.size() > s_deferred_destroy_ndx) {
+        deferred.init_from_parent();
+    }
+    else {
+        // The top array has been written by a commit, so it has at least 7
+        // entries. The first entry of the list remembers the size of the top
+        // array, which is restored once the list is empty.
+        size_t top_size = m_top.size();
+        REALM_ASSERT(top_size >= s_version_ndx + 1);
+        while (m_top.size() < s_deferred_destroy_ndx)
+            m_top.add(get_top_padding(m_top.size())); // Throws
+        m_top.add(0);                                 // Throws
+        deferred.create(Array::type_HasRefs);         // Throws
+        deferred.update_parent();                     // Throws
+        deferred.add(RefOrTagged::make_tagged(top_size)); // Throws
+    }
+    deferred.add(from_ref(ref)); // Throws
+}
+
+
+RefOrTagged Group::get_top_padding(size_t ndx) const
+{
+    // The values the optional slots are read as when they are missing
+    switch (ndx) {
+        case s_hist_type_ndx:
+            return RefOrTagged::make_tagged(Replication::hist_None);
+        case s_hist_version_ndx:
+            return RefOrTagged::make_tagged(0);
+        case s_sync_file_id_ndx: {
+            auto repl = get_replication();
+            bool is_sync_server = (repl && repl->get_history_type() == Replication::hist_SyncServer);
+            return RefOrTagged::make_tagged(is_sync_server ? 1 : 0);
+        }
+    }
+    return RefOrTagged::make_ref(0);
+}
+
+
+size_t Group::destroy_deferred(size_t max_nodes)
+{
+    if (!m_is_writable)
+        throw LogicError(LogicError::wrong_transact_state);
+    if (m_top.size() <= s_deferred_destroy_ndx)
+        return 0;
+
+    Array deferred(m_alloc);
+    deferred.set_parent(&m_top, s_deferred_destroy_ndx);
+    deferred.init_from_parent();
+
+    // Free the nodes depth first, so the list only grows by the children of
+    // the nodes on the path to the current one
+    size_t num_freed = 0;
+    while (num_freed < max_nodes && deferred.size() > 1) {
+        size_t last = deferred.size() - 1;
+        ref_type ref = to_ref(deferred.get(last));
+        deferred.erase(last); // Throws
+        char* header = m_alloc.translate(ref);
+        if (NodeHeader::get_hasrefs_from_header(header)) {
+            Array node(m_alloc);
+            node.init_from_mem(MemRef(header, ref, m_alloc));
+            size_t sz = node.size();
+            for (size_t i = 0; i < sz; ++i) {
+                int64_t value = node.get(i);
+                if (value != 0 && (value & 1) == 0)
+                    deferred.add(value); // Throws
+            }
+        }
+        m_alloc.free_(ref, header);
+        ++num_freed;
+    }
+
+    if (deferred.size() == 1) {
+        // Remove the slots added for the list, except those which have been
+        // given a value since
+        size_t top_size = size_t(deferred.get_as_ref_or_tagged(0).get_as_int());
+        deferred.destroy();
+        auto is_padding = [&](size_t ndx) {
+            RefOrTagged rot = m_top.get_as_ref_or_tagged(ndx);
+            RefOrTagged padding = get_top_padding(ndx);
+            return rot.is_tagged() == padding.is_tagged() && rot.get_as_int() == padding.get_as_int();
+        };
+        size_t new_top_size = s_deferred_destroy_ndx;
+        while (new_top_size > top_size && is_padding(new_top_size - 1))
+            --new_top_size;
+        m_top.truncate(new_top_size); // Throws
+    }
+    return num_freed;
+}
+
+
+size_t Group::get_deferred_destroy_count() const noexcept
+{
+    if (!m_top.is_attached() || m_top.size() <= s_deferred_destroy_ndx)
+        return 0;
+    // The first entry of the list is the size of the top array before it
+    ref_type ref = m_top.get_as_ref(s_deferred_destroy_ndx);
+    return ref ? Array::get_size_from_header(m_alloc.translate(ref)) - 1 : 0;
+}
+
+
 void Group::rename_table(StringData name, StringData new_name, bool require_unique_name)
 {
     if (REALM_UNLIKELY(!is_attached()))
@@ -1265,7 +1413,7 @@ void Group::write(std::ostream& out, int file_format_version, TableWriter& table
                 top.add(RefOrTagged::make_ref(history_info.ref));
                 top.add(RefOrTagged::make_tagged(history_info.version));
                 top.add(RefOrTagged::make_tagged(history_info.sync_file_id));
-                top_size = s_group_max_size;
+                top_size = s_sync_file_id_ndx + 1;
             }
         }
         top_ref = out_2.get_ref_of_next_array();
@@ -1421,6 +1569,10 @@ size_t Group::compute_aggregated_byte_size(SizeAggregateControl ctrl) const noex
         m_tables.stats(stats);
         used = stats.allocated + m_top.get_byte_size();
         used += sizeof(SlabAlloc::Header);
+        if (m_top.size() > s_deferred_destroy_ndx) {
+            auto ref = m_top.get_as_ref_or_tagged(s_deferred_destroy_ndx).get_as_ref();
+            used += size_of_tree_from_ref(ref, alloc);
+        }
     }
     if (ctrl & SizeAggregateControl::size_of_freelists) {
         if (m_top.size() >= 6) {
@@ -1712,7 +1864,7 @@ void Group::advance_transact(ref_type new_top_ref, size_t new_file_size, _impl::
 void Group::prepare_top_for_history(int history_type, int history_schema_version, uint64_t file_ident)
 {
     REALM_ASSERT(m_file_format_version >= 7);
-    if (m_top.size() < s_group_max_size) {
+    if (m_top.size() < s_sync_file_id_ndx + 1) {
         REALM_ASSERT(m_top.size() <= s_hist_type_ndx);
         while (m_top.size() < s_hist_type_ndx) {
             m_top.add(0); // Throws
@@ -1903,7 +2055,7 @@ void Group::verify() const
     MemUsageVerifier mem_usage_2(ref_begin, immutable_ref_end, mutable_ref_end, baseline);
     {
         REALM_ASSERT_EX(m_top.size() == 3 || m_top.size() == 5 || m_top.size() == 7 || m_top.size() == 10 ||
-                            m_top.size() == 11,
+                            m_top.size() == 11 || m_top.size() == 12,
                         m_top.size());
         Allocator& alloc = m_top.get_alloc();
         Array pos(alloc), len(alloc), ver(alloc);
@@ -31,6 +31,7 @@
 #include <realm/impl/output_stream.hpp>
 #include <realm/impl/cont_transact_hist.hpp>
 #include <realm/metrics/metrics.hpp>
+#include <realm/query_result_cache.hpp>
 #include <realm/table.hpp>
 #include <realm/alloc_slab.hpp>
 
@@ -268,7 +269,10 @@ public:
     ///
     /// remove_table() removes the specified table from this group. A table can
     /// be removed only when it is not the target of a link column of a
-    /// different table.
+    /// different table. In a write transaction the table disappears and its
+    /// key can be reused right away, but the nodes of the table which are part
+    /// of the previous version are freed by the following commits, a bounded
+    /// number at a time (see destroy_deferred()).
     ///
     /// rename_table() changes the name of a preexisting table. If \a
     /// require_unique_name is false, it becomes possible to have more than one
@@ -543,6 +547,14 @@ public:
     /// identical, the numbers will of course be equal.
     size_t get_used_space() const noexcept;
 
+    /// Free at most \a max_nodes of the array nodes of removed tables and
+    /// columns which are still waiting to be destroyed. Every commit does this
+    /// for a bounded number of nodes, so it only needs to be called to get the
+    /// space back sooner. Returns the number of nodes freed.
+    size_t destroy_deferred(size_t max_nodes);
+    /// Number of removed subtrees which are still waiting to be destroyed.
+    size_t get_deferred_destroy_count() const noexcept;
+
     void verify() const;
     void validate_primary_columns();
 #ifdef REALM_DEBUG
@@ -590,12 +602,19 @@ private:
     ///    9th   History ref          (optional)             4
     ///   10th   History version      (optional)             7
     ///   11th   Sync File Id         (optional)            10
+    ///   12th   Deferred destroys    (optional)            21
     ///
     /// </pre>
     ///
     /// The 'History type' slot stores a value of type
     /// Replication::HistoryType. The 'History version' slot stores a history
     /// schema version as returned by Replication::get_history_schema_version().
+    /// The 'Deferred destroys' slot refers to a list whose first entry is the
+    /// size of the top array before the slot was added, followed by the roots
+    /// of the subtrees left by removed tables and columns which have not yet
+    /// been freed. It is only present while there are such subtrees, and the
+    /// slots it required are removed with it unless they have been given a
+    /// value since.
     ///
     /// The first three entries are mandatory. In files created by
     /// Group::write(), none of the optional entries are present and the size of
@@ -629,6 +648,7 @@ private:
     std::function<void(const CascadeNotification&)> m_notify_handler;
     std::function<void()> m_schema_change_handler;
     std::shared_ptr<metrics::Metrics> m_metrics;
+    std::shared_ptr<QueryResultCache> m_query_result_cache;
     size_t m_total_rows;
 
     class TableRecycler : public std::vector<Table*> {
@@ -652,8 +672,12 @@ private:
     static constexpr size_t s_hist_ref_ndx = 8;
     static constexpr size_t s_hist_version_ndx = 9;
     static constexpr size_t s_sync_file_id_ndx = 10;
+    static constexpr size_t s_deferred_destroy_ndx = 11;
+
+    static constexpr size_t s_group_max_size = 12;
 
-    static constexpr size_t s_group_max_size = 11;
+    // Max number of nodes freed by each commit, see destroy_deferred()
+    static constexpr size_t s_deferred_destroy_chunk_size = 4096;
 
     // We use the classic approach to construct a FIFO from two LIFO's,
     // insertion is done into recycler_1, removal is done from recycler_2,
@@ -698,6 +722,13 @@ private:
 
     void create_empty_group();
     void remove_table(size_t table_ndx, TableKey key);
+    /// Destroy the node structure at 'ref' like Array::destroy_deep(). Nodes
+    /// created in the current write transaction are freed immediately, the
+    /// others are left to destroy_deferred().
+    void defer_destroy_deep(ref_type ref);
+    /// The value an optional slot of the top array is given when later slots
+    /// are needed, which is read the same way as a missing slot.
+    RefOrTagged get_top_padding(size_t ndx) const;
 
     void reset_free_space_tracking();
 
@@ -744,6 +775,10 @@ private:
 
     std::shared_ptr<metrics::Metrics> get_metrics() const noexcept;
     void set_metrics(std::shared_ptr<metrics::Metrics> other) noexcept;
+    QueryResultCache* get_query_result_cache() const noexcept
+    {
+        return m_query_result_cache.get();
+    }
     void update_num_objects();
     class TransactAdvancer;
     void advance_transact(ref_type new_top_ref, size_t new_file_size, _impl::NoCopyInputStream&, bool writable);
@@ -819,6 +854,13 @@ private:
     ///
     ///  20 New data types: Decimal128 and ObjectId. Embedded tables.
     ///
+    ///  21 Introduced "deferred destroys" as optional 12th entry in top array.
+    ///     Case insensitive search indexes (col_attr_CaseInsensitive_Indexed).
+    ///     N-gram search indexes (col_attr_NGram_Indexed).
+    ///     Full-text search indexes (col_attr_FullText_Indexed, which reuses the
+    ///     bit reserved for future use up to file format 20).
+    ///     Per table cluster node size as optional 16th entry in table top array.
+    ///
     /// IMPORTANT: When introducing a new file format version, be sure to review
     /// the file validity checks in Group::open() and DB::do_open, the file
     /// format selection logic in
@@ -868,6 +910,7 @@ private:
     friend class TrivialReplication;
     friend class metrics::QueryInfo;
     friend class metrics::Metrics;
+    friend class Query;
     friend class Transaction;
     friend class TableKeyIterator;
     friend class CascadeState;
@@ -355,6 +355,16 @@ ref_type GroupWriter::write_group()
         }
     }
 
+    // Write the list of subtrees waiting to be destroyed. The subtrees are
+    // part of previous versions, so they are not written again.
+    if (top.size() > Group::s_deferred_destroy_ndx) {
+        if (ref_type deferred_ref = top.get_as_ref(Group::s_deferred_destroy_ndx)) {
+            Allocator& alloc = top.get_alloc();
+            ref_type new_deferred_ref = Array::write(deferred_ref, alloc, *this, only_if_modified); // Throws
+            top.set(Group::s_deferred_destroy_ndx, from_ref(new_deferred_ref));                   // Throws
+        }
+    }
+
 #if REALM_ALLOC_DEBUG
     std::cout << "    Freelist size after allocations: " << m_size_map.size() << std::endl;
 #endif
@@ -16,8 +16,11 @@
  *
  **************************************************************************/
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
+#include <iterator>
+#include <limits>
 
 #ifdef REALM_DEBUG
 #include <iostream>
@@ -25,6 +28,7 @@
 
 #include <realm/exceptions.hpp>
 #include <realm/index_string.hpp>
+#include <realm/list.hpp>
 #include <realm/table.hpp>
 #include <realm/timestamp.hpp>
 #include <realm/column_integer.hpp>
@@ -41,6 +45,57 @@ void get_child(Array& parent, size_t child_ref_ndx, Array& child) noexcept
     child.set_parent(&parent, child_ref_ndx);
 }
 
+// Returns the distinct n-grams of 'value' in sorted order. They refer to the data of 'value'.
+std::vector<StringData> get_ngrams(StringData value)
+{
+    std::vector<StringData> ngrams;
+    const size_t n = StringIndex::s_ngram_length;
+    if (value.size() < n)
+        return ngrams;
+    ngrams.reserve(value.size() - n + 1);
+    for (size_t i = 0; i + n <= value.size(); ++i) {
+        ngrams.push_back(value.substr(i, n));
+    }
+    std::sort(ngrams.begin(), ngrams.end());
+    ngrams.erase(std::unique(ngrams.begin(), ngrams.end()), ngrams.end());
+    return ngrams;
+}
+
+inline bool is_word_char(char c) noexcept
+{
+    // Bytes of multi byte UTF-8 sequences are considered part of a word
+    unsigned char u = static_cast<unsigned char>(c);
+    return u >= 0x80 || (u >= '0' && u <= '9') || (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z');
+}
+
+// Returns the words of 'value' in the order they appear. They refer to the data of 'value'.
+std::vector<StringData> get_words(StringData value)
+{
+    std::vector<StringData> words;
+    const char* data = value.data();
+    size_t n = value.size();
+    size_t i = 0;
+    while (i < n) {
+        while (i < n && !is_word_char(data[i]))
+            ++i;
+        size_t begin = i;
+        while (i < n && is_word_char(data[i]))
+            ++i;
+        if (i > begin)
+            words.push_back(value.substr(begin, i - begin));
+    }
+    return words;
+}
+
+// Returns the distinct words of 'value' in sorted order
+std::vector<StringData> get_tokens(StringData value)
+{
+    std::vector<StringData> tokens = get_words(value);
+    std::sort(tokens.begin(), tokens.end());
+    tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+    return tokens;
+}
+
 } // anonymous namespace
 
 DataType ClusterColumn::get_data_type() const
@@ -56,7 +111,11 @@ bool ClusterColumn::is_nullable() const
 
 StringData ClusterColumn::get_index_data(ObjKey key, StringConversionBuffer& buffer) const
 {
-    ConstObj obj = m_cluster_tree->get(key);
+    return get_index_data(m_cluster_tree->get(key), buffer);
+}
+
+StringData ClusterColumn::get_index_data(const ConstObj& obj, StringConversionBuffer& buffer) const
+{
     DataType type = get_data_type();
 
     if (type == type_Int) {
@@ -97,11 +156,92 @@ StringData ClusterColumn::get_index_data(ObjKey key, StringConversionBuffer& buf
             return stringifier.get_index_data(obj.get<ObjectId>(m_column_key), buffer);
         }
     }
+    else if (type == type_Float) {
+        // A null is read as the null float and stored as null
+        GetIndexData<float> stringifier;
+        return stringifier.get_index_data(obj.get<float>(m_column_key), buffer);
+    }
+    else if (type == type_Double) {
+        GetIndexData<double> stringifier;
+        return stringifier.get_index_data(obj.get<double>(m_column_key), buffer);
+    }
+    else if (type == type_Decimal) {
+        GetIndexData<Decimal128> stringifier;
+        return stringifier.get_index_data(obj.get<Decimal128>(m_column_key), buffer);
+    }
     // It should not be possible to reach this line through public Core API
     REALM_ASSERT_RELEASE(false);
     return {};
 }
 
+void ClusterColumn::for_each_list_index_data(ObjKey key, util::FunctionRef<void(StringData)> func) const
+{
+    ConstObj obj = m_cluster_tree->get(key);
+    StringConversionBuffer buffer;
+    auto for_each = [&](const auto& list) {
+        size_t sz = list.size();
+        for (size_t i = 0; i < sz; i++) {
+            func(to_str(list.get(i), buffer));
+        }
+    };
+
+    switch (get_data_type()) {
+        case type_Int:
+            if (is_nullable()) {
+                for_each(obj.get_list<Optional<int64_t>>(m_column_key));
+            }
+            else {
+                for_each(obj.get_list<int64_t>(m_column_key));
+            }
+            return;
+        case type_Bool:
+            if (is_nullable()) {
+                for_each(obj.get_list<Optional<bool>>(m_column_key));
+            }
+            else {
+                for_each(obj.get_list<bool>(m_column_key));
+            }
+            return;
+        case type_String:
+            for_each(obj.get_list<String>(m_column_key));
+            return;
+        case type_Timestamp:
+            for_each(obj.get_list<Timestamp>(m_column_key));
+            return;
+        case type_ObjectId:
+            if (is_nullable()) {
+                for_each(obj.get_list<Optional<ObjectId>>(m_column_key));
+            }
+            else {
+                for_each(obj.get_list<ObjectId>(m_column_key));
+            }
+            return;
+        case type_Float:
+            if (is_nullable()) {
+                for_each(obj.get_list<Optional<float>>(m_column_key));
+            }
+            else {
+                for_each(obj.get_list<float>(m_column_key));
+            }
+            return;
+        case type_Double:
+            if (is_nullable()) {
+                for_each(obj.get_list<Optional<double>>(m_column_key));
+            }
+            else {
+                for_each(obj.get_list<double>(m_column_key));
+            }
+            return;
+        case type_Decimal:
+            for_each(obj.get_list<Decimal128>(m_column_key));
+            return;
+        default:
+            break;
+    }
+    // It should not be possible to reach this line through public Core API
+    REALM_ASSERT_RELEASE(false);
+}
+
 namespace realm {
 StringData GetIndexData<Timestamp>::get_index_data(const Timestamp& dt, StringConversionBuffer& buffer)
 {
@@ -119,6 +259,100 @@ StringData GetIndexData<Timestamp>::get_index_data(const Timestamp& dt, StringCo
     return StringData{buffer.data(), index_size};
 }
 
+namespace {
+
+template <class T>
+StringData get_floating_point_index_data(T value, StringConversionBuffer& buffer)
+{
+    if (null::is_null_float(value))
+        return null{};
+
+    if (value == 0) {
+        value = 0; // Also -0.0
+    }
+    else if (std::isnan(value)) {
+        value = std::numeric_limits<T>::quiet_NaN();
+    }
+    static_assert(sizeof(T) <= string_conversion_buffer_size, "Index string conversion buffer too small");
+    memcpy(buffer.data(), &value, sizeof(T));
+    return StringData{buffer.data(), sizeof(T)};
+}
+
+// Divides the 128 bit value 'hi:lo' by 10 if it leaves no remainder
+bool divide_by_ten(uint64_t& hi, uint64_t& lo) noexcept
+{
+    uint32_t digits[4] = {uint32_t(hi >> 32), uint32_t(hi), uint32_t(lo >> 32), uint32_t(lo)};
+    uint64_t remainder = 0;
+    for (auto& d : digits) {
+        uint64_t current = (remainder << 32) | d;
+        d = uint32_t(current / 10);
+        remainder = current % 10;
+    }
+    if (remainder != 0)
+        return false;
+    hi = (uint64_t(digits[0]) << 32) | digits[1];
+    lo = (uint64_t(digits[2]) << 32) | digits[3];
+    return true;
+}
+
+} // anonymous namespace
+
+StringData GetIndexData<float>::get_index_data(float value, StringConversionBuffer& buffer)
+{
+    return get_floating_point_index_data(value, buffer);
+}
+
+StringData GetIndexData<double>::get_index_data(double value, StringConversionBuffer& buffer)
+{
+    return get_floating_point_index_data(value, buffer);
+}
+
+StringData GetIndexData<Decimal128>::get_index_data(const Decimal128& value, StringConversionBuffer& buffer)
+{
+    if (value.is_null())
+        return null{};
+
+    const uint64_t* w = value.raw()->w;
+    Decimal128::Bid128 key;
+    if (value.is_nan()) {
+        key.w[0] = 0;
+        key.w[1] = 0x7c00000000000000ull;
+    }
+    else if ((w[1] & 0x7800000000000000ull) == 0x7800000000000000ull) {
+        // Infinity, keep the sign
+        key.w[0] = 0;
+        key.w[1] = w[1] & 0xf800000000000000ull;
+    }
+    else {
+        bool sign = (w[1] & 0x8000000000000000ull) != 0;
+        uint64_t exponent = (w[1] >> 49) & 0x3fff;
+        uint64_t hi = w[1] & 0x0001ffffffffffffull;
+        uint64_t lo = w[0];
+        // A coefficient of 10^34 or more (including the alternative encoding) is non-canonical and means zero
+        constexpr uint64_t max_hi = 0x0001ed09bead87c0ull;
+        constexpr uint64_t max_lo = 0x378d8e63ffffffffull;
+        if ((w[1] & 0x6000000000000000ull) == 0x6000000000000000ull || hi > max_hi ||
+            (hi == max_hi && lo > max_lo)) {
+            hi = lo = 0;
+        }
+        if (hi == 0 && lo == 0) {
+            // All zeros are equal regardless of sign and exponent
+            sign = false;
+            exponent = 0;
+        }
+        else {
+            // The exponent stays below 2^14 as at most 33 digits are removed
+            while (divide_by_ten(hi, lo))
+                ++exponent;
+        }
+        key.w[0] = lo;
+        key.w[1] = (uint64_t(sign) << 63) | (exponent << 49) | hi;
+    }
+    static_assert(sizeof(key) <= string_conversion_buffer_size, "Index string conversion buffer too small");
+    memcpy(buffer.data(), &key, sizeof(key));
+    return StringData{buffer.data(), sizeof(key)};
+}
+
 template <>
 int64_t IndexArray::from_list<index_FindFirst>(StringData value, InternalFindResult& /* result_ref */,
                                                const IntegerColumn& key_values, const ClusterColumn& column) const
@@ -278,10 +512,17 @@ int64_t IndexArray::index_string(StringData value, InternalFindResult& result_re
         if (ref & 1) {
             int64_t key_value = int64_t(ref >> 1);
 
-            // The buffer is needed when for when this is an integer index.
-            StringConversionBuffer buffer;
-            StringData str = column.get_index_data(ObjKey(key_value), buffer);
-            if (str == value) {
+            bool match;
+            if (column.full_word()) {
+                match = StringIndex::is_last_key(value, stringoffset);
+            }
+            else {
+                // The buffer is needed when for when this is an integer index.
+                StringConversionBuffer buffer;
+                StringData str = column.get_index_data(ObjKey(key_value), buffer);
+                match = (str == value);
+            }
+            if (match) {
                 result_ref.payload = key_value;
                 return first ? key_value : get_count ? 1 : FindRes_single;
             }
@@ -294,6 +535,27 @@ int64_t IndexArray::index_string(StringData value, InternalFindResult& result_re
         // List of row indices with common prefix up to this point, in sorted order.
         if (!sub_isindex) {
             const IntegerColumn sub(m_alloc, ref_type(ref));
+            if (column.full_word()) {
+                // All entries refer to the value ending at this key
+                if (!StringIndex::is_last_key(value, stringoffset))
+                    return local_not_found;
+                if constexpr (first) {
+                    return sub.get(0);
+                }
+                else if constexpr (get_count) {
+                    return int64_t(sub.size());
+                }
+                else {
+                    if (sub.size() == 1) {
+                        result_ref.payload = sub.get(0);
+                        return FindRes_single;
+                    }
+                    result_ref.payload = from_ref(sub.get_ref());
+                    result_ref.start_ndx = 0;
+                    result_ref.end_ndx = sub.size();
+                    return FindRes_column;
+                }
+            }
             return from_list<method>(value, result_ref, sub, column);
         }
 
@@ -537,6 +799,13 @@ void IndexArray::index_string_all_ins(StringData value, std::vector<ObjKey>& res
         if (ref & 1) {
             ObjKey k(int64_t(ref >> 1));
 
+            if (column.full_word()) {
+                if (StringIndex::is_last_key(upper_value, string_offset)) {
+                    result.push_back(k);
+                }
+                continue;
+            }
+
             // The buffer is needed when for when this is an integer index.
             StringConversionBuffer buffer;
             const StringData str = column.get_index_data(k, buffer);
@@ -553,6 +822,14 @@ void IndexArray::index_string_all_ins(StringData value, std::vector<ObjKey>& res
         // List of row indices with common prefix up to this point, in sorted order.
         if (!sub_isindex) {
             const IntegerColumn sub(m_alloc, ref_type(ref));
+            if (column.full_word()) {
+                if (StringIndex::is_last_key(upper_value, string_offset)) {
+                    for (IntegerColumn::const_iterator it = sub.cbegin(); it != sub.cend(); ++it) {
+                        result.push_back(ObjKey(*it));
+                    }
+                }
+                continue;
+            }
             from_list_all_ins(upper_value, result, sub, column);
             continue;
         }
@@ -613,6 +890,13 @@ void IndexArray::index_string_all(StringData value, std::vector<ObjKey>& result,
         if (ref & 1) {
             ObjKey k(int64_t(ref >> 1));
 
+            if (column.full_word()) {
+                if (StringIndex::is_last_key(value, stringoffset)) {
+                    result.push_back(k);
+                }
+                return;
+            }
+
             // The buffer is needed when for when this is an integer index.
             StringConversionBuffer buffer;
             StringData str = column.get_index_data(k, buffer);
@@ -629,6 +913,15 @@ void IndexArray::index_string_all(StringData value, std::vector<ObjKey>& result,
         // List of row indices with common prefix up to this point, in sorted order.
         if (!sub_isindex) {
             const IntegerColumn sub(m_alloc, ref_type(ref));
+            if (column.full_word()) {
+                if (StringIndex::is_last_key(value, stringoffset)) {
+                    result.reserve(result.size() + sub.size());
+                    for (IntegerColumn::const_iterator it = sub.cbegin(); it != sub.cend(); ++it) {
+                        result.push_back(ObjKey(*it));
+                    }
+                }
+                return;
+            }
             return from_list_all(value, result, sub, column);
         }
 
@@ -1038,8 +1331,7 @@ bool StringIndex::leaf_insert(ObjKey obj_key, key_type key, size_t offset, Strin
 
         // When key is outside current range, we can just add it
         keys.add(key);
-        int64_t shifted = int64_t((uint64_t(obj_key.value) << 1) + 1); // shift to indicate literal
-        m_array->add(shifted);
+        m_array->add(create_slot(obj_key, value, offset));
         return true;
     }
 
@@ -1052,12 +1344,13 @@ bool StringIndex::leaf_insert(ObjKey obj_key, key_type key, size_t offset, Strin
             return false;
 
         keys.insert(ins_pos, key);
-        int64_t shifted = int64_t((uint64_t(obj_key.value) << 1) + 1); // shift to indicate literal
-        m_array->insert(ins_pos_refs, shifted);
+        m_array->insert(ins_pos_refs, create_slot(obj_key, value, offset));
         return true;
     }
 
     // This leaf already has a slot for for the key
+    if (m_target_column.full_word())
+        return leaf_insert_full_word(obj_key, value, offset, ins_pos_refs);
 
     uint64_t slot_value = uint64_t(m_array->get(ins_pos_refs));
     size_t suboffset = offset + s_index_key_length;
@@ -1176,6 +1469,59 @@ bool StringIndex::leaf_insert(ObjKey obj_key, key_type key, size_t offset, Strin
     return true;
 }
 
+int64_t StringIndex::create_slot(ObjKey obj_key, StringData value, size_t offset)
+{
+    if (m_target_column.full_word() && !is_last_key(value, offset)) {
+        // In full word mode the rest of the value must be represented in a subindex
+        StringIndex subindex(m_target_column, m_array->get_alloc());
+        subindex.insert_with_offset(obj_key, value, offset + s_index_key_length);
+        return int64_t(subindex.get_ref());
+    }
+    return int64_t((uint64_t(obj_key.value) << 1) + 1); // shift to indicate literal
+}
+
+bool StringIndex::leaf_insert_full_word(ObjKey obj_key, StringData value, size_t offset, size_t ins_pos_refs)
+{
+    Allocator& alloc = m_array->get_alloc();
+    uint64_t slot_value = uint64_t(m_array->get(ins_pos_refs));
+    size_t suboffset = offset + s_index_key_length;
+
+    if ((slot_value & 1) == 0 && Array::get_context_flag_from_header(alloc.translate(ref_type(slot_value)))) {
+        // Values continue past this key, so go down a level in the tree.
+        StringIndex subindex(ref_type(slot_value), m_array.get(), ins_pos_refs, m_target_column, alloc);
+        subindex.insert_with_offset(obj_key, value, suboffset);
+        return true;
+    }
+
+    // The slot holds the entries of the value ending at this key
+    if (!is_last_key(value, offset)) {
+        // The new value continues past this key. Move the existing entries into a subindex
+        // where they will be found under key 0 (the key of any value shorter than the offset).
+        StringIndex subindex(m_target_column, alloc);
+        subindex.insert_row_list(size_t(slot_value), suboffset, StringData());
+        subindex.insert_with_offset(obj_key, value, suboffset);
+        m_array->set(ins_pos_refs, subindex.get_ref());
+        return true;
+    }
+
+    if ((slot_value & 1) != 0) {
+        // convert to list (in sorted order)
+        ObjKey obj_key2 = ObjKey(int64_t(slot_value >> 1));
+        Array row_list(alloc);
+        row_list.create(Array::type_Normal); // Throws
+        row_list.add(obj_key < obj_key2 ? obj_key.value : obj_key2.value);
+        row_list.add(obj_key < obj_key2 ? obj_key2.value : obj_key.value);
+        m_array->set(ins_pos_refs, row_list.get_ref());
+        return true;
+    }
+
+    IntegerColumn sub(alloc, ref_type(slot_value)); // Throws
+    sub.set_parent(m_array.get(), ins_pos_refs);
+    IntegerColumn::const_iterator upper = std::upper_bound(sub.cbegin(), sub.cend(), obj_key.value);
+    sub.insert(upper.get_position(), obj_key.value);
+    return true;
+}
+
 StringData StringIndex::get(ObjKey key, StringConversionBuffer& buffer) const
 {
     return m_target_column.get_index_data(key, buffer);
@@ -1268,10 +1614,175 @@ void StringIndex::do_delete(ObjKey obj_key, StringData value, size_t offset)
 
 void StringIndex::erase(ObjKey key)
 {
+    if (m_target_column.is_list()) {
+        m_target_column.for_each_list_index_data(key, [&](StringData value) {
+            erase_with_value(key, value);
+        });
+        return;
+    }
+
     StringConversionBuffer buffer;
     StringData value = get(key, buffer);
+    erase_with_value(key, value);
+}
+
+void StringIndex::erase(const std::vector<ObjKey>& keys)
+{
+    if (m_target_column.is_list()) {
+        for (auto key : keys)
+            erase(key);
+        return;
+    }
 
-    do_delete(key, value, 0);
+    // Read the values of the objects from their leaves instead of looking up
+    // each object from the root of the cluster tree
+    const ClusterTree* tree = m_target_column.get_cluster_tree();
+    ConstTableRef table = tree->get_table_ref();
+    Cluster leaf(0, tree->get_alloc(), *tree);
+    ClusterNode::IteratorState state(leaf);
+    StringConversionBuffer buffer;
+    size_t i = 0;
+    while (i < keys.size()) {
+        REALM_ASSERT_DEBUG(i == 0 || keys[i - 1] < keys[i]);
+        tree->get_leaf(keys[i], state);
+        int64_t last_key_value = state.m_key_offset + leaf.get_last_key_value();
+        for (; i < keys.size() && keys[i].value <= last_key_value; i++) {
+            size_t ndx = leaf.get_ndx(ObjKey(keys[i].value - state.m_key_offset), 0);
+            ConstObj obj(table, leaf.get_mem(), keys[i], ndx);
+            erase_with_value(keys[i], m_target_column.get_index_data(obj, buffer));
+        }
+    }
+}
+
+void StringIndex::insert_list(ObjKey key)
+{
+    REALM_ASSERT_DEBUG(m_target_column.is_list());
+    m_target_column.for_each_list_index_data(key, [&](StringData value) {
+        insert_value(key, value); // Throws
+    });
+}
+
+void StringIndex::insert_value(ObjKey key, StringData value)
+{
+    std::string folded;
+    value = index_value(value, folded);
+    if (get_index_type() == IndexType::NGram) {
+        for (StringData ngram : get_ngrams(value)) {
+            insert_with_offset(key, ngram, 0); // Throws
+        }
+        return;
+    }
+    if (get_index_type() == IndexType::Fulltext) {
+        for (StringData token : get_tokens(value)) {
+            insert_with_offset(key, token, 0); // Throws
+        }
+        return;
+    }
+
+    size_t offset = 0;                      // First key from beginning of string
+    insert_with_offset(key, value, offset); // Throws
+}
+
+bool StringIndex::find_ngram_candidates(const std::vector<StringData>& substrings, std::vector<ObjKey>& result) const
+{
+    REALM_ASSERT(get_index_type() == IndexType::NGram);
+
+    bool restricted = false;
+    std::vector<ObjKey> matches;
+    std::vector<ObjKey> intersection;
+    for (StringData substring : substrings) {
+        std::string folded;
+        for (StringData ngram : get_ngrams(index_value(substring, folded))) {
+            matches.clear();
+            m_array->index_string_find_all(matches, ngram, m_target_column);
+            // In full word mode the objects of a value are found in a single sorted list
+            REALM_ASSERT_DEBUG(std::is_sorted(matches.begin(), matches.end()));
+            if (!restricted) {
+                result = std::move(matches);
+                restricted = true;
+            }
+            else {
+                intersection.clear();
+                std::set_intersection(result.begin(), result.end(), matches.begin(), matches.end(),
+                                      std::back_inserter(intersection));
+                result.swap(intersection);
+            }
+            if (result.empty())
+                return true;
+        }
+    }
+    return restricted;
+}
+
+void StringIndex::find_all_fulltext(StringData text, std::vector<ObjKey>& result) const
+{
+    REALM_ASSERT(get_index_type() == IndexType::Fulltext);
+
+    // Group the terms separated by OR. Adjacent groups must all match.
+    std::vector<std::vector<StringData>> groups;
+    bool join = false;
+    for (StringData word : get_words(text)) {
+        if (word == "OR") {
+            join = !groups.empty();
+            continue;
+        }
+        if (join)
+            groups.back().push_back(word);
+        else
+            groups.push_back({word});
+        join = false;
+    }
+
+    result.clear();
+    bool first = true;
+    std::vector<ObjKey> matches;
+    std::vector<ObjKey> group_result;
+    std::vector<ObjKey> merged;
+    for (auto& group : groups) {
+        group_result.clear();
+        for (StringData term : group) {
+            std::string folded;
+            matches.clear();
+            m_array->index_string_find_all(matches, index_value(term, folded), m_target_column);
+            // In full word mode the objects of a value are found in a single sorted list
+            REALM_ASSERT_DEBUG(std::is_sorted(matches.begin(), matches.end()));
+            merged.clear();
+            std::set_union(group_result.begin(), group_result.end(), matches.begin(), matches.end(),
+                           std::back_inserter(merged));
+            group_result.swap(merged);
+        }
+        if (first) {
+            result.swap(group_result);
+            first = false;
+        }
+        else {
+            merged.clear();
+            std::set_intersection(result.begin(), result.end(), group_result.begin(), group_result.end(),
+                                  std::back_inserter(merged));
+            result.swap(merged);
+        }
+        if (result.empty())
+            return;
+    }
+}
+
+void StringIndex::erase_with_value(ObjKey key, StringData value)
+{
+    std::string folded;
+    value = index_value(value, folded);
+    if (get_index_type() == IndexType::NGram) {
+        for (StringData ngram : get_ngrams(value)) {
+            do_delete(key, ngram, 0);
+        }
+    }
+    else if (get_index_type() == IndexType::Fulltext) {
+        for (StringData token : get_tokens(value)) {
+            do_delete(key, token, 0);
+        }
+    }
+    else {
+        do_delete(key, value, 0);
+    }
 
     // Collapse top nodes with single item
     while (m_array->is_inner_bptree_node()) {
@@ -1325,6 +1836,12 @@ bool has_duplicate_values(const Array& node, const ClusterColumn& target_col) no
 
         // Child is root of B+-tree of row indexes
         IntegerColumn sub(alloc, ref);
+        if (target_col.full_word()) {
+            // All entries refer to the same value
+            if (sub.size() > 1)
+                return true;
+            continue;
+        }
         if (sub.size() > 1) {
             ObjKey first_key = ObjKey(sub.get(0));
             ObjKey last_key = ObjKey(sub.back());
@@ -1466,7 +1983,7 @@ void StringIndex::verify() const
                     StringIndex ndx(to_ref(ref), m_array.get(), i, m_target_column, alloc);
                     ndx.verify();
                 }
-                else {
+                else if (!m_target_column.full_word()) {
                     IntegerColumn sub(alloc, to_ref(ref)); // Throws
                     IntegerColumn::const_iterator it = sub.cbegin();
                     IntegerColumn::const_iterator it_end = sub.cend();
@@ -19,12 +19,15 @@
 #ifndef REALM_INDEX_STRING_HPP
 #define REALM_INDEX_STRING_HPP
 
+#include <cmath>
 #include <cstring>
 #include <memory>
 #include <array>
 
 #include <realm/array.hpp>
 #include <realm/cluster_tree.hpp>
+#include <realm/decimal128.hpp>
+#include <realm/unicode.hpp>
 
 /*
 The StringIndex class is used for both type_String and all integral types, such as type_Bool, type_Timestamp and
@@ -60,6 +63,21 @@ the same Column, but Columns may contain more than just duplicates if the depth
 long strings that have a long common prefix but differ in the last couple bytes. If a Column stores more than just
 duplicates, then the list is kept sorted in ascending order by string value and within the groups of common
 strings, the rows are sorted in ascending order.
+
+An index on a list column works in "full word" mode. An object can be present under several values, so the index
+cannot consult the column to find out which value an entry belongs to. Instead each value is stored in full in the
+tree: A value that continues past the current 4 byte key is always moved into a subindex, and literal rows and lists
+are only placed under the key which ends the value (the one with the terminating 'X'). Such a list stores all
+occurrences of that value, so an object key is repeated if its list contains the value more than once. If a value
+ends at a key which another value continues past, the ending entries are moved into the subindex under key 0.
+Null is stored under key 0 at the top level. Every other value ends at a key holding the terminating 'X', so null
+only shares its key with values starting with four zero bytes, and those always continue into a subindex.
+
+A case insensitive index also works in full word mode, since the case folded strings it stores cannot be compared
+with the values found in the column. So does an n-gram index, which stores an object under each distinct n-gram
+(substring of s_ngram_length bytes) of its case folded value. Values shorter than that are not stored at all.
+Likewise a full-text index stores an object under each distinct word of its case folded value. A word is a maximal
+run of ASCII letters and digits and non-ASCII characters.
 */
 
 namespace realm {
@@ -105,8 +123,8 @@ private:
     void index_string_all_ins(StringData value, std::vector<ObjKey>& result, const ClusterColumn& column) const;
 };
 
-// 12 is the biggest element size of any non-string/binary Realm type
-constexpr size_t string_conversion_buffer_size = 12;
+// 16 is the biggest element size of any non-string/binary Realm type (Decimal128)
+constexpr size_t string_conversion_buffer_size = 16;
 using StringConversionBuffer = std::array<char, string_conversion_buffer_size>;
 
 // The purpose of this class is to get easy access to fields in a specific column in the
@@ -114,9 +132,10 @@ using StringConversionBuffer = std::array<char, string_conversion_buffer_size>;
 // field based on the key for the object.
 class ClusterColumn {
 public:
-    ClusterColumn(const ClusterTree* cluster_tree, ColKey column_key)
+    ClusterColumn(const ClusterTree* cluster_tree, ColKey column_key, IndexType index_type = IndexType::General)
         : m_cluster_tree(cluster_tree)
         , m_column_key(column_key)
+        , m_index_type(index_type)
     {
     }
     size_t size() const
@@ -139,12 +158,33 @@ public:
     {
         return m_column_key;
     }
+    const ClusterTree* get_cluster_tree() const
+    {
+        return m_cluster_tree;
+    }
     bool is_nullable() const;
+    bool is_list() const
+    {
+        return m_column_key && m_column_key.get_attrs().test(col_attr_List);
+    }
+    IndexType get_index_type() const
+    {
+        return m_index_type;
+    }
+    // If true, the index stores complete values and never looks them up in the column
+    bool full_word() const
+    {
+        return is_list() || m_index_type != IndexType::General;
+    }
     StringData get_index_data(ObjKey key, StringConversionBuffer& buffer) const;
+    StringData get_index_data(const ConstObj& obj, StringConversionBuffer& buffer) const;
+    // Calls 'func' with the index data of every element in the list stored for 'key'
+    void for_each_list_index_data(ObjKey key, util::FunctionRef<void(StringData)> func) const;
 
 private:
     const ClusterTree* m_cluster_tree;
     ColKey m_column_key;
+    IndexType m_index_type;
 };
 
 class StringIndex {
@@ -159,11 +199,15 @@ public:
     {
         return m_target_column.get_column_key();
     }
+    IndexType get_index_type() const
+    {
+        return m_target_column.get_index_type();
+    }
 
     static bool type_supported(realm::DataType type)
     {
         return (type == type_Int || type == type_String || type == type_Bool || type == type_Timestamp ||
-                type == type_ObjectId);
+                type == type_ObjectId || type == type_Float || type == type_Double || type == type_Decimal);
     }
 
     static ref_type create_empty(Allocator& alloc);
@@ -197,6 +241,26 @@ public:
     void set(ObjKey key, util::Optional<T> new_value);
 
     void erase(ObjKey key);
+    // Erase the entries of the objects with the given keys, which must be
+    // ascending. Not to be used while the cluster tree is being modified.
+    void erase(const std::vector<ObjKey>& keys);
+    // Erase a single entry for 'key'. Used for list columns where the object is
+    // present under each of the values in its list.
+    template <class T>
+    void erase(ObjKey key, T value);
+
+    // Insert entries for all the values in the list stored for 'key'
+    void insert_list(ObjKey key);
+
+    // Only for an n-gram index. Finds the objects whose value may contain all of 'substrings', ignoring case.
+    // The result is sorted and must be verified against the actual values. Returns false if none of the
+    // substrings are long enough to be looked up, in which case the index cannot restrict the search.
+    bool find_ngram_candidates(const std::vector<StringData>& substrings, std::vector<ObjKey>& result) const;
+
+    // Only for a full-text index. Finds the objects whose value contains all the words of 'text', ignoring case.
+    // Words separated by OR are alternatives, so "red OR green apple" requires "apple" and one of "red" and
+    // "green". A text without any words matches nothing. The result is sorted and exact.
+    void find_all_fulltext(StringData text, std::vector<ObjKey>& result) const;
 
     template <class T>
     ObjKey find_first(T value) const;
@@ -231,8 +295,14 @@ public:
     // binary search of approximate complexity log2(n) from `std::lower_bound`.
     static const size_t s_max_offset = 200; // max depth * s_index_key_length
     static const size_t s_index_key_length = 4;
+    static const size_t s_ngram_length = 3;
     static key_type create_key(StringData) noexcept;
     static key_type create_key(StringData, size_t) noexcept;
+    // True if the key created for 'value' at 'offset' is the last one needed to represent the value
+    static bool is_last_key(StringData value, size_t offset) noexcept
+    {
+        return value.is_null() || value.size() < offset + s_index_key_length;
+    }
 
 private:
     // m_array is a compact representation for storing the children of this StringIndex.
@@ -263,7 +333,14 @@ private:
 
     static IndexArray* create_node(Allocator&, bool is_leaf);
 
+    // Returns the value as it is stored in the index. For a case insensitive index this is
+    // the case folded string, which is placed in 'buffer'.
+    StringData index_value(StringData value, std::string& buffer) const;
+    void insert_value(ObjKey key, StringData value);
     void insert_with_offset(ObjKey key, StringData value, size_t offset);
+    int64_t create_slot(ObjKey key, StringData value, size_t offset);
+    bool leaf_insert_full_word(ObjKey key, StringData value, size_t offset, size_t ins_pos_refs);
+    void erase_with_value(ObjKey key, StringData value);
     void insert_row_list(size_t ref, size_t offset, StringData value);
     void insert_to_existing_list(ObjKey key, StringData value, IntegerColumn& list);
     void insert_to_existing_list_at_lower(ObjKey key, StringData value, IntegerColumn& list,
@@ -397,10 +474,58 @@ struct GetIndexData<ObjectId> {
     }
 };
 
+// Floating point values which compare equal are given the same key: -0.0 is stored as 0.0, and
+// all NaNs are stored alike. The null value of a nullable column is stored as null.
+template <>
+struct GetIndexData<float> {
+    static StringData get_index_data(float value, StringConversionBuffer& buffer);
+};
+
+template <>
+struct GetIndexData<double> {
+    static StringData get_index_data(double value, StringConversionBuffer& buffer);
+};
+
+// Decimals are stored with the trailing zeros of the coefficient removed, so that 1.0 and 1.00 get
+// the same key.
+template <>
+struct GetIndexData<Decimal128> {
+    static StringData get_index_data(const Decimal128& value, StringConversionBuffer& buffer);
+};
+
 template <>
 struct GetIndexData<const char*> : GetIndexData<StringData> {
 };
 
+// A NaN never compares equal to anything, so looking it up in the index finds nothing, even though
+// objects holding a NaN are present in the index.
+template <class T>
+inline bool is_nan_value(const T&) noexcept
+{
+    return false;
+}
+
+inline bool is_nan_value(float value) noexcept
+{
+    return std::isnan(value) && !null::is_null_float(value);
+}
+
+inline bool is_nan_value(double value) noexcept
+{
+    return std::isnan(value) && !null::is_null_float(value);
+}
+
+inline bool is_nan_value(const Decimal128& value) noexcept
+{
+    return value.is_nan() && !value.is_null();
+}
+
+template <class T>
+inline bool is_nan_value(const util::Optional<T>& value) noexcept
+{
+    return value && is_nan_value(*value);
+}
+
 // to_str() is used by the integer index. The existing StringIndex is re-used for this
 // by making IntegerColumn convert its integers to strings by calling to_str().
 
@@ -491,12 +616,21 @@ inline StringIndex::key_type StringIndex::create_key(StringData str, size_t offs
     return create_key(str.substr(offset));
 }
 
+inline StringData StringIndex::index_value(StringData value, std::string& buffer) const
+{
+    if (REALM_LIKELY(m_target_column.get_index_type() == IndexType::General) || value.is_null())
+        return value;
+    buffer = case_map(value, false, IgnoreErrors);
+    if (buffer.size() != value.size()) // Invalid UTF-8 is indexed as it is
+        return value;
+    return buffer;
+}
+
 template <class T>
 void StringIndex::insert(ObjKey key, T value)
 {
     StringConversionBuffer buffer;
-    size_t offset = 0;                                      // First key from beginning of string
-    insert_with_offset(key, to_str(value, buffer), offset); // Throws
+    insert_value(key, to_str(value, buffer)); // Throws
 }
 
 template <class T>
@@ -515,18 +649,19 @@ void StringIndex::set(ObjKey key, T new_value)
 {
     StringConversionBuffer buffer;
     StringConversionBuffer buffer2;
+    std::string folded;
+    std::string folded2;
     StringData old_value = get(key, buffer);
     StringData new_value2 = to_str(new_value, buffer2);
 
-    // Note that insert_with_offset() throws UniqueConstraintViolation.
+    // Note that insert_value() throws UniqueConstraintViolation.
 
-    if (REALM_LIKELY(new_value2 != old_value)) {
+    if (REALM_LIKELY(index_value(new_value2, folded2) != index_value(old_value, folded))) {
         // We must erase this row first because erase uses find_first which
         // might find the duplicate if we insert before erasing.
         erase(key); // Throws
 
-        size_t offset = 0;                               // First key from beginning of string
-        insert_with_offset(key, new_value2, offset);     // Throws
+        insert_value(key, new_value2); // Throws
     }
 }
 
@@ -541,36 +676,64 @@ void StringIndex::set(ObjKey key, util::Optional<T> new_value)
     }
 }
 
+template <class T>
+void StringIndex::erase(ObjKey key, T value)
+{
+    StringConversionBuffer buffer;
+    erase_with_value(key, to_str(value, buffer));
+}
+
 template <class T>
 ObjKey StringIndex::find_first(T value) const
 {
+    if (is_nan_value(value))
+        return {};
+
     // Use direct access method
     StringConversionBuffer buffer;
-    return m_array->index_string_find_first(to_str(value, buffer), m_target_column);
+    std::string folded;
+    return m_array->index_string_find_first(index_value(to_str(value, buffer), folded), m_target_column);
 }
 
 template <class T>
 void StringIndex::find_all(std::vector<ObjKey>& result, T value, bool case_insensitive) const
 {
+    if (is_nan_value(value))
+        return;
+
     // Use direct access method
     StringConversionBuffer buffer;
+    if (get_index_type() == IndexType::CaseInsensitive) {
+        // All the case variants are stored under the same key
+        std::string folded;
+        return m_array->index_string_find_all(result, index_value(to_str(value, buffer), folded), m_target_column);
+    }
     return m_array->index_string_find_all(result, to_str(value, buffer), m_target_column, case_insensitive);
 }
 
 template <class T>
 FindRes StringIndex::find_all_no_copy(T value, InternalFindResult& result) const
 {
+    if (is_nan_value(value))
+        return FindRes_not_found;
+
     // Use direct access method
     StringConversionBuffer buffer;
-    return m_array->index_string_find_all_no_copy(to_str(value, buffer), m_target_column, result);
+    std::string folded;
+    return m_array->index_string_find_all_no_copy(index_value(to_str(value, buffer), folded), m_target_column,
+                                                  result);
 }
 
 template <class T>
 size_t StringIndex::count(T value) const
 {
+    if (is_nan_value(value))
+        return 0;
+
     // Use direct access method
     StringConversionBuffer buffer;
-    return m_array->index_string_count(to_str(value, buffer), m_target_column);
+    std::string folded;
+    return m_array->index_string_count(index_value(to_str(value, buffer), folded), m_target_column);
 }
 
 template <class T>
@@ -33,6 +33,7 @@
 #include "realm/table_view.hpp"
 #include "realm/group.hpp"
 #include "realm/replication.hpp"
+#include "realm/index_string.hpp"
 
 namespace realm {
 
@@ -233,6 +234,48 @@ Lst<T>::Lst(const Obj& obj, ColKey col_key)
     }
 }
 
+template <class T>
+void Lst<T>::do_set(size_t ndx, T value)
+{
+    if (StringIndex* index = m_obj.get_table()->get_search_index(ConstLstBase::m_col_key)) {
+        ObjKey key = m_obj.get_key();
+        index->erase(key, m_tree->get(ndx));
+        index->insert(key, value);
+    }
+    m_tree->set(ndx, value);
+}
+
+template <class T>
+void Lst<T>::do_insert(size_t ndx, T value)
+{
+    if (StringIndex* index = m_obj.get_table()->get_search_index(ConstLstBase::m_col_key)) {
+        index->insert(m_obj.get_key(), value);
+    }
+    m_tree->insert(ndx, value);
+}
+
+template <class T>
+void Lst<T>::do_remove(size_t ndx)
+{
+    if (StringIndex* index = m_obj.get_table()->get_search_index(ConstLstBase::m_col_key)) {
+        index->erase(m_obj.get_key(), m_tree->get(ndx));
+    }
+    m_tree->erase(ndx);
+}
+
+template <class T>
+void Lst<T>::do_clear()
+{
+    if (StringIndex* index = m_obj.get_table()->get_search_index(ConstLstBase::m_col_key)) {
+        ObjKey key = m_obj.get_key();
+        size_t sz = m_tree->size();
+        for (size_t ndx = 0; ndx < sz; ndx++) {
+            index->erase(key, m_tree->get(ndx));
+        }
+    }
+    m_tree->clear();
+}
+
 /****************************** Lst aggregates *******************************/
 
 // This will be defined when using C++17
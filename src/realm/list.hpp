@@ -680,7 +680,7 @@ public:
             if (Replication* repl = this->m_const_obj->get_replication()) {
                 ConstLstBase::clear_repl(repl);
             }
-            m_tree->clear();
+            do_clear();
             m_obj.bump_content_version();
         }
     }
@@ -706,18 +706,11 @@ protected:
             init_from_parent();
         }
     }
-    void do_set(size_t ndx, T value)
-    {
-        m_tree->set(ndx, value);
-    }
-    void do_insert(size_t ndx, T value)
-    {
-        m_tree->insert(ndx, value);
-    }
-    void do_remove(size_t ndx)
-    {
-        m_tree->erase(ndx);
-    }
+    // These will also update the search index if the column has one
+    void do_set(size_t ndx, T value);
+    void do_insert(size_t ndx, T value);
+    void do_remove(size_t ndx);
+    void do_clear();
     void set_repl(Replication* repl, size_t ndx, T value);
     void insert_repl(Replication* repl, size_t ndx, T value);
 };
@@ -210,6 +210,7 @@ protected:
     friend class ConstLnkLst;
     friend class LnkLst;
     friend class LinkMap;
+    friend class LinksToNode;
     friend class ConstTableView;
     friend class Transaction;
     friend struct ClusterNode::IteratorState;
@@ -328,6 +329,7 @@ private:
     friend class ArrayBacklink;
     friend class CascadeState;
     friend class Cluster;
+    friend class ClusterTree;
     friend class ConstLstBase;
     friend class ConstObj;
     template <class>
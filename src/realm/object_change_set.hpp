@@ -0,0 +1,207 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_OBJECT_CHANGE_SET_HPP
+#define REALM_OBJECT_CHANGE_SET_HPP
+
+#include <realm/group.hpp>
+#include <realm/impl/transact_log.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace realm {
+
+/// Collects the keys of the objects created, modified or removed in each table
+/// by the transactions seen when advancing a read transaction. It is used as the
+/// observer given to Transaction::advance_read(), and can then be passed to
+/// ConstTableView::sync_if_needed() so that only the changed objects are
+/// reevaluated:
+///
+///     ObjectChangeSet changes;
+///     tr->advance_read(&changes);
+///     view.sync_if_needed(changes);
+///
+/// Changes accumulate over several calls to advance_read() until clear() is
+/// called. The change set also records the content version of each changed
+/// table before and after the changes, so that a view is only updated from
+/// changes starting at the version it was last synchronized at.
+class ObjectChangeSet : public _impl::NullInstructionObserver {
+public:
+    /// Returns false if the table has been changed in ways that are not described
+    /// by its changed objects, e.g. if columns have been added or removed.
+    bool has_object_changes_only(TableKey table_key) const
+    {
+        auto it = m_tables.find(table_key);
+        return it == m_tables.end() || !it->second.schema_changed;
+    }
+
+    /// Returns true if the changes describe exactly how the table went from
+    /// \a from_version to \a to_version, as returned by
+    /// Table::get_content_version().
+    bool covers_versions(TableKey table_key, uint_fast64_t from_version, uint_fast64_t to_version) const
+    {
+        auto it = m_tables.find(table_key);
+        if (it == m_tables.end() || !it->second.has_versions)
+            return false;
+        return it->second.from_version == from_version && it->second.to_version == to_version;
+    }
+
+    /// The keys of the objects created, modified or removed in the table, in
+    /// ascending order.
+    const std::vector<ObjKey>& get_changed_objects(TableKey table_key) const
+    {
+        static const std::vector<ObjKey> no_changes;
+        auto it = m_tables.find(table_key);
+        return it == m_tables.end() ? no_changes : it->second.keys;
+    }
+
+    bool empty() const
+    {
+        return m_tables.empty();
+    }
+
+    void clear()
+    {
+        m_tables.clear();
+        m_selected = nullptr;
+    }
+
+    // Called by Transaction::advance_read() before and after the accessors of
+    // the group are advanced past the parsed changes.
+    void advance_begin(const Group& group)
+    {
+        for (auto& entry : m_tables) {
+            auto& changes = entry.second;
+            if (!has_table(group, entry.first)) {
+                // Created by the changes, so no earlier version can be covered
+                changes.versions_broken = true;
+                continue;
+            }
+            uint_fast64_t version = group.get_table(entry.first)->get_content_version();
+            if (!changes.has_versions && !changes.versions_broken) {
+                changes.from_version = version;
+            }
+            else if (changes.to_version != version) {
+                // The table has changed since the previous advance in ways not recorded here
+                changes.versions_broken = true;
+            }
+        }
+    }
+    void advance_end(const Group& group)
+    {
+        for (auto& entry : m_tables) {
+            auto& changes = entry.second;
+            changes.has_versions = has_table(group, entry.first) && !changes.versions_broken;
+            if (changes.has_versions)
+                changes.to_version = group.get_table(entry.first)->get_content_version();
+        }
+    }
+
+    // The following methods are those that TransactLogParser expects to find
+    // on the `InstructionHandler`.
+    bool select_table(TableKey table_key)
+    {
+        m_selected = &m_tables[table_key];
+        return true;
+    }
+    bool erase_group_level_table(TableKey table_key)
+    {
+        m_tables[table_key].schema_changed = true;
+        return true;
+    }
+
+    bool create_object(ObjKey key)
+    {
+        return add(key);
+    }
+    bool remove_object(ObjKey key)
+    {
+        return add(key);
+    }
+    bool modify_object(ColKey, ObjKey key)
+    {
+        return add(key);
+    }
+    // Any change to a list is a change to the object owning it
+    bool select_list(ColKey, ObjKey key)
+    {
+        return add(key);
+    }
+
+    bool insert_column(ColKey)
+    {
+        return schema_changed();
+    }
+    bool erase_column(ColKey)
+    {
+        return schema_changed();
+    }
+    bool set_link_type(ColKey)
+    {
+        return schema_changed();
+    }
+
+    void parse_complete()
+    {
+        for (auto& entry : m_tables) {
+            auto& keys = entry.second.keys;
+            std::sort(keys.begin(), keys.end());
+            keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        }
+        m_selected = nullptr;
+    }
+
+private:
+    struct TableChanges {
+        std::vector<ObjKey> keys;
+        bool schema_changed = false;
+        bool has_versions = false;
+        bool versions_broken = false;
+        uint_fast64_t from_version = 0;
+        uint_fast64_t to_version = 0;
+    };
+    std::map<TableKey, TableChanges> m_tables;
+    TableChanges* m_selected = nullptr;
+
+    bool add(ObjKey key)
+    {
+        REALM_ASSERT(m_selected);
+        m_selected->keys.push_back(key);
+        return true;
+    }
+    static bool has_table(const Group& group, TableKey table_key)
+    {
+        for (auto key : group.get_table_keys()) {
+            if (key == table_key)
+                return true;
+        }
+        return false;
+    }
+    bool schema_changed()
+    {
+        REALM_ASSERT(m_selected);
+        m_selected->schema_changed = true;
+        return true;
+    }
+};
+
+} // namespace realm
+
+#endif // REALM_OBJECT_CHANGE_SET_HPP
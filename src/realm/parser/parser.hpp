@@ -100,7 +100,8 @@ struct Predicate
         EndsWith,
         Contains,
         Like,
-        In
+        In,
+        TextMatch
     };
 
     enum class OperatorOption
@@ -28,6 +28,8 @@
 #include <realm/column_type.hpp>
 #include <realm/utilities.hpp>
 
+#include <functional>
+#include <limits>
 #include <sstream>
 
 using namespace realm;
@@ -186,6 +188,8 @@ const char* operator_description(const Predicate::Operator& op)
             return "LIKE";
         case realm::parser::Predicate::Operator::In:
             return "IN";
+        case realm::parser::Predicate::Operator::TextMatch:
+            return "TEXT";
     }
     REALM_ASSERT_DEBUG(false);
     return "";
@@ -698,6 +702,21 @@ Query make_comparison_query(Query& query, const Predicate& pred, Arguments& args
     ExpressionContainer lhs(query, cmpr.expr[0], args, mapping);
     ExpressionContainer rhs(query, cmpr.expr[1], args, mapping);
 
+    if (cmpr.op == Predicate::Operator::TextMatch) {
+        // Full-text matching is answered by the index of a string column on the queried table itself
+        if (lhs.type != ExpressionContainer::ExpressionInternal::exp_Property ||
+            rhs.type != ExpressionContainer::ExpressionInternal::exp_Value ||
+            lhs.get_property().link_chain.size() != 1 || lhs.get_property().get_dest_type() != type_String) {
+            throw_logic_error("TEXT requires a string property on the left and a string constant on the right.");
+        }
+        if (cmpr.option == Predicate::OperatorOption::CaseInsensitive) {
+            // The full-text index stores case folded words, so matching is always case insensitive
+            throw_logic_error("TEXT is always case insensitive and does not take the '[c]' modifier.");
+        }
+        return query.get_table()->where().text_match(lhs.get_property().get_dest_col_key(),
+                                                      rhs.get_value().value_of_type_for_query<StringData>());
+    }
+
     preprocess_for_comparison_types(cmpr, lhs, rhs);
 
     if (lhs.is_null()) {
@@ -711,8 +730,11 @@ Query make_comparison_query(Query& query, const Predicate& pred, Arguments& args
     }
 }
 
+// Called with each comparison and the query built for it, before it is added to the result
+using ComparisonObserver = std::function<void(const Predicate::Comparison&, Query&)>;
+
 void update_query_with_predicate(Query& query, const Predicate& pred, Arguments& arguments,
-                                 parser::KeyPathMapping& mapping)
+                                 parser::KeyPathMapping& mapping, const ComparisonObserver& observer)
 {
     if (pred.negate) {
         query.Not();
@@ -722,7 +744,7 @@ void update_query_with_predicate(Query& query, const Predicate& pred, Arguments&
         case Predicate::Type::And:
             query.group();
             for (auto &sub : pred.cpnd.sub_predicates) {
-                update_query_with_predicate(query, sub, arguments, mapping);
+                update_query_with_predicate(query, sub, arguments, mapping, observer);
             }
             if (!pred.cpnd.sub_predicates.size()) {
                 query.and_query(std::unique_ptr<realm::Expression>(new TrueExpression));
@@ -734,7 +756,7 @@ void update_query_with_predicate(Query& query, const Predicate& pred, Arguments&
             query.group();
             for (auto &sub : pred.cpnd.sub_predicates) {
                 query.Or();
-                update_query_with_predicate(query, sub, arguments, mapping);
+                update_query_with_predicate(query, sub, arguments, mapping, observer);
             }
             if (!pred.cpnd.sub_predicates.size()) {
                 query.and_query(std::unique_ptr<realm::Expression>(new FalseExpression));
@@ -743,7 +765,10 @@ void update_query_with_predicate(Query& query, const Predicate& pred, Arguments&
             break;
 
         case Predicate::Type::Comparison: {
-            query.and_query(make_comparison_query(query, pred, arguments, mapping));
+            Query comparison = make_comparison_query(query, pred, arguments, mapping);
+            if (observer)
+                observer(pred.cmpr, comparison);
+            query.and_query(std::move(comparison));
             break;
         }
         case Predicate::Type::True:
@@ -758,11 +783,162 @@ void update_query_with_predicate(Query& query, const Predicate& pred, Arguments&
             throw_logic_error("Invalid predicate type");
     }
 }
+
+bool uses_arguments(const parser::Expression& expr);
+
+bool uses_arguments(const Predicate& pred)
+{
+    if (pred.type == Predicate::Type::Comparison)
+        return uses_arguments(pred.cmpr.expr[0]) || uses_arguments(pred.cmpr.expr[1]);
+    for (auto& sub : pred.cpnd.sub_predicates) {
+        if (uses_arguments(sub))
+            return true;
+    }
+    return false;
+}
+
+bool uses_arguments(const parser::Expression& expr)
+{
+    if (expr.type == parser::Expression::Type::Argument)
+        return true;
+    return expr.type == parser::Expression::Type::SubQuery && expr.subquery && uses_arguments(*expr.subquery);
+}
+
+// The value to bind to a node for an argument. Integer '>=' and '<=' conditions are built as '>' and '<'
+// conditions on the adjacent value, which is returned as null if it does not exist.
+Mixed argument_value(Arguments& arguments, size_t ndx, ColumnType type, int64_t offset)
+{
+    if (type == col_type_Int) {
+        int64_t value = arguments.long_for_argument(ndx);
+        if ((offset < 0 && value == std::numeric_limits<int64_t>::min()) ||
+            (offset > 0 && value == std::numeric_limits<int64_t>::max()))
+            return Mixed();
+        return Mixed(value + offset);
+    }
+
+    switch (type) {
+        case col_type_Bool:
+            return Mixed(arguments.bool_for_argument(ndx));
+        case col_type_Float:
+            return Mixed(arguments.float_for_argument(ndx));
+        case col_type_Double:
+            return Mixed(arguments.double_for_argument(ndx));
+        case col_type_String:
+            return Mixed(arguments.string_for_argument(ndx));
+        default:
+            return Mixed();
+    }
+}
 } // anonymous namespace
 
 namespace realm {
 namespace query_builder {
 
+PreparedQuery::PreparedQuery(const std::string& query_string, parser::KeyPathMapping mapping)
+    : m_parsed(std::make_unique<ParserResult>(parser::parse(query_string)))
+    , m_mapping(std::move(mapping))
+{
+}
+
+PreparedQuery::~PreparedQuery() {}
+
+const DescriptorOrderingState& PreparedQuery::get_ordering() const
+{
+    return m_parsed->ordering;
+}
+
+Query PreparedQuery::bind(ConstTableRef table, Arguments& arguments)
+{
+    m_was_rebound = false;
+    if (m_is_rebindable && table->get_key() == m_table_key) {
+        if (rebind(table, arguments)) {
+            m_was_rebound = true;
+            return m_query;
+        }
+        // A null argument changes the conditions built, so build a one-off query
+        Query query = table->where();
+        apply_predicate(query, m_parsed->predicate, arguments, m_mapping);
+        return query;
+    }
+
+    prepare(table, arguments);
+    return m_query;
+}
+
+bool PreparedQuery::rebind(ConstTableRef table, Arguments& arguments)
+{
+    for (auto& binding : m_bindings) {
+        if (arguments.is_argument_null(binding.argument))
+            return false;
+    }
+
+    // The built query may belong to an earlier transaction. Moving it to the table of this one
+    // checks that the columns of the conditions still exist.
+    m_table_key = TableKey();
+    m_query.set_table(table.cast_away_const());
+    m_table_key = table->get_key();
+
+    for (auto& binding : m_bindings) {
+        Mixed value = argument_value(arguments, binding.argument, binding.node->m_condition_column_key.get_type(),
+                                     binding.offset);
+        // Every binding is set again on the next call, so the query can be left half bound
+        if (!binding.node->rebind(value))
+            return false;
+    }
+    return true;
+}
+
+void PreparedQuery::prepare(ConstTableRef table, Arguments& arguments)
+{
+    m_query = table->where();
+    m_table_key = table->get_key();
+    m_bindings.clear();
+    m_is_rebindable = true;
+
+    auto observer = [&](const Predicate::Comparison& cmpr, Query& comparison) {
+        const parser::Expression* argument = nullptr;
+        int64_t offset = 0;
+        for (size_t i = 0; i < 2; ++i) {
+            const parser::Expression& expr = cmpr.expr[i];
+            const parser::Expression& other = cmpr.expr[1 - i];
+            if (expr.type == parser::Expression::Type::Argument && other.type == parser::Expression::Type::KeyPath) {
+                argument = &expr;
+                // 'prop >= $0' is built as 'prop > $0 - 1', and '$0 >= prop' as 'prop < $0 + 1'
+                if (cmpr.op == Predicate::Operator::GreaterThanOrEqual)
+                    offset = i == 1 ? -1 : 1;
+                else if (cmpr.op == Predicate::Operator::LessThanOrEqual)
+                    offset = i == 1 ? 1 : -1;
+            }
+        }
+        if (!argument) {
+            if (uses_arguments(cmpr.expr[0]) || uses_arguments(cmpr.expr[1]))
+                m_is_rebindable = false;
+            return;
+        }
+
+        // Only a single condition on a column of the table can take a new value
+        size_t ndx = string_to<int>(argument->s);
+        ParentNode* node = comparison.root_node();
+        if (!node || node->m_child || !node->m_condition_column_key || arguments.is_argument_null(ndx)) {
+            m_is_rebindable = false;
+            return;
+        }
+        Mixed value = argument_value(arguments, ndx, node->m_condition_column_key.get_type(), offset);
+        if (!node->rebind(value)) {
+            m_is_rebindable = false;
+            return;
+        }
+        m_bindings.push_back({node, ndx, offset});
+    };
+
+    if (m_parsed->predicate.type == Predicate::Type::True && !m_parsed->predicate.negate)
+        return;
+    update_query_with_predicate(m_query, m_parsed->predicate, arguments, m_mapping, observer);
+
+    std::string validateMessage = m_query.validate();
+    realm_precondition(validateMessage.empty(), validateMessage.c_str());
+}
+
 void apply_predicate(Query& query, const Predicate& predicate, Arguments& arguments, parser::KeyPathMapping mapping)
 {
 
@@ -771,7 +947,7 @@ void apply_predicate(Query& query, const Predicate& predicate, Arguments& argume
         return;
     }
 
-    update_query_with_predicate(query, predicate, arguments, mapping);
+    update_query_with_predicate(query, predicate, arguments, mapping, ComparisonObserver());
 
     // Test the constructed query in core
     std::string validateMessage = query.validate();
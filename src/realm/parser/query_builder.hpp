@@ -28,6 +28,7 @@
 #include <realm/parser/keypath_mapping.hpp>
 #include <realm/null.hpp>
 #include <realm/object_id.hpp>
+#include <realm/query.hpp>
 #include <realm/string_data.hpp>
 #include <realm/timestamp.hpp>
 #include <realm/table.hpp>
@@ -44,6 +45,7 @@ using RowExpr = BasicRowExpr<Table>;
 namespace parser {
     struct Predicate;
     struct DescriptorOrderingState;
+    struct ParserResult;
 }
 
 namespace query_builder {
@@ -155,6 +157,53 @@ private:
     }
 };
 
+/// A query string which is parsed once and then bound to different arguments
+/// any number of times. The query is built for a table on the first call to
+/// bind(); subsequent calls for the same table, also from other transactions,
+/// reuse the built query and only replace the values of the conditions which
+/// compare a property of the table against an argument. If the query has
+/// conditions on arguments which cannot be replaced this way, e.g. through
+/// links or against null, it is rebuilt from the parsed predicate instead.
+///
+/// A PreparedQuery is not thread safe.
+class PreparedQuery {
+public:
+    PreparedQuery(const std::string& query_string, parser::KeyPathMapping mapping = parser::KeyPathMapping());
+    ~PreparedQuery();
+
+    /// Returns a query on \a table with the arguments bound to their values.
+    Query bind(ConstTableRef table, Arguments& arguments);
+
+    /// The sort, distinct, limit and include clauses of the query string.
+    const parser::DescriptorOrderingState& get_ordering() const;
+
+    /// True if the last call to bind() reused the built query.
+    bool was_rebound() const
+    {
+        return m_was_rebound;
+    }
+
+private:
+    struct Binding {
+        ParentNode* node;
+        size_t argument;
+        // Integer '>=' and '<=' conditions are built as '>' and '<' on the adjacent value
+        int64_t offset;
+    };
+
+    std::unique_ptr<parser::ParserResult> m_parsed;
+    parser::KeyPathMapping m_mapping;
+    // The query built for the table, which is copied but never run
+    Query m_query;
+    TableKey m_table_key;
+    std::vector<Binding> m_bindings;
+    bool m_is_rebindable = false;
+    bool m_was_rebound = false;
+
+    bool rebind(ConstTableRef table, Arguments& arguments);
+    void prepare(ConstTableRef table, Arguments& arguments);
+};
+
 class NoArgsError : public std::runtime_error {
 public:
     NoArgsError()
@@ -0,0 +1,184 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/projection.hpp>
+
+using namespace realm;
+
+namespace {
+
+std::unique_ptr<ArrayPayload> create_leaf(ColKey col_key, Allocator& alloc)
+{
+    bool nullable = col_key.get_attrs().test(col_attr_Nullable);
+    // The nullable leaves of the other types share the layout of the
+    // non-nullable ones, so they can be used for either
+    switch (col_key.get_type()) {
+        case col_type_Int:
+            if (nullable)
+                return std::make_unique<ArrayIntNull>(alloc);
+            return std::make_unique<ArrayInteger>(alloc);
+        case col_type_Bool:
+            return std::make_unique<ArrayBoolNull>(alloc);
+        case col_type_Float:
+            return std::make_unique<ArrayFloatNull>(alloc);
+        case col_type_Double:
+            return std::make_unique<ArrayDoubleNull>(alloc);
+        case col_type_String:
+            return std::make_unique<ArrayString>(alloc);
+        case col_type_Binary:
+            return std::make_unique<ArrayBinary>(alloc);
+        case col_type_Timestamp:
+            return std::make_unique<ArrayTimestamp>(alloc);
+        case col_type_Decimal:
+            return std::make_unique<ArrayDecimal128>(alloc);
+        case col_type_ObjectId:
+            return std::make_unique<ArrayObjectIdNull>(alloc);
+        case col_type_Link:
+            return std::make_unique<ArrayKey>(alloc);
+        default:
+            break;
+    }
+    throw LogicError(LogicError::type_mismatch);
+}
+
+} // anonymous namespace
+
+Projection::Projection(ConstTableRef table, std::vector<ColKey> col_keys)
+    : m_table(table)
+    , m_col_keys(std::move(col_keys))
+    , m_leaf(0, table->get_alloc(), table->m_clusters)
+    , m_state(m_leaf)
+    , m_instance_version(table->m_clusters.get_instance_version())
+{
+    for (auto col_key : m_col_keys) {
+        m_table->check_column(col_key);
+        if (col_key.get_attrs().test(col_attr_List))
+            throw LogicError(LogicError::list_type_mismatch);
+        m_leaves.push_back(create_leaf(col_key, m_table->get_alloc()));
+    }
+}
+
+void Projection::set_key(ObjKey key)
+{
+    // Stay in the current leaf if it holds the object
+    if (m_key && m_storage_version == get_storage_version()) {
+        int64_t offset = m_leaf.get_offset();
+        int64_t relative = key.value - offset;
+        if (relative >= 0 && relative <= m_leaf.get_last_key_value()) {
+            size_t ndx = m_leaf.lower_bound_key(ObjKey(relative));
+            if (ndx < m_leaf.node_size() && m_leaf.get_real_key(ndx) == key) {
+                m_key = key;
+                m_row_ndx = ndx;
+                return;
+            }
+        }
+    }
+
+    if (!key || key.is_unresolved() || !load_leaf(key) || m_leaf.get_real_key(m_row_ndx) != key) {
+        m_key = ObjKey();
+        throw KeyNotFound("No such object");
+    }
+    m_key = key;
+}
+
+bool Projection::next()
+{
+    if (m_key && m_storage_version == get_storage_version()) {
+        if (m_row_ndx + 1 < m_leaf.node_size()) {
+            m_key = m_leaf.get_real_key(++m_row_ndx);
+            return true;
+        }
+    }
+
+    // Continue from the key after the current one, which also works if the
+    // current object has been removed
+    if (!load_leaf(ObjKey(m_key ? m_key.value + 1 : 0))) {
+        m_key = ObjKey();
+        return false;
+    }
+    m_key = m_leaf.get_real_key(m_row_ndx);
+    return true;
+}
+
+bool Projection::is_null(size_t ndx) const
+{
+    ColKey col_key = m_col_keys[ndx];
+    update_if_needed();
+
+    if (!col_key.get_attrs().test(col_attr_Nullable))
+        return false;
+    const ArrayPayload* leaf = m_leaves[ndx].get();
+    switch (col_key.get_type()) {
+        case col_type_Int:
+            return static_cast<const ArrayIntNull*>(leaf)->is_null(m_row_ndx);
+        case col_type_Bool:
+            return static_cast<const ArrayBoolNull*>(leaf)->is_null(m_row_ndx);
+        case col_type_Float:
+            return static_cast<const ArrayFloatNull*>(leaf)->is_null(m_row_ndx);
+        case col_type_Double:
+            return static_cast<const ArrayDoubleNull*>(leaf)->is_null(m_row_ndx);
+        case col_type_String:
+            return static_cast<const ArrayString*>(leaf)->is_null(m_row_ndx);
+        case col_type_Binary:
+            return static_cast<const ArrayBinary*>(leaf)->is_null(m_row_ndx);
+        case col_type_Timestamp:
+            return static_cast<const ArrayTimestamp*>(leaf)->is_null(m_row_ndx);
+        case col_type_Decimal:
+            return static_cast<const ArrayDecimal128*>(leaf)->is_null(m_row_ndx);
+        case col_type_ObjectId:
+            return static_cast<const ArrayObjectIdNull*>(leaf)->is_null(m_row_ndx);
+        case col_type_Link:
+            return static_cast<const ArrayKey*>(leaf)->is_null(m_row_ndx);
+        default:
+            REALM_UNREACHABLE();
+    }
+}
+
+bool Projection::load_leaf(ObjKey key) const
+{
+    m_storage_version = get_storage_version();
+    if (!m_table->m_clusters.get_leaf(key, m_state))
+        return false;
+
+    m_row_ndx = m_state.m_current_index;
+    size_t sz = m_col_keys.size();
+    for (size_t i = 0; i < sz; i++)
+        m_leaf.init_leaf(m_col_keys[i], m_leaves[i].get());
+    return true;
+}
+
+uint64_t Projection::get_storage_version() const
+{
+    // Throws if the table has been detached
+    return m_table->m_clusters.get_storage_version(m_instance_version);
+}
+
+void Projection::update_if_needed() const
+{
+    if (!m_key)
+        throw std::runtime_error("Projection is not positioned at an object");
+
+    if (m_storage_version != get_storage_version()) {
+        // The object may have moved, or have been removed
+        if (!load_leaf(m_key) || m_leaf.get_real_key(m_row_ndx) != m_key) {
+            // Make next() look up the object following the removed one
+            m_storage_version = uint64_t(-1);
+            throw KeyNotFound("No such object");
+        }
+    }
+}
@@ -0,0 +1,137 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_PROJECTION_HPP
+#define REALM_PROJECTION_HPP
+
+#include <realm/table.hpp>
+#include <realm/array_basic.hpp>
+#include <realm/array_binary.hpp>
+#include <realm/array_bool.hpp>
+#include <realm/array_decimal128.hpp>
+#include <realm/array_integer.hpp>
+#include <realm/array_key.hpp>
+#include <realm/array_object_id.hpp>
+#include <realm/array_string.hpp>
+#include <realm/array_timestamp.hpp>
+#include <realm/column_type_traits.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace realm {
+
+/// Reads a fixed set of columns of the objects of a table. The leaf accessors
+/// of the columns are initialized once for each cluster and reused for all
+/// objects in it, so reading several fields of consecutive objects does not
+/// resolve the cluster and the leaves for every field like ConstObj::get().
+///
+/// Like ConstObj, the projection follows its object if the table is modified:
+/// the leaves are reloaded when the storage version of the allocator changes,
+/// and KeyNotFound is thrown if the object has been removed.
+///
+///     Projection proj(table, {col_name, col_age});
+///     while (proj.next())
+///         process(proj.get<String>(0), proj.get<Int>(1));
+class Projection {
+public:
+    /// Throws LogicError if one of the columns is a list column.
+    Projection(ConstTableRef table, std::vector<ColKey> col_keys);
+
+    /// Moves to the object with the given key. Throws KeyNotFound if there is
+    /// no such object.
+    void set_key(ObjKey key);
+    /// Moves to the next object in the order of the table, or to the first
+    /// object if the projection has not been positioned yet. Returns false if
+    /// there are no more objects.
+    bool next();
+
+    ObjKey get_key() const noexcept
+    {
+        return m_key;
+    }
+    size_t get_column_count() const noexcept
+    {
+        return m_col_keys.size();
+    }
+    /// The value of the column at \a ndx in the list of columns
+    template <class T>
+    T get(size_t ndx) const;
+    bool is_null(size_t ndx) const;
+
+private:
+    ConstTableRef m_table;
+    std::vector<ColKey> m_col_keys;
+    std::vector<std::unique_ptr<ArrayPayload>> m_leaves;
+    mutable Cluster m_leaf;
+    mutable ClusterNode::IteratorState m_state;
+    ObjKey m_key;
+    mutable size_t m_row_ndx = 0;
+    uint64_t m_instance_version;
+    mutable uint64_t m_storage_version = uint64_t(-1);
+
+    // Position the projection at the first object with a key not less than
+    // 'key'. Returns false if there is no such object.
+    bool load_leaf(ObjKey key) const;
+    uint64_t get_storage_version() const;
+    void update_if_needed() const;
+};
+
+template <class T>
+T Projection::get(size_t ndx) const
+{
+    ColKey col_key = m_col_keys[ndx];
+    REALM_ASSERT(col_key.get_type() == ColumnTypeTraits<T>::column_id);
+    update_if_needed();
+
+    const ArrayPayload* leaf = m_leaves[ndx].get();
+    if constexpr (std::is_same<T, int64_t>::value || std::is_same<T, util::Optional<int64_t>>::value) {
+        if (col_key.get_attrs().test(col_attr_Nullable)) {
+            auto val = static_cast<const ArrayIntNull*>(leaf)->get(m_row_ndx);
+            if constexpr (std::is_same<T, int64_t>::value) {
+                if (!val) {
+                    throw std::runtime_error("Cannot return null value");
+                }
+                return *val;
+            }
+            else {
+                return val;
+            }
+        }
+        return static_cast<const ArrayInteger*>(leaf)->get(m_row_ndx);
+    }
+    else if constexpr (std::is_same<T, bool>::value) {
+        // Bool leaves are always accessed as nullable as the layout is the same
+        auto val = static_cast<const ArrayBoolNull*>(leaf)->get(m_row_ndx);
+        if (!val) {
+            throw std::runtime_error("Cannot return null value");
+        }
+        return *val;
+    }
+    else if constexpr (std::is_same<T, ObjKey>::value) {
+        ObjKey k = static_cast<const ArrayKey*>(leaf)->get(m_row_ndx);
+        return k.is_unresolved() ? ObjKey{} : k;
+    }
+    else {
+        return static_cast<const ColumnClusterLeafType<T>*>(leaf)->get(m_row_ndx);
+    }
+}
+
+} // namespace realm
+
+#endif // REALM_PROJECTION_HPP
@@ -22,11 +22,13 @@
 #include <realm/column_fwd.hpp>
 #include <realm/db.hpp>
 #include <realm/query_engine.hpp>
+#include <realm/query_explanation.hpp>
 #include <realm/query_expression.hpp>
 #include <realm/table_view.hpp>
 #include <realm/table_tpl.hpp>
 
 #include <algorithm>
+#include <chrono>
 
 
 using namespace realm;
@@ -620,6 +622,12 @@ Query& Query::links_to(ColKey origin_column, const std::vector<ObjKey>& target_k
     return *this;
 }
 
+Query& Query::key_range(ObjKey begin, ObjKey end)
+{
+    add_node(std::unique_ptr<ParentNode>(new KeyRangeNode(begin, end)));
+    return *this;
+}
+
 // int64 constant vs column
 Query& Query::equal(ColKey column_key, int64_t value)
 {
@@ -900,6 +908,13 @@ Query& Query::contains(ColKey column_key, StringData value, bool case_sensitive)
         add_condition<ContainsIns>(column_key, value);
     return *this;
 }
+Query& Query::text_match(ColKey column_key, StringData text)
+{
+    if (m_table->search_index_type(column_key) != IndexType::Fulltext)
+        throw LogicError(LogicError::no_search_index);
+    add_node(std::unique_ptr<ParentNode>(new TextMatchNode(text, column_key)));
+    return *this;
+}
 Query& Query::not_equal(ColKey column_key, StringData value, bool case_sensitive)
 {
     if (case_sensitive)
@@ -932,6 +947,34 @@ bool Query::eval_object(ConstObj& obj) const
 
 template <Action action, typename T, typename R>
 R Query::aggregate(ColKey column_key, size_t* resultcount, ObjKey* return_ndx) const
+{
+    std::string cache_key;
+    TableVersions versions;
+    QueryResultCache* cache =
+        get_result_cache(util::format("aggregate %1 %2", int(action), column_key.value), cache_key, versions);
+    QueryResultCache::Result result;
+    if (cache && cache->lookup(cache_key, versions, result)) {
+        if (resultcount)
+            *resultcount = result.count;
+        if (return_ndx)
+            *return_ndx = result.key;
+        return result.value.is_null() ? R{} : result.value.get<R>();
+    }
+    if (!cache)
+        return do_aggregate<action, T, R>(column_key, resultcount, return_ndx);
+
+    R value = do_aggregate<action, T, R>(column_key, &result.count, &result.key);
+    result.value = Mixed(value);
+    if (resultcount)
+        *resultcount = result.count;
+    if (return_ndx)
+        *return_ndx = result.key;
+    cache->insert(cache_key, versions, std::move(result));
+    return value;
+}
+
+template <Action action, typename T, typename R>
+R Query::do_aggregate(ColKey column_key, size_t* resultcount, ObjKey* return_ndx) const
 {
     using LeafType = typename ColumnTypeTraits<T>::cluster_leaf_type;
     using ResultType = typename AggregateResultType<T, action>::result_type;
@@ -980,7 +1023,7 @@ R Query::aggregate(ColKey column_key, size_t* resultcount, ObjKey* return_ndx) c
                     return false;
                 };
 
-                m_table.unchecked_ptr()->traverse_clusters(f);
+                traverse_clusters(f);
             }
         }
         else {
@@ -1022,13 +1065,39 @@ size_t Query::find_best_node(ParentNode* pn) const
 void Query::aggregate_internal(ParentNode* pn, QueryStateBase* st, size_t start, size_t end,
                                ArrayPayload* source_column) const
 {
+    if (m_explanation)
+        m_explanation->leaves++;
+
+    auto aggregate_local = [&](ParentNode* node, size_t local_end, size_t local_limit) {
+        QueryExplanation::Node* explain = node->m_explain;
+        if (!explain)
+            return node->aggregate_local(st, start, local_end, local_limit, source_column);
+
+        auto t1 = std::chrono::steady_clock::now();
+        size_t next = node->aggregate_local(st, start, local_end, local_limit, source_column);
+        auto t2 = std::chrono::steady_clock::now();
+        explain->time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+        explain->rows_tested += std::min(next, local_end) - start;
+        return next;
+    };
+
     while (start < end) {
         // Executes start...end range of a query and will stay inside the condition loop of the node it was called
         // on. Can be called on any node; yields same result, but different performance. Returns prematurely if
         // condition of called node has evaluated to true local_matches number of times.
         // Return value is the next row for resuming aggregating (next row that caller must call aggregate_local on)
         size_t best = find_best_node(pn);
-        start = pn->m_children[best]->aggregate_local(st, start, end, findlocals, source_column);
+        if (pn->m_children.size() > 1 && pn->m_children[best]->m_dD < bitmap_match_distance &&
+            pn->can_aggregate_bitmap()) {
+            // All conditions match frequently, evaluate each of them over the rest of the range and combine
+            if (m_explanation)
+                m_explanation->bitmap_ranges++;
+            pn->aggregate_bitmap(st, start, end, source_column);
+            return;
+        }
+        if (auto explain = pn->m_children[best]->m_explain)
+            explain->times_best++;
+        start = aggregate_local(pn->m_children[best], end, findlocals);
 
         // Make remaining conditions compute their m_dD (statistics)
         for (size_t c = 0; c < pn->m_children.size() && start < end; c++) {
@@ -1042,7 +1111,7 @@ void Query::aggregate_internal(ParentNode* pn, QueryStateBase* st, size_t start,
                 // Limit to bestdist in order not to skip too large parts of index nodes
                 size_t maxD = pn->m_children[c]->m_dT == 0.0 ? end - start : bestdist;
                 size_t td = pn->m_children[c]->m_dT == 0.0 ? end : (start + maxD > end ? end : start + maxD);
-                start = pn->m_children[c]->aggregate_local(st, start, td, probe_matches, source_column);
+                start = aggregate_local(pn->m_children[c], td, probe_matches);
             }
         }
     }
@@ -1313,6 +1382,23 @@ ObjKey Query::find()
     std::unique_ptr<MetricTimer> metric_timer = QueryInfo::track(this, QueryInfo::type_Find);
 #endif
 
+    std::string cache_key;
+    TableVersions versions;
+    QueryResultCache* cache = get_result_cache("find", cache_key, versions);
+    QueryResultCache::Result result;
+    if (cache && cache->lookup(cache_key, versions, result))
+        return result.key;
+
+    ObjKey key = do_find();
+    if (cache) {
+        result.key = key;
+        cache->insert(cache_key, versions, std::move(result));
+    }
+    return key;
+}
+
+ObjKey Query::do_find()
+{
     init();
 
     // User created query with no criteria; return first
@@ -1353,12 +1439,39 @@ ObjKey Query::find()
             return false;
         };
 
-        m_table->traverse_clusters(f);
+        traverse_clusters(f);
         return key;
     }
 }
 
 void Query::find_all(ConstTableView& ret, size_t begin, size_t end, size_t limit) const
+{
+    // Only complete results are cached
+    if (begin != 0 || end != size_t(-1) || limit != size_t(-1))
+        return do_find_all(ret, begin, end, limit);
+
+    std::string cache_key;
+    TableVersions versions;
+    QueryResultCache* cache = get_result_cache("find_all", cache_key, versions);
+    QueryResultCache::Result result;
+    if (cache && cache->lookup(cache_key, versions, result)) {
+        for (auto key : result.keys)
+            ret.m_key_values.add(key);
+        return;
+    }
+
+    size_t first = ret.m_key_values.size();
+    do_find_all(ret, begin, end, limit);
+    if (cache) {
+        size_t sz = ret.m_key_values.size();
+        result.keys.reserve(sz - first);
+        for (size_t i = first; i < sz; ++i)
+            result.keys.push_back(ret.m_key_values.get(i));
+        cache->insert(cache_key, versions, std::move(result));
+    }
+}
+
+void Query::do_find_all(ConstTableView& ret, size_t begin, size_t end, size_t limit) const
 {
     if (limit == 0)
         return;
@@ -1458,7 +1571,12 @@ void Query::find_all(ConstTableView& ret, size_t begin, size_t end, size_t limit
                 return end == 0 || st.m_match_count == st.m_limit;
             };
 
-            m_table->traverse_clusters(f);
+            // Positions are counted from the start of the table, so clusters can only be
+            // skipped if all objects are searched
+            if (begin == 0 && end == m_table->size())
+                traverse_clusters(f);
+            else
+                m_table->traverse_clusters(f);
         }
     }
 }
@@ -1508,6 +1626,10 @@ size_t Query::do_count(size_t limit) const
         auto node = pn->m_children[find_best_node(pn)];
         if (node->has_search_index()) {
             node->index_based_aggregate(limit, [&](ConstObj& obj) -> bool {
+                if (node->m_explain) {
+                    node->m_explain->rows_tested++;
+                    node->m_explain->matches++;
+                }
                 if (eval_object(obj)) {
                     ++counter;
                     return true;
@@ -1535,7 +1657,7 @@ size_t Query::do_count(size_t limit) const
             return st.m_match_count == st.m_limit;
         };
 
-        m_table->traverse_clusters(f);
+        traverse_clusters(f);
 
         cnt = size_t(st.m_state);
     }
@@ -1543,12 +1665,142 @@ size_t Query::do_count(size_t limit) const
     return cnt;
 }
 
+bool Query::traverse_clusters(util::FunctionRef<bool(const Cluster*)> func) const
+{
+    // A key range restricting the whole query limits the clusters to visit
+    ObjKey begin(std::numeric_limits<int64_t>::min());
+    ObjKey end(std::numeric_limits<int64_t>::max());
+    bool has_key_range = false;
+    for (ParentNode* node = has_conditions() ? root_node() : nullptr; node; node = node->m_child.get()) {
+        if (auto range = dynamic_cast<KeyRangeNode*>(node)) {
+            begin = std::max(begin, range->get_begin());
+            end = std::min(end, range->get_end());
+            has_key_range = true;
+        }
+    }
+
+    if (has_key_range)
+        return m_table->traverse_clusters(begin, end, func);
+    return m_table->traverse_clusters(func);
+}
+
+QueryCursor Query::iterate() const
+{
+    return QueryCursor(*this);
+}
+
+ObjKey Query::find_all_in_leaf(std::vector<ObjKey>& keys, ObjKey begin) const
+{
+    const Table* table = m_table.unchecked_ptr();
+    Cluster leaf(0, table->get_alloc(), table->m_clusters);
+    ClusterNode::IteratorState state(leaf);
+    if (!table->m_clusters.get_leaf(begin, state))
+        return ObjKey();
+
+    size_t start = state.m_current_index;
+    size_t end = leaf.node_size();
+    if (!has_conditions()) {
+        for (size_t i = start; i < end; i++)
+            keys.push_back(leaf.get_real_key(i));
+    }
+    else {
+        KeyColumn matches(Allocator::get_default());
+        matches.create();
+        ParentNode* node = root_node();
+        QueryState<int64_t> st(act_FindAll, &matches);
+        node->set_cluster(&leaf);
+        st.m_key_offset = leaf.get_offset();
+        st.m_key_values = leaf.get_key_array();
+        aggregate_internal(node, &st, start, end, nullptr);
+        size_t sz = matches.size();
+        for (size_t i = 0; i < sz; i++)
+            keys.push_back(matches.get(i));
+        matches.destroy();
+    }
+    return ObjKey(leaf.get_real_key(end - 1).value + 1);
+}
+
+QueryCursor::QueryCursor(const Query& query)
+    : m_query(query)
+{
+    if (!m_query.m_table) {
+        m_at_end = true;
+        return;
+    }
+    m_query.init();
+    if (m_query.has_conditions()) {
+        ParentNode* node = m_query.root_node();
+        for (size_t c = 0; c < node->m_children.size(); c++)
+            node->m_children[c]->aggregate_local_prepare(act_FindAll, type_Int, false);
+    }
+}
+
+ObjKey QueryCursor::next()
+{
+    while (m_batch_ndx == m_batch.size()) {
+        m_batch.clear();
+        m_batch_ndx = 0;
+        if (!load(m_batch))
+            return ObjKey();
+    }
+    return m_batch[m_batch_ndx++];
+}
+
+bool QueryCursor::next_batch(std::vector<ObjKey>& keys)
+{
+    keys.clear();
+    if (m_batch_ndx < m_batch.size()) {
+        keys.assign(m_batch.begin() + m_batch_ndx, m_batch.end());
+        m_batch_ndx = m_batch.size();
+        return true;
+    }
+    while (keys.empty()) {
+        if (!load(keys))
+            return false;
+    }
+    return true;
+}
+
+bool QueryCursor::load(std::vector<ObjKey>& keys)
+{
+    if (m_at_end)
+        return false;
+
+    if (ObjList* view = m_query.m_view) {
+        size_t sz = view->size();
+        size_t end = std::min(m_view_ndx + REALM_MAX_BPNODE_SIZE, sz);
+        for (; m_view_ndx < end; m_view_ndx++) {
+            ConstObj obj = view->get_object(m_view_ndx);
+            if (m_query.eval_object(obj))
+                keys.push_back(obj.get_key());
+        }
+        m_at_end = (m_view_ndx == sz);
+        return true;
+    }
+
+    m_next_key = m_query.find_all_in_leaf(keys, m_next_key);
+    m_at_end = !m_next_key;
+    return !m_at_end || !keys.empty();
+}
+
 size_t Query::count() const
 {
 #if REALM_METRICS
     std::unique_ptr<MetricTimer> metric_timer = QueryInfo::track(this, QueryInfo::type_Count);
 #endif
-    return do_count();
+    std::string cache_key;
+    TableVersions versions;
+    QueryResultCache* cache = get_result_cache("count", cache_key, versions);
+    QueryResultCache::Result result;
+    if (cache && cache->lookup(cache_key, versions, result))
+        return result.count;
+
+    size_t count = do_count();
+    if (cache) {
+        result.count = count;
+        cache->insert(cache_key, versions, std::move(result));
+    }
+    return count;
 }
 
 TableView Query::find_all(const DescriptorOrdering& descriptor)
@@ -1621,6 +1873,17 @@ size_t Query::remove()
     return rows;
 }
 
+size_t Query::set(ColKey column_key, Mixed value)
+{
+    TableView tv = find_all();
+    std::vector<ObjKey> keys;
+    keys.reserve(tv.size());
+    for (size_t i = 0; i < tv.size(); i++)
+        keys.push_back(tv.get_key(i));
+    m_table->set_column_values(column_key, keys, value);
+    return keys.size();
+}
+
 #if REALM_MULTITHREAD_QUERY
 TableView Query::find_all_multi(size_t start, size_t end)
 {
@@ -1784,13 +2047,108 @@ std::string Query::get_description() const
     return get_description(state);
 }
 
-void Query::init() const
+QueryExplanation Query::explain_analyze() const
+{
+    QueryExplanation explanation;
+    try {
+        explanation.description = get_description();
+    }
+    catch (const SerialisationError&) {
+        explanation.description = "<not serialisable>";
+    }
+
+    if (!has_conditions() || m_view) {
+        explanation.strategy = has_conditions() ? "view" : "all";
+        auto t1 = std::chrono::steady_clock::now();
+        explanation.count = do_count();
+        auto t2 = std::chrono::steady_clock::now();
+        explanation.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+        return explanation;
+    }
+
+    // Conditions of Or nodes may be combined by init(), so the nodes must be collected after that
+    init();
+    ParentNode* root = root_node();
+    std::vector<ParentNode*> nodes;
+    std::vector<unsigned> depths;
+    auto collect = [&](ParentNode& node, unsigned depth, auto& self) -> void {
+        nodes.push_back(&node);
+        depths.push_back(depth);
+        node.visit_nested([&](ParentNode& nested) {
+            self(nested, depth + 1, self);
+        });
+    };
+    for (ParentNode* node = root; node; node = node->m_child.get())
+        collect(*node, 0, collect);
+
+    explanation.nodes.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto& node = explanation.nodes[i];
+        util::serializer::SerialisationState state;
+        try {
+            node.description = nodes[i]->describe(state);
+        }
+        catch (const SerialisationError&) {
+            node.description = "<not serialisable>";
+        }
+        node.depth = depths[i];
+        nodes[i]->m_explain = &node;
+    }
+
+    ParentNode* best = root->m_children[find_best_node(root)];
+    explanation.strategy = best->has_search_index() ? "index" : "scan";
+    m_explanation = &explanation;
+
+    auto t1 = std::chrono::steady_clock::now();
+    try {
+        explanation.count = do_count();
+    }
+    catch (...) {
+        m_explanation = nullptr;
+        for (auto node : nodes)
+            node->m_explain = nullptr;
+        throw;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    explanation.time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+
+    m_explanation = nullptr;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto& node = explanation.nodes[i];
+        nodes[i]->m_explain = nullptr;
+        node.uses_index = nodes[i]->m_dT == 0.0 || (explanation.strategy == "index" && nodes[i] == best);
+        node.cost = nodes[i]->cost();
+        node.match_distance = nodes[i]->m_dD;
+        if (depths[i] == 0)
+            explanation.plan.push_back(i);
+    }
+    if (explanation.strategy == "index") {
+        auto& node = explanation.nodes[std::find(nodes.begin(), nodes.end(), best) - nodes.begin()];
+        node.times_best = 1;
+        node.time_ns = explanation.time_ns;
+    }
+    std::stable_sort(explanation.plan.begin(), explanation.plan.end(), [&](size_t a, size_t b) {
+        return explanation.nodes[a].cost < explanation.nodes[b].cost;
+    });
+    return explanation;
+}
+
+void Query::init(bool will_query_ranges) const
 {
     m_table.check();
     if (ParentNode* root = root_node()) {
-        root->init(m_view == nullptr);
+        root->init(will_query_ranges && m_view == nullptr);
         std::vector<ParentNode*> vec;
         root->gather_children(vec);
+
+        // Start out from the match distances given by the column statistics, so that the conditions
+        // are ordered by selectivity before any probing has been done
+        double size = double(m_table.unchecked_ptr()->size());
+        for (auto node : vec) {
+            double selectivity = node->estimate_selectivity();
+            if (selectivity >= 0)
+                node->m_dD = selectivity > 0 ? std::min(1.0 / selectivity, size + 1) : size + 1;
+        }
     }
 }
 
@@ -1914,6 +2272,34 @@ Query Query::operator!()
     return q;
 }
 
+QueryResultCache* Query::get_result_cache(const std::string& operation, std::string& cache_key,
+                                          TableVersions& versions) const
+{
+    if (!m_table || m_view)
+        return nullptr;
+    Group* group = m_table.unchecked_ptr()->get_parent_group();
+    QueryResultCache* cache = group ? group->get_query_result_cache() : nullptr;
+    if (!cache)
+        return nullptr;
+
+    // Only tables without uncommitted changes have versions which identify their contents
+    get_outside_versions(versions);
+    for (auto& entry : versions) {
+        auto version = group->get_table(entry.first)->get_commit_version();
+        if (!version)
+            return nullptr;
+        entry.second = *version;
+    }
+
+    try {
+        cache_key = operation + " " + get_description();
+    }
+    catch (const SerialisationError&) {
+        return nullptr;
+    }
+    return cache;
+}
+
 void Query::get_outside_versions(TableVersions& versions) const
 {
     if (m_table) {
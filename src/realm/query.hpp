@@ -39,6 +39,7 @@
 #include <realm/binary_data.hpp>
 #include <realm/timestamp.hpp>
 #include <realm/handover_defs.hpp>
+#include <realm/query_explanation.hpp>
 #include <realm/util/serializer.hpp>
 
 namespace realm {
@@ -53,11 +54,18 @@ class Array;
 class Expression;
 class Group;
 class Transaction;
+class QueryResultCache;
+class QueryCursor;
+class Cluster;
 
 namespace metrics {
 class QueryInfo;
 }
 
+namespace query_builder {
+class PreparedQuery;
+}
+
 struct QueryGroup {
     enum class State {
         Default,
@@ -99,6 +107,9 @@ public:
     Query& links_to(ColKey column_key, ObjKey target_key);
     // Find links that point to specific target objects
     Query& links_to(ColKey column_key, const std::vector<ObjKey>& target_obj);
+    // Only match objects with keys in [begin, end). Unless nested in an Or or a
+    // Not condition, only the clusters that may hold such objects are visited.
+    Query& key_range(ObjKey begin, ObjKey end);
 
     // Conditions: null
     Query& equal(ColKey column_key, null);
@@ -210,6 +221,10 @@ public:
     Query& contains(ColKey column_key, StringData value, bool case_sensitive = true);
     Query& like(ColKey column_key, StringData value, bool case_sensitive = true);
 
+    // Match the words of 'text' against a column with a full-text index, ignoring case. All words
+    // must be present, except that words separated by OR are alternatives.
+    Query& text_match(ColKey column_key, StringData text);
+
     // These are shortcuts for equal(StringData(c_str)) and
     // not_equal(StringData(c_str)), and are needed to avoid unwanted
     // implicit conversion of char* to bool.
@@ -243,6 +258,9 @@ public:
     ObjKey find();
     TableView find_all(size_t start = 0, size_t end = size_t(-1), size_t limit = size_t(-1));
 
+    // Matches one leaf at a time, without collecting all of them first
+    QueryCursor iterate() const;
+
     // Aggregates
     size_t count() const;
     TableView find_all(const DescriptorOrdering& descriptor);
@@ -269,6 +287,10 @@ public:
     // Deletion
     size_t remove();
 
+    // Set the value of a column for all matching objects, see Table::set_column_values().
+    // Returns the number of objects set.
+    size_t set(ColKey column_key, Mixed value);
+
 #if REALM_MULTITHREAD_QUERY
     // Multi-threading
     TableView find_all_multi(size_t start = 0, size_t end = size_t(-1));
@@ -299,12 +321,16 @@ public:
     std::string get_description() const;
     std::string get_description(util::serializer::SerialisationState& state) const;
 
+    // Counts the matches of the query while collecting how the query engine went about it
+    QueryExplanation explain_analyze() const;
+
     bool eval_object(ConstObj& obj) const;
 
 private:
     void create();
 
-    void init() const;
+    // Pass false for 'will_query_ranges' if the query will only be used to evaluate single objects
+    void init(bool will_query_ranges = true) const;
     size_t find_internal(size_t start = 0, size_t end = size_t(-1)) const;
     void handle_pending_not();
     void set_table(TableRef tr);
@@ -352,14 +378,28 @@ private:
 
     template <Action action, typename T, typename R>
     R aggregate(ColKey column_key, size_t* resultcount = nullptr, ObjKey* return_ndx = nullptr) const;
+    template <Action action, typename T, typename R>
+    R do_aggregate(ColKey column_key, size_t* resultcount, ObjKey* return_ndx) const;
 
     size_t find_best_node(ParentNode* pn) const;
     void aggregate_internal(ParentNode* pn, QueryStateBase* st, size_t start, size_t end,
                             ArrayPayload* source_column) const;
 
     void find_all(ConstTableView& tv, size_t start = 0, size_t end = size_t(-1), size_t limit = size_t(-1)) const;
+    void do_find_all(ConstTableView& tv, size_t start, size_t end, size_t limit) const;
+    ObjKey do_find();
     size_t do_count(size_t limit = size_t(-1)) const;
+    // Adds the keys of the matches in the leaf holding the object with key 'begin' (or the next object after it),
+    // starting from that object. Returns the key to continue from, or a null key if there are no more leaves.
+    ObjKey find_all_in_leaf(std::vector<ObjKey>& keys, ObjKey begin) const;
+
+    // The result cache of the DB, if there is one and the result of the operation can be cached. Sets the key
+    // and the table versions to store the result under.
+    QueryResultCache* get_result_cache(const std::string& operation, std::string& cache_key,
+                                       TableVersions& versions) const;
     void delete_nodes() noexcept;
+    // Visit the clusters of the table that may hold matches
+    bool traverse_clusters(util::FunctionRef<bool(const Cluster*)> func) const;
 
     bool has_conditions() const
     {
@@ -376,8 +416,11 @@ private:
     friend class Table;
     friend class ConstTableView;
     friend class SubQueryCount;
+    friend std::vector<ObjKey> find_matching_keys(const Query&);
     friend class PrimitiveListCount;
     friend class metrics::QueryInfo;
+    friend class query_builder::PreparedQuery;
+    friend class QueryCursor;
 
     std::string error_code;
 
@@ -395,6 +438,48 @@ private:
     LnkLstPtr m_source_link_list;                  // link lists are owned by the query.
     ConstTableView* m_source_table_view = nullptr; // table views are not refcounted, and not owned by the query.
     std::unique_ptr<ConstTableView> m_owned_source_table_view; // <--- except when indicated here
+
+    // Set while running explain_analyze()
+    mutable QueryExplanation* m_explanation = nullptr;
+};
+
+/// Yields the keys of the objects matching a query, evaluating the query on one
+/// leaf of the table (or one chunk of the restricting view) at a time. Unlike
+/// find_all(), only the matches of the current leaf are held in memory, and
+/// iteration can be suspended and resumed at any point. The objects are
+/// visited in the order of the table (or view), and the table must not be
+/// modified while iterating.
+///
+///     QueryCursor cursor = query.iterate();
+///     while (ObjKey key = cursor.next())
+///         ...
+class QueryCursor {
+public:
+    QueryCursor(QueryCursor&&) = default;
+    QueryCursor& operator=(QueryCursor&&) = default;
+
+    /// The key of the next match, or a null key if there are no more.
+    ObjKey next();
+
+    /// Replaces the contents of \a keys with the next matches, which are the
+    /// remaining matches of at most one leaf. Returns false if there are no
+    /// more.
+    bool next_batch(std::vector<ObjKey>& keys);
+
+private:
+    Query m_query;
+    // Key of the next object to evaluate, or position in the restricting view
+    ObjKey m_next_key = ObjKey(0);
+    size_t m_view_ndx = 0;
+    bool m_at_end = false;
+    std::vector<ObjKey> m_batch;
+    size_t m_batch_ndx = 0;
+
+    QueryCursor(const Query& query);
+    // Adds the matches of the next leaf to keys. Returns false if all leaves have been evaluated.
+    bool load(std::vector<ObjKey>& keys);
+
+    friend class Query;
 };
 
 // Implementation:
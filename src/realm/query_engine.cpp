@@ -23,6 +23,8 @@
 #include <realm/db.hpp>
 #include <realm/utilities.hpp>
 
+#include <chrono>
+
 using namespace realm;
 
 ParentNode::ParentNode(const ParentNode& from)
@@ -67,6 +69,19 @@ size_t ParentNode::find_first(size_t start, size_t end)
     return not_found;
 }
 
+util::Optional<ColumnStatistics> ParentNode::get_statistics() const
+{
+    if (!m_condition_column_key)
+        return util::none;
+    auto stats = m_table->get_statistics(m_condition_column_key);
+    if (stats) {
+        uint64_t size = m_table->size();
+        if (size > 2 * stats->row_count || 2 * size < stats->row_count)
+            return util::none;
+    }
+    return stats;
+}
+
 bool ParentNode::match(ConstObj& obj)
 {
     auto cb = [this](const Cluster* cluster, size_t row) {
@@ -186,12 +201,18 @@ size_t ParentNode::aggregate_local(QueryStateBase* st, size_t start, size_t end,
         }
 
         local_matches++;
+        if (m_explain)
+            m_explain->matches++;
 
         // Find first match in remaining condition nodes
         size_t m = r;
 
         for (size_t c = 1; c < m_children.size(); c++) {
             m = m_children[c]->find_first_local(r, r + 1);
+            if (auto explain = m_children[c]->m_explain) {
+                explain->rows_tested++;
+                explain->matches += (m == r);
+            }
             if (m != r) {
                 break;
             }
@@ -208,6 +229,151 @@ size_t ParentNode::aggregate_local(QueryStateBase* st, size_t start, size_t end,
     }
 }
 
+void ParentNode::find_all_local(size_t start, size_t end, std::vector<uint64_t>& matches)
+{
+    // Each call continues the search of the condition from the previous match, so the search loop of the
+    // condition is not restarted for every row as when probing
+    for (size_t r = find_first_local(start, end); r != not_found; r = find_first_local(r + 1, end)) {
+        size_t bit = r - start;
+        matches[bit / 64] |= uint64_t(1) << (bit % 64);
+    }
+}
+
+void ParentNode::find_all(size_t start, size_t end, std::vector<uint64_t>& matches)
+{
+    find_all_local(start, end, matches);
+
+    std::vector<uint64_t> child_matches;
+    for (size_t c = 1; c < m_children.size(); c++) {
+        if (std::all_of(matches.begin(), matches.end(), [](uint64_t word) { return word == 0; }))
+            return;
+        child_matches.assign(matches.size(), 0);
+        m_children[c]->find_all_local(start, end, child_matches);
+        for (size_t i = 0; i < matches.size(); i++)
+            matches[i] &= child_matches[i];
+    }
+}
+
+size_t ParentNode::aggregate_bitmap(QueryStateBase* st, size_t start, size_t end, ArrayPayload* source_column)
+{
+    size_t words = (end - start + 63) / 64;
+    std::vector<uint64_t> matches(words, 0);
+    std::vector<uint64_t> child_matches;
+    for (size_t c = 0; c < m_children.size(); c++) {
+        std::vector<uint64_t>& bits = c == 0 ? matches : child_matches;
+        bits.assign(words, 0);
+        QueryExplanation::Node* explain = m_children[c]->m_explain;
+        auto t1 = explain ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+        m_children[c]->find_all_local(start, end, bits);
+
+        size_t count = 0;
+        for (size_t i = 0; i < words; i++) {
+            count += fast_popcount64(bits[i]);
+            if (c > 0)
+                matches[i] &= bits[i];
+        }
+        m_children[c]->m_dD = double(end - start) / (count + 1.1);
+        if (explain) {
+            auto t2 = std::chrono::steady_clock::now();
+            explain->time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count();
+            explain->rows_tested += end - start;
+            explain->matches += count;
+        }
+    }
+
+    for (size_t i = 0; i < words; i++) {
+        for (uint64_t word = matches[i]; word; word &= word - 1) {
+            size_t r = start + i * 64 + ctz(word);
+            if (!(this->*m_column_action_specializer)(st, source_column, r))
+                return static_cast<size_t>(-1);
+        }
+    }
+    return end;
+}
+
+void StringNodeBase::init_ngram_candidates(const std::vector<StringData>& substrings)
+{
+    const Table* table = m_table.unchecked_ptr();
+    if (table->search_index_type(m_condition_column_key) != IndexType::NGram)
+        return;
+
+    StringIndex* index = table->get_search_index(m_condition_column_key);
+    m_use_ngram_candidates = index->find_ngram_candidates(substrings, m_ngram_candidates);
+    count_index_lookup();
+    if (m_use_ngram_candidates) {
+        m_dT = 0.0;
+    }
+}
+
+std::vector<StringData> StringNodeBase::get_like_literals(StringData pattern)
+{
+    std::vector<StringData> literals;
+    size_t begin = 0;
+    for (size_t i = 0; i <= pattern.size(); ++i) {
+        if (i == pattern.size() || pattern[i] == '*' || pattern[i] == '?') {
+            if (i > begin)
+                literals.push_back(pattern.substr(begin, i - begin));
+            begin = i + 1;
+        }
+    }
+    return literals;
+}
+
+size_t StringNodeBase::find_next_ngram_candidate(size_t start, size_t end)
+{
+    if (start >= end)
+        return not_found;
+
+    ObjKey first_key = m_cluster->get_real_key(start);
+    auto it = std::lower_bound(m_ngram_candidates.begin(), m_ngram_candidates.end(), first_key);
+    if (it == m_ngram_candidates.end())
+        return not_found;
+
+    // If the candidate is bigger than the last key, it is not in this range
+    if (*it > m_cluster->get_real_key(end - 1))
+        return not_found;
+
+    return m_cluster->lower_bound_key(ObjKey(it->value - m_cluster->get_offset()));
+}
+
+size_t IndexEvaluator::find_first(const Cluster* cluster, size_t start, size_t end)
+{
+    if (start >= end)
+        return not_found;
+
+    ObjKey first_key = cluster->get_real_key(start);
+    if (first_key < m_last_start_key) {
+        // We are not advancing through the clusters. We basically don't know where we are,
+        // so just start over from the beginning.
+        m_matches_ndx = std::lower_bound(m_matches.begin(), m_matches.end(), first_key) - m_matches.begin();
+    }
+    m_last_start_key = first_key;
+
+    // Skip through keys which are in "earlier" leafs than the one selected by start..end
+    while (m_matches_ndx < m_matches.size() && m_matches[m_matches_ndx] < first_key)
+        ++m_matches_ndx;
+    if (m_matches_ndx == m_matches.size())
+        return not_found;
+
+    // If the key is bigger than the last key, it is not in this leaf
+    ObjKey actual_key = m_matches[m_matches_ndx];
+    if (actual_key > cluster->get_real_key(end - 1))
+        return not_found;
+
+    // The key is known to be in this leaf, so find it within the leaf keys
+    return cluster->lower_bound_key(ObjKey(actual_key.value - cluster->get_offset()));
+}
+
+void IndexEvaluator::aggregate(const Table* table, size_t limit, Evaluator evaluator) const
+{
+    for (size_t t = 0; t < m_matches.size() && limit > 0; ++t) {
+        auto obj = table->get_object(m_matches[t]);
+        if (evaluator(obj)) {
+            --limit;
+        }
+    }
+}
+
 void StringNodeEqualBase::init(bool will_query_ranges)
 {
     m_dD = 10.0;
@@ -284,10 +450,12 @@ void StringNode<Equal>::_search_index_init()
         m_actual_key = ParentNode::m_table.unchecked_ptr()->find_first(ParentNode::m_condition_column_key,
                                                                        StringData(StringNodeBase::m_value));
         m_results_end = m_actual_key ? 1 : 0;
+        count_index_lookup();
     }
     else {
         auto index = ParentNode::m_table.unchecked_ptr()->get_search_index(ParentNode::m_condition_column_key);
         fr = index->find_all_no_copy(StringData(StringNodeBase::m_value), res);
+        count_index_lookup();
 
         m_index_matches.reset();
         switch (fr) {
@@ -373,6 +541,21 @@ void StringNode<EqualIns>::_search_index_init()
     auto index = ParentNode::m_table->get_search_index(ParentNode::m_condition_column_key);
     m_index_matches.clear();
     index->find_all(m_index_matches, StringData(StringNodeBase::m_value), true);
+    count_index_lookup();
+    m_results_start = 0;
+    m_results_ndx = 0;
+    m_results_end = m_index_matches.size();
+    if (m_results_start != m_results_end) {
+        m_actual_key = m_index_matches[0];
+    }
+}
+
+void TextMatchNode::_search_index_init()
+{
+    auto index = ParentNode::m_table->get_search_index(ParentNode::m_condition_column_key);
+    m_index_matches.clear();
+    index->find_all_fulltext(StringData(StringNodeBase::m_value), m_index_matches);
+    count_index_lookup();
     m_results_start = 0;
     m_results_ndx = 0;
     m_results_end = m_index_matches.size();
@@ -396,6 +579,16 @@ size_t StringNode<EqualIns>::_find_first_local(size_t start, size_t end)
 
 } // namespace realm
 
+void NotNode::find_all_local(size_t start, size_t end, std::vector<uint64_t>& matches)
+{
+    std::vector<uint64_t> condition_matches(matches.size(), 0);
+    m_condition->find_all(start, end, condition_matches);
+    for (size_t i = 0; i < matches.size(); i++)
+        matches[i] = ~condition_matches[i];
+    if (size_t tail = (end - start) % 64)
+        matches.back() &= (uint64_t(1) << tail) - 1;
+}
+
 size_t NotNode::find_first_local(size_t start, size_t end)
 {
     if (start <= m_known_range_start && end >= m_known_range_end) {
@@ -549,7 +742,39 @@ void ExpressionNode::cluster_changed()
 void ExpressionNode::init(bool will_query_ranges)
 {
     ParentNode::init(will_query_ranges);
-    m_dT = m_expression->init();
+    m_dT = m_expression->init(will_query_ranges);
+}
+
+void LinksToNode::init(bool will_query_ranges)
+{
+    ParentNode::init(will_query_ranges);
+    m_dD = 10.0;
+    m_dT = 50.0;
+    m_has_backlink_matches = false;
+
+    const Table* table = m_table.unchecked_ptr();
+    table->report_invalid_key(m_condition_column_key);
+    ConstTableRef target_table = table->get_link_target(m_condition_column_key);
+    ColKey backlink_col = table->get_opposite_column(m_condition_column_key);
+    std::vector<ObjKey> origin_keys;
+    for (auto& key : m_target_keys) {
+        if (!key)
+            continue;
+        // Links to unresolved objects are not tracked by backlinks we can look up here
+        if (key.is_unresolved())
+            return;
+        if (!target_table->is_valid(key))
+            continue;
+        auto backlinks = target_table->get_object(key).get_all_backlinks(backlink_col);
+        origin_keys.insert(origin_keys.end(), backlinks.begin(), backlinks.end());
+    }
+    // A list may link to the same object more than once
+    std::sort(origin_keys.begin(), origin_keys.end());
+    origin_keys.erase(std::unique(origin_keys.begin(), origin_keys.end()), origin_keys.end());
+
+    m_index_evaluator.init(std::move(origin_keys));
+    m_has_backlink_matches = true;
+    m_dT = 0.0;
 }
 
 std::string ExpressionNode::describe(util::serializer::SerialisationState& state) const
@@ -567,6 +792,11 @@ void ExpressionNode::collect_dependencies(std::vector<TableKey>& tables) const
     m_expression->collect_dependencies(tables);
 }
 
+bool ExpressionNode::follows_links() const
+{
+    return m_expression->follows_links();
+}
+
 size_t ExpressionNode::find_first_local(size_t start, size_t end)
 {
     return m_expression->find_first(start, end);
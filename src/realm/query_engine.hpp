@@ -103,6 +103,7 @@ AggregateState      State of the aggregate - contains a state variable that stor
 #include <realm/column_type_traits.hpp>
 #include <realm/metrics/query_info.hpp>
 #include <realm/query_conditions.hpp>
+#include <realm/query_explanation.hpp>
 #include <realm/table.hpp>
 #include <realm/column_integer.hpp>
 #include <realm/unicode.hpp>
@@ -137,6 +138,11 @@ const size_t probe_matches = 4;
 
 const size_t bitwidth_time_unit = 64;
 
+// Average match distance of the best condition below which the conditions of a query are evaluated over whole ranges
+// into bitmaps that are then combined (see ParentNode::aggregate_bitmap()). When even the best condition matches this
+// often, alternating between the conditions row by row costs more than testing every row against every condition.
+const double bitmap_match_distance = 16.0;
+
 typedef bool (*CallbackDummy)(int64_t);
 using Evaluator = util::FunctionRef<bool(ConstObj& obj)>;
 
@@ -153,6 +159,20 @@ public:
     }
     virtual void index_based_aggregate(size_t, Evaluator) {}
 
+    // Fraction of the objects expected to match the condition, as estimated from the statistics
+    // of the condition column. Negative if no estimate can be made.
+    virtual double estimate_selectivity() const
+    {
+        return -1;
+    }
+
+    // Replace the value the condition compares against, leaving the rest of the node as it is.
+    // Returns false if this is not supported for the node or the type of the value.
+    virtual bool rebind(Mixed)
+    {
+        return false;
+    }
+
     void gather_children(std::vector<ParentNode*>& v)
     {
         m_children.clear();
@@ -192,6 +212,12 @@ public:
             m_child->get_link_dependencies(tables);
     }
 
+    // Returns true if this or a following condition reads values of other objects through links or backlinks
+    bool has_link_conditions() const
+    {
+        return follows_links() || (m_child && m_child->has_link_conditions());
+    }
+
     void set_table(ConstTableRef table)
     {
         if (table == m_table)
@@ -209,6 +235,8 @@ public:
     void set_cluster(const Cluster* cluster)
     {
         m_cluster = cluster;
+        if (m_explain)
+            m_explain->leaves++;
         if (m_child)
             m_child->set_cluster(cluster);
         cluster_changed();
@@ -218,6 +246,11 @@ public:
     {
     }
 
+    virtual bool follows_links() const
+    {
+        return false;
+    }
+
     virtual size_t find_first_local(size_t start, size_t end) = 0;
 
     virtual void aggregate_local_prepare(Action TAction, DataType col_id, bool nullable);
@@ -251,6 +284,20 @@ public:
     virtual size_t aggregate_local(QueryStateBase* st, size_t start, size_t end, size_t local_limit,
                                    ArrayPayload* source_column);
 
+    // Sets bit i of 'matches' if row start + i of the current leaf matches this condition, without taking the
+    // conditions ANDed on into account. 'matches' must hold end - start bits, all cleared.
+    virtual void find_all_local(size_t start, size_t end, std::vector<uint64_t>& matches);
+    // Same for this condition and the conditions ANDed on
+    void find_all(size_t start, size_t end, std::vector<uint64_t>& matches);
+
+    // Alternative to aggregate_local() on the first of m_children, which evaluates each condition over the
+    // whole range into a bitmap and reports the rows set in all of them.
+    size_t aggregate_bitmap(QueryStateBase* st, size_t start, size_t end, ArrayPayload* source_column);
+    bool can_aggregate_bitmap() const
+    {
+        return m_column_action_specializer != nullptr;
+    }
+
 
     virtual std::string validate()
     {
@@ -343,7 +390,23 @@ public:
     size_t m_probes = 0;
     size_t m_matches = 0;
 
+    // Where the counters of the condition are collected while running Query::explain_analyze(), otherwise null
+    QueryExplanation::Node* m_explain = nullptr;
+
+    // Calls 'func' for the conditions nested in this one, such as the conditions of an Or node
+    virtual void visit_nested(util::FunctionRef<void(ParentNode&)>) {}
+
 protected:
+    void count_index_lookup()
+    {
+        if (m_explain)
+            m_explain->index_lookups++;
+    }
+
+    // The statistics of the condition column, unless the size of the table has changed
+    // considerably since they were computed
+    util::Optional<ColumnStatistics> get_statistics() const;
+
     typedef bool (ParentNode::*Column_action_specialized)(QueryStateBase*, ArrayPayload*, size_t);
     Column_action_specialized m_column_action_specializer = nullptr;
     ConstTableRef m_table = ConstTableRef();
@@ -401,6 +464,60 @@ struct CostHeuristic<ArrayIntNull> {
 };
 
 // FIXME: Add AdaptiveStringColumn, BasicColumn, etc.
+
+// An index lookup matching more than this fraction of the objects is slower than scanning the column
+constexpr double max_index_selectivity = 0.25;
+
+inline util::Optional<double> statistics_value(int64_t value)
+{
+    return double(value);
+}
+inline util::Optional<double> statistics_value(util::Optional<int64_t> value)
+{
+    return value ? util::Optional<double>(double(*value)) : util::none;
+}
+inline util::Optional<double> statistics_value(float value)
+{
+    return null::is_null_float(value) ? util::none : util::Optional<double>(value);
+}
+inline util::Optional<double> statistics_value(double value)
+{
+    return null::is_null_float(value) ? util::none : util::Optional<double>(value);
+}
+
+template <class TConditionFunction>
+double estimate_selectivity(const ColumnStatistics& stats, util::Optional<double> value)
+{
+    double nulls = stats.null_fraction();
+    if (!value) {
+        if constexpr (std::is_same_v<TConditionFunction, Equal>)
+            return nulls;
+        if constexpr (std::is_same_v<TConditionFunction, NotEqual>)
+            return 1 - nulls;
+        return -1;
+    }
+    if constexpr (std::is_same_v<TConditionFunction, Equal>) {
+        return stats.equal_fraction(value);
+    }
+    else if constexpr (std::is_same_v<TConditionFunction, NotEqual>) {
+        return 1 - nulls - stats.equal_fraction(value);
+    }
+    else if constexpr (std::is_same_v<TConditionFunction, Less>) {
+        return stats.less_fraction(*value, false);
+    }
+    else if constexpr (std::is_same_v<TConditionFunction, LessEqual>) {
+        return stats.less_fraction(*value, true);
+    }
+    else if constexpr (std::is_same_v<TConditionFunction, Greater>) {
+        double below = stats.less_fraction(*value, true);
+        return below < 0 ? below : std::max(0.0, 1 - nulls - below);
+    }
+    else if constexpr (std::is_same_v<TConditionFunction, GreaterEqual>) {
+        double below = stats.less_fraction(*value, false);
+        return below < 0 ? below : std::max(0.0, 1 - nulls - below);
+    }
+    return -1;
+}
 }
 
 class ColumnNodeBase : public ParentNode {
@@ -431,6 +548,8 @@ protected:
         size_t i = to_size_t(v);
         m_last_local_match = i;
         m_local_matches++;
+        if (m_explain)
+            m_explain->matches++;
 
         auto state = static_cast<QueryState<ResultType>*>(m_state);
         auto source_column = static_cast<LeafType*>(m_source_column);
@@ -440,6 +559,10 @@ protected:
         for (size_t c = 1; c < m_children.size(); c++) {
             m_children[c]->m_probes++;
             size_t m = m_children[c]->find_first_local(i, i + 1);
+            if (auto explain = m_children[c]->m_explain) {
+                explain->rows_tested++;
+                explain->matches += (m == i);
+            }
             if (m != i)
                 return true;
         }
@@ -487,6 +610,15 @@ public:
     }
 
 protected:
+    // The aggregate callbacks of ParentNode are used when the conditions are combined as bitmaps
+    void prepare_bitmap_aggregate(Action action, DataType col_id, bool is_nullable)
+    {
+        if (col_id == type_Timestamp)
+            m_column_action_specializer = nullptr;
+        else
+            ParentNode::aggregate_local_prepare(action, col_id, is_nullable);
+    }
+
     size_t aggregate_local_impl(QueryStateBase* st, size_t start, size_t end, size_t local_limit,
                                 ArrayPayload* source_column, int c)
     {
@@ -503,8 +635,11 @@ protected:
         // column only, with no references to other columns:
         bool fastmode = should_run_in_fastmode(source_column);
         if (fastmode) {
+            size_t matches_before = st->m_match_count;
             bool cont;
             cont = m_leaf_ptr->find(c, m_action, m_value, start, end, 0, static_cast<QueryState<int64_t>*>(st));
+            if (m_explain)
+                m_explain->matches += st->m_match_count - matches_before;
             if (!cont)
                 return not_found;
         }
@@ -562,6 +697,14 @@ protected:
         m_dD = _impl::CostHeuristic<LeafType>::dD();
     }
 
+    bool rebind(Mixed value) override
+    {
+        if (value.is_null() || value.get_type() != type_Int)
+            return false;
+        m_value = value.get_int();
+        return true;
+    }
+
     bool should_run_in_fastmode(ArrayPayload* source_leaf) const
     {
         if (m_children.size() > 1 || m_fastmode_disabled)
@@ -676,6 +819,7 @@ public:
 
     void aggregate_local_prepare(Action action, DataType col_id, bool is_nullable) override
     {
+        this->prepare_bitmap_aggregate(action, col_id, is_nullable);
         this->m_fastmode_disabled = (col_id == type_Float || col_id == type_Double);
         this->m_action = action;
         this->m_find_callback_specialized =
@@ -695,6 +839,25 @@ public:
         return this->m_leaf_ptr->template find_first<TConditionFunction>(this->m_value, start, end);
     }
 
+    void find_all_local(size_t start, size_t end, std::vector<uint64_t>& matches) override
+    {
+        // One pass of the search kernel of the leaf, reporting every match
+        auto set_bit = [&](int64_t r) {
+            size_t bit = size_t(r) - start;
+            matches[bit / 64] |= uint64_t(1) << (bit % 64);
+            return true;
+        };
+        this->m_leaf_ptr->template find<TConditionFunction, act_CallbackIdx>(this->m_value, start, end, 0, nullptr,
+                                                                             set_bit);
+    }
+
+    double estimate_selectivity() const override
+    {
+        if (auto stats = this->get_statistics())
+            return _impl::estimate_selectivity<TConditionFunction>(*stats, _impl::statistics_value(this->m_value));
+        return -1;
+    }
+
     std::string describe(util::serializer::SerialisationState& state) const override
     {
         return state.describe_column(ParentNode::m_table, ColumnNodeBase::m_condition_column_key) + " " +
@@ -753,12 +916,14 @@ public:
     {
         BaseType::init(will_query_ranges);
         m_nb_needles = m_needles.size();
+        m_scan_preferred = estimate_selectivity() > _impl::max_index_selectivity;
 
         if (has_search_index()) {
             // _search_index_init();
             m_result.clear();
             auto index = ParentNode::m_table->get_search_index(ParentNode::m_condition_column_key);
             index->find_all(m_result, BaseType::m_value);
+            ParentNode::count_index_lookup();
             m_result_get = 0;
             m_last_start_key = ObjKey();
             IntegerNodeBase<LeafType>::m_dT = 0;
@@ -779,7 +944,21 @@ public:
 
     bool has_search_index() const override
     {
-        return this->m_table->has_search_index(IntegerNodeBase<LeafType>::m_condition_column_key);
+        return !m_scan_preferred &&
+               this->m_table->has_search_index(IntegerNodeBase<LeafType>::m_condition_column_key);
+    }
+
+    double estimate_selectivity() const override
+    {
+        if (auto stats = this->get_statistics()) {
+            if (m_needles.empty())
+                return _impl::estimate_selectivity<Equal>(*stats, _impl::statistics_value(this->m_value));
+            double selectivity = 0;
+            for (auto& needle : m_needles)
+                selectivity += _impl::estimate_selectivity<Equal>(*stats, _impl::statistics_value(needle));
+            return std::min(selectivity, 1.0);
+        }
+        return -1;
     }
 
     void index_based_aggregate(size_t limit, Evaluator evaluator) override
@@ -794,6 +973,7 @@ public:
 
     void aggregate_local_prepare(Action action, DataType col_id, bool is_nullable) override
     {
+        this->prepare_bitmap_aggregate(action, col_id, is_nullable);
         this->m_fastmode_disabled = (col_id == type_Float || col_id == type_Double);
         this->m_action = action;
         this->m_find_callback_specialized =
@@ -893,6 +1073,7 @@ private:
     std::unordered_set<TConditionValue> m_needles;
     std::vector<ObjKey> m_result;
     size_t m_nb_needles = 0;
+    bool m_scan_preferred = false;
     size_t m_result_get = 0;
     ObjKey m_last_start_key;
 
@@ -904,6 +1085,35 @@ private:
 };
 
 
+// Walks through the objects found by a search index lookup, following the clusters visited by the
+// query. Used by nodes whose equality condition can be answered by the index.
+class IndexEvaluator {
+public:
+    template <class T>
+    void init(const StringIndex* index, T value)
+    {
+        m_matches.clear();
+        index->find_all(m_matches, value);
+        m_matches_ndx = 0;
+        m_last_start_key = ObjKey();
+    }
+    // Walk through a sorted list of keys found by other means than an index lookup
+    void init(std::vector<ObjKey>&& matches)
+    {
+        m_matches = std::move(matches);
+        m_matches_ndx = 0;
+        m_last_start_key = ObjKey();
+    }
+
+    size_t find_first(const Cluster* cluster, size_t start, size_t end);
+    void aggregate(const Table* table, size_t limit, Evaluator evaluator) const;
+
+private:
+    std::vector<ObjKey> m_matches;
+    size_t m_matches_ndx = 0;
+    ObjKey m_last_start_key;
+};
+
 // This node is currently used for floats and doubles only
 template <class LeafType, class TConditionFunction>
 class FloatDoubleNode : public ParentNode {
@@ -937,14 +1147,65 @@ public:
         m_leaf_ptr = m_array_ptr.get();
     }
 
+    void table_changed() override
+    {
+        // Only an equality can be answered by the index
+        m_has_search_index = std::is_same_v<TConditionFunction, Equal> &&
+                             m_table.unchecked_ptr()->has_search_index(m_condition_column_key);
+    }
+
+    bool has_search_index() const override
+    {
+        return m_has_search_index && !m_scan_preferred;
+    }
+
+    double estimate_selectivity() const override
+    {
+        if (auto stats = get_statistics())
+            return _impl::estimate_selectivity<TConditionFunction>(*stats, _impl::statistics_value(m_value));
+        return -1;
+    }
+
     void init(bool will_query_ranges) override
     {
         ParentNode::init(will_query_ranges);
         m_dD = 100.0;
+        m_dT = 1.0;
+        m_scan_preferred = m_has_search_index && estimate_selectivity() > _impl::max_index_selectivity;
+        if (has_search_index()) {
+            m_index_evaluator.init(m_table->get_search_index(m_condition_column_key), m_value);
+            count_index_lookup();
+            m_dT = 0.0;
+        }
+    }
+
+    bool rebind(Mixed value) override
+    {
+        if (value.is_null())
+            return false;
+        if constexpr (std::is_same_v<TConditionValue, float>) {
+            if (value.get_type() != type_Float)
+                return false;
+            m_value = value.get_float();
+        }
+        else {
+            if (value.get_type() != type_Double)
+                return false;
+            m_value = value.get_double();
+        }
+        return true;
+    }
+
+    void index_based_aggregate(size_t limit, Evaluator evaluator) override
+    {
+        m_index_evaluator.aggregate(m_table.unchecked_ptr(), limit, evaluator);
     }
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (has_search_index())
+            return m_index_evaluator.find_first(m_cluster, start, end);
+
         TConditionFunction cond;
 
         auto find = [&](bool nullability) {
@@ -984,11 +1245,15 @@ public:
     FloatDoubleNode(const FloatDoubleNode& from)
         : ParentNode(from)
         , m_value(from.m_value)
+        , m_has_search_index(from.m_has_search_index)
     {
     }
 
 protected:
     TConditionValue m_value;
+    bool m_has_search_index = false;
+    bool m_scan_preferred = false;
+    IndexEvaluator m_index_evaluator;
     // Leaf cache
     using LeafCacheStorage = typename std::aligned_storage<sizeof(LeafType), alignof(LeafType)>::type;
     using LeafPtr = std::unique_ptr<LeafType, PlacementDelete>;
@@ -1230,6 +1495,14 @@ public:
         m_dD = 100.0;
     }
 
+    bool rebind(Mixed value) override
+    {
+        if (value.is_null() || value.get_type() != type_Bool)
+            return false;
+        m_value = value.get_bool();
+        return true;
+    }
+
     size_t find_first_local(size_t start, size_t end) override
     {
         TConditionFunction condition;
@@ -1388,8 +1661,39 @@ class DecimalNode : public DecimalNodeBase {
 public:
     using DecimalNodeBase::DecimalNodeBase;
 
+    void table_changed() override
+    {
+        // Only an equality can be answered by the index
+        m_has_search_index = std::is_same_v<TConditionFunction, Equal> &&
+                             m_table.unchecked_ptr()->has_search_index(m_condition_column_key);
+    }
+
+    bool has_search_index() const override
+    {
+        return m_has_search_index;
+    }
+
+    void init(bool will_query_ranges) override
+    {
+        DecimalNodeBase::init(will_query_ranges);
+        m_dT = 1.0;
+        if (m_has_search_index) {
+            m_index_evaluator.init(m_table->get_search_index(m_condition_column_key), m_value);
+            count_index_lookup();
+            m_dT = 0.0;
+        }
+    }
+
+    void index_based_aggregate(size_t limit, Evaluator evaluator) override
+    {
+        m_index_evaluator.aggregate(m_table.unchecked_ptr(), limit, evaluator);
+    }
+
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_has_search_index)
+            return m_index_evaluator.find_first(m_cluster, start, end);
+
         TConditionFunction cond;
         bool value_is_null = m_value.is_null();
         for (size_t i = start; i < end; i++) {
@@ -1417,6 +1721,9 @@ protected:
         : DecimalNodeBase(from, tr)
     {
     }
+
+    bool m_has_search_index = false;
+    IndexEvaluator m_index_evaluator;
 };
 
 class ObjectIdNodeBase : public ParentNode {
@@ -1551,6 +1858,8 @@ public:
         m_end_s = 0;
         m_leaf_start = 0;
         m_leaf_end = 0;
+        m_use_ngram_candidates = false;
+        m_ngram_candidates.clear();
     }
 
     virtual void clear_leaf_state()
@@ -1591,10 +1900,33 @@ protected:
     size_t m_leaf_start = 0;
     size_t m_leaf_end = 0;
 
+    // Objects found through an n-gram index. If in use, only these objects can match.
+    std::vector<ObjKey> m_ngram_candidates;
+    bool m_use_ngram_candidates = false;
+
     inline StringData get_string(size_t s)
     {
         return m_leaf_ptr->get(s);
     }
+
+    // If the column has an n-gram index, restrict the search to the objects
+    // whose value may contain all of 'substrings'
+    void init_ngram_candidates(const std::vector<StringData>& substrings);
+
+    // Returns the literal parts of a pattern given to 'like'
+    static std::vector<StringData> get_like_literals(StringData pattern);
+
+    // Returns the first index in [start, end) which may match. Without n-gram
+    // candidates this is just 'start'.
+    size_t next_candidate(size_t start, size_t end)
+    {
+        if (!m_use_ngram_candidates)
+            return start;
+        return find_next_ngram_candidate(start, end);
+    }
+
+private:
+    size_t find_next_ngram_candidate(size_t start, size_t end);
 };
 
 // Conditions for strings. Note that Equal is specialized later in this file!
@@ -1615,6 +1947,21 @@ public:
         }
     }
 
+    bool rebind(Mixed value) override
+    {
+        if (value.is_null() || value.get_type() != type_String)
+            return false;
+        StringData v = value.get_string();
+        auto upper = case_map(v, true);
+        auto lower = case_map(v, false);
+        if (!upper || !lower)
+            return false;
+        m_value = std::string(v);
+        m_ucase = std::move(*upper);
+        m_lcase = std::move(*lower);
+        return true;
+    }
+
     void init(bool will_query_ranges) override
     {
         clear_leaf_state();
@@ -1622,13 +1969,26 @@ public:
         m_dD = 100.0;
 
         StringNodeBase::init(will_query_ranges);
+
+        if (m_value) {
+            if constexpr (std::is_same_v<TConditionFunction, BeginsWith> ||
+                          std::is_same_v<TConditionFunction, BeginsWithIns> ||
+                          std::is_same_v<TConditionFunction, EndsWith> ||
+                          std::is_same_v<TConditionFunction, EndsWithIns>) {
+                init_ngram_candidates({StringData(*m_value)});
+            }
+            else if constexpr (std::is_same_v<TConditionFunction, Like> ||
+                               std::is_same_v<TConditionFunction, LikeIns>) {
+                init_ngram_candidates(get_like_literals(*m_value));
+            }
+        }
     }
 
     size_t find_first_local(size_t start, size_t end) override
     {
         TConditionFunction cond;
 
-        for (size_t s = start; s < end; ++s) {
+        for (size_t s = next_candidate(start, end); s < end; s = next_candidate(s + 1, end)) {
             StringData t = get_string(s);
 
             if (cond(StringData(m_value), m_ucase.c_str(), m_lcase.c_str(), t))
@@ -1689,6 +2049,9 @@ public:
         m_dD = 100.0;
 
         StringNodeBase::init(will_query_ranges);
+
+        if (m_value)
+            init_ngram_candidates({StringData(*m_value)});
     }
 
 
@@ -1696,7 +2059,7 @@ public:
     {
         Contains cond;
 
-        for (size_t s = start; s < end; ++s) {
+        for (size_t s = next_candidate(start, end); s < end; s = next_candidate(s + 1, end)) {
             StringData t = get_string(s);
 
             if (cond(StringData(m_value), m_charmap, t))
@@ -1768,6 +2131,9 @@ public:
         m_dD = 100.0;
 
         StringNodeBase::init(will_query_ranges);
+
+        if (m_value)
+            init_ngram_candidates({StringData(*m_value)});
     }
 
 
@@ -1775,7 +2141,7 @@ public:
     {
         ContainsIns cond;
 
-        for (size_t s = start; s < end; ++s) {
+        for (size_t s = next_candidate(start, end); s < end; s = next_candidate(s + 1, end)) {
             StringData t = get_string(s);
             // The current behaviour is to return all results when querying for a null string.
             // See comment above Query_NextGen_StringConditions on why every string including "" contains null.
@@ -1885,6 +2251,27 @@ public:
 
     bool do_consume_condition(ParentNode& other) override;
 
+    bool rebind(Mixed value) override
+    {
+        if (value.is_null() || value.get_type() != type_String || !m_needles.empty())
+            return false;
+        m_value = std::string(value.get_string());
+        return true;
+    }
+
+    double estimate_selectivity() const override
+    {
+        if (auto stats = get_statistics()) {
+            if (m_needles.empty())
+                return m_value ? stats->equal_fraction() : stats->null_fraction();
+            double selectivity = 0;
+            for (auto& needle : m_needles)
+                selectivity += needle.is_null() ? stats->null_fraction() : stats->equal_fraction();
+            return std::min(selectivity, 1.0);
+        }
+        return -1;
+    }
+
     std::unique_ptr<ParentNode> clone() const override
     {
         return std::unique_ptr<ParentNode>(new StringNode<Equal>(*this));
@@ -1974,7 +2361,9 @@ public:
     void table_changed() override
     {
         StringNodeBase::table_changed();
-        m_has_search_index = m_table.unchecked_ptr()->has_search_index(m_condition_column_key);
+        // A case insensitive index can answer the query with a single lookup
+        auto index_type = m_table.unchecked_ptr()->search_index_type(m_condition_column_key);
+        m_has_search_index = index_type == IndexType::General || index_type == IndexType::CaseInsensitive;
     }
     void _search_index_init() override;
 
@@ -2019,6 +2408,68 @@ private:
     size_t _find_first_local(size_t start, size_t end) override;
 };
 
+// Matches the objects whose string contains the words given, using a full-text index. The
+// matches are looked up once and then walked through cluster by cluster like an indexed equality.
+class TextMatchNode : public StringNodeEqualBase {
+public:
+    TextMatchNode(StringData v, ColKey column)
+        : StringNodeEqualBase(v, column)
+    {
+    }
+
+    void clear_leaf_state() override
+    {
+        StringNodeEqualBase::clear_leaf_state();
+        m_index_matches.clear();
+    }
+
+    void table_changed() override
+    {
+        StringNodeBase::table_changed();
+        REALM_ASSERT(m_table.unchecked_ptr()->search_index_type(m_condition_column_key) == IndexType::Fulltext);
+        m_has_search_index = true;
+    }
+    void _search_index_init() override;
+
+    virtual std::string describe_condition() const override
+    {
+        return "TEXT";
+    }
+
+    std::unique_ptr<ParentNode> clone() const override
+    {
+        return std::unique_ptr<ParentNode>(new TextMatchNode(*this));
+    }
+
+    TextMatchNode(const TextMatchNode& from)
+        : StringNodeEqualBase(from)
+    {
+    }
+
+    void index_based_aggregate(size_t limit, Evaluator evaluator) override
+    {
+        for (size_t t = 0; t < m_index_matches.size() && limit > 0; ++t) {
+            auto obj = m_table->get_object(m_index_matches[t]);
+            if (evaluator(obj)) {
+                --limit;
+            }
+        }
+    }
+
+private:
+    std::vector<ObjKey> m_index_matches;
+
+    ObjKey get_key(size_t ndx) override
+    {
+        return m_index_matches[ndx];
+    }
+
+    size_t _find_first_local(size_t, size_t) override
+    {
+        REALM_UNREACHABLE();
+    }
+};
+
 // OR node contains at least two node pointers: Two or more conditions to OR
 // together in m_conditions, and the next AND condition (if any) in m_child.
 //
@@ -2090,6 +2541,15 @@ public:
         }
     }
 
+    bool follows_links() const override
+    {
+        for (const auto& cond : m_conditions) {
+            if (cond->has_link_conditions())
+                return true;
+        }
+        return false;
+    }
+
     void init(bool will_query_ranges) override
     {
         ParentNode::init(will_query_ranges);
@@ -2141,6 +2601,10 @@ public:
             m_start[c] = start;
             size_t fmax = std::max(m_last[c], start);
             size_t f = m_conditions[c]->find_first(fmax, end);
+            if (auto explain = m_conditions[c]->m_explain) {
+                explain->rows_tested += (f == not_found ? end : f + 1) - fmax;
+                explain->matches += (f != not_found);
+            }
             m_was_match[c] = f != not_found;
             m_last[c] = f == not_found ? end : f;
             if (f != not_found && index > m_last[c])
@@ -2150,6 +2614,30 @@ public:
         return index;
     }
 
+    void find_all_local(size_t start, size_t end, std::vector<uint64_t>& matches) override
+    {
+        std::vector<uint64_t> condition_matches;
+        for (auto& condition : m_conditions) {
+            condition_matches.assign(matches.size(), 0);
+            condition->find_all(start, end, condition_matches);
+            for (size_t i = 0; i < matches.size(); i++)
+                matches[i] |= condition_matches[i];
+            if (auto explain = condition->m_explain) {
+                explain->rows_tested += end - start;
+                for (auto word : condition_matches)
+                    explain->matches += fast_popcount64(word);
+            }
+        }
+    }
+
+    void visit_nested(util::FunctionRef<void(ParentNode&)> func) override
+    {
+        for (auto& condition : m_conditions) {
+            for (ParentNode* node = condition.get(); node; node = node->m_child.get())
+                func(*node);
+        }
+    }
+
     std::string validate() override
     {
         if (error_code != "")
@@ -2239,6 +2727,13 @@ public:
     }
 
     size_t find_first_local(size_t start, size_t end) override;
+    void find_all_local(size_t start, size_t end, std::vector<uint64_t>& matches) override;
+
+    void visit_nested(util::FunctionRef<void(ParentNode&)> func) override
+    {
+        for (ParentNode* node = m_condition.get(); node; node = node->m_child.get())
+            func(*node);
+    }
 
     std::string validate() override
     {
@@ -2272,6 +2767,11 @@ public:
         }
     }
 
+    bool follows_links() const override
+    {
+        return m_condition && m_condition->has_link_conditions();
+    }
+
 
     std::unique_ptr<ParentNode> clone() const override
     {
@@ -2437,6 +2937,7 @@ public:
     void table_changed() override;
     void cluster_changed() override;
     void collect_dependencies(std::vector<TableKey>&) const override;
+    bool follows_links() const override;
 
     virtual std::string describe(util::serializer::SerialisationState& state) const override;
 
@@ -2473,6 +2974,20 @@ public:
         REALM_ASSERT(m_column_type == type_Link || m_column_type == type_LinkList);
     }
 
+    bool has_search_index() const override
+    {
+        return m_has_backlink_matches;
+    }
+
+    // The objects linking to the targets are found through the backlinks of the targets, so
+    // the origin table is only visited at the matching objects.
+    void init(bool will_query_ranges) override;
+
+    void index_based_aggregate(size_t limit, Evaluator evaluator) override
+    {
+        m_index_evaluator.aggregate(m_table.unchecked_ptr(), limit, evaluator);
+    }
+
     void cluster_changed() override
     {
         m_array_ptr = nullptr;
@@ -2502,6 +3017,9 @@ public:
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_has_backlink_matches)
+            return m_index_evaluator.find_first(m_cluster, start, end);
+
         if (m_column_type == type_Link) {
             for (auto& key : m_target_keys) {
                 if (key) {
@@ -2539,6 +3057,8 @@ public:
 private:
     std::vector<ObjKey> m_target_keys;
     DataType m_column_type = type_Link;
+    bool m_has_backlink_matches = false;
+    IndexEvaluator m_index_evaluator;
     using LeafPtr = std::unique_ptr<ArrayPayload, PlacementDelete>;
     union Storage {
         typename std::aligned_storage<sizeof(ArrayKey), alignof(ArrayKey)>::type m_list;
@@ -2557,6 +3077,59 @@ private:
     }
 };
 
+// Restricts the query to the objects with keys in [begin, end). The query only
+// visits the clusters that may hold such objects, see Query::key_range().
+class KeyRangeNode : public ParentNode {
+public:
+    KeyRangeNode(ObjKey begin, ObjKey end)
+        : m_begin(begin)
+        , m_end(end)
+    {
+        m_dD = 100.0;
+        m_dT = 0.0;
+    }
+
+    ObjKey get_begin() const
+    {
+        return m_begin;
+    }
+    ObjKey get_end() const
+    {
+        return m_end;
+    }
+
+    size_t find_first_local(size_t start, size_t end) override
+    {
+        int64_t offset = m_cluster->get_offset();
+        size_t ndx = m_begin.value > offset ? m_cluster->lower_bound_key(ObjKey(m_begin.value - offset)) : 0;
+        ndx = std::max(ndx, start);
+        if (ndx < end && m_cluster->get_real_key(ndx) < m_end)
+            return ndx;
+        return not_found;
+    }
+
+    std::string describe(util::serializer::SerialisationState&) const override
+    {
+        throw SerialisationError("Serialising a query restricted to a key range is currently unsupported.");
+    }
+
+    std::unique_ptr<ParentNode> clone() const override
+    {
+        return std::unique_ptr<ParentNode>(new KeyRangeNode(*this));
+    }
+
+private:
+    ObjKey m_begin;
+    ObjKey m_end;
+
+    KeyRangeNode(const KeyRangeNode& from)
+        : ParentNode(from)
+        , m_begin(from.m_begin)
+        , m_end(from.m_end)
+    {
+    }
+};
+
 } // namespace realm
 
 #endif // REALM_QUERY_ENGINE_HPP
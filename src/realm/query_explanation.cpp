@@ -0,0 +1,63 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/query_explanation.hpp>
+
+#include <iomanip>
+#include <sstream>
+
+using namespace realm;
+
+namespace {
+
+std::string format_time(uint64_t ns)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3) << ns / 1e6 << " ms";
+    return out.str();
+}
+
+} // anonymous namespace
+
+std::string QueryExplanation::to_string() const
+{
+    std::ostringstream out;
+    out << "Query: " << description << "\n";
+    out << "Strategy: " << strategy << ", " << count << " matches in " << format_time(time_ns) << ", " << leaves
+        << " leaves";
+    if (bitmap_ranges)
+        out << ", " << bitmap_ranges << " ranges evaluated as bitmaps";
+    out << "\n";
+
+    if (!plan.empty()) {
+        out << "Plan:";
+        for (size_t ndx : plan)
+            out << " " << ndx;
+        out << "\n";
+    }
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        const Node& node = nodes[i];
+        out << std::setw(3) << i << " " << std::string(2 * node.depth, ' ') << node.description << "\n";
+        out << "    " << std::string(2 * node.depth, ' ') << (node.uses_index ? "index" : "scan")
+            << ", best " << node.times_best << " times, tested " << node.rows_tested << ", matched "
+            << node.matches << ", " << node.leaves << " leaves, " << node.index_lookups << " index lookups, "
+            << format_time(node.time_ns) << ", cost " << node.cost << "\n";
+    }
+    return out.str();
+}
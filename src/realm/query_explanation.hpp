@@ -0,0 +1,78 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_QUERY_EXPLANATION_HPP
+#define REALM_QUERY_EXPLANATION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace realm {
+
+/// How a query was executed and what each of its conditions did, as collected
+/// by Query::explain_analyze() while counting the matches of the query.
+struct QueryExplanation {
+    struct Node {
+        /// The condition in the syntax of Query::get_description()
+        std::string description;
+        /// Conditions of an Or or Not node are one level deeper than the node
+        unsigned depth = 0;
+        /// Whether the condition was evaluated through the search index of its
+        /// column rather than by scanning the column
+        bool uses_index = false;
+        /// The cost estimated for the condition by the query engine and the
+        /// average distance between its matches, as they were when the query
+        /// completed. The condition with the lowest cost drives the search.
+        double cost = 0;
+        double match_distance = 0;
+        /// Number of times the condition was chosen to drive the search
+        size_t times_best = 0;
+        size_t rows_tested = 0;
+        size_t matches = 0;
+        size_t leaves = 0;
+        size_t index_lookups = 0;
+        /// Time spent driving the search, which includes testing the other
+        /// conditions against the matches of this one
+        uint64_t time_ns = 0;
+    };
+
+    std::string description;
+    /// How the objects were found: "all" if the query has no conditions,
+    /// "view" if it is restricted by a view or list, "index" if the objects
+    /// were taken from the search index of the best condition, or "scan".
+    std::string strategy;
+    size_t count = 0;
+    size_t leaves = 0;
+    /// Number of ranges in which the conditions were evaluated as bitmaps
+    size_t bitmap_ranges = 0;
+    uint64_t time_ns = 0;
+    /// The conditions in the order of the query, nested conditions following
+    /// the node they are nested in
+    std::vector<Node> nodes;
+    /// Indexes into 'nodes' of the top level conditions ordered by their final
+    /// cost, i.e. the order in which they would be tried next
+    std::vector<size_t> plan;
+
+    std::string to_string() const;
+};
+
+} // namespace realm
+
+#endif // REALM_QUERY_EXPLANATION_HPP
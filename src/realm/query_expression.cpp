@@ -18,6 +18,7 @@
 
 #include <realm/query_expression.hpp>
 #include <realm/group.hpp>
+#include <realm/table_view.hpp>
 
 namespace realm {
 
@@ -184,6 +185,7 @@ std::vector<ObjKey> LinkMap::get_origin_ndxs(ObjKey key, size_t column) const
     auto origin_col = m_link_column_keys[column];
     auto origin = m_tables[column];
     auto link_type = m_link_types[column];
+    origin->report_invalid_key(origin_col);
     if (link_type == col_type_BackLink) {
         auto link_table = origin->get_opposite_table(origin_col);
         ColKey link_col_ndx = origin->get_opposite_column(origin_col);
@@ -217,6 +219,20 @@ std::vector<ObjKey> LinkMap::get_origin_ndxs(ObjKey key, size_t column) const
     return ret;
 }
 
+std::vector<ObjKey> find_matching_keys(const Query& query)
+{
+    ConstTableView tv(query.m_table);
+    query.find_all(tv);
+    size_t sz = tv.size();
+    std::vector<ObjKey> keys;
+    keys.reserve(sz);
+    for (size_t i = 0; i < sz; i++) {
+        keys.push_back(tv.get_key(i));
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
 void Columns<Link>::evaluate(size_t index, ValueBase& destination)
 {
     // Destination must be of Key type. It only makes sense to
@@ -60,7 +60,7 @@ Operator: public Subexpr2
 
 Value<T>: public Subexpr2
     void evaluate(size_t i, ValueBase* destination)
-    T m_v[8];
+    NullableVector<T> m_storage;
 
 Columns<T>: public Subexpr2
     void evaluate(size_t i, ValueBase* destination)
@@ -83,10 +83,13 @@ size_t Compare<Greater>::find_first()-------------+
                                                Value<float>::evaluate()    Columns<float>::evaluate()
 
 Operator, Value and Columns have an evaluate(size_t i, ValueBase* destination) method which returns a Value<T>
-containing 8 values representing table rows i...i + 7.
+containing up to ValueBase::chunk_size (256) values representing table rows i...i + 255, or fewer if the end of
+the current leaf is reached. A caller needing fewer rows passes the number to evaluate(i, destination, max_rows).
 
-So Value<T> contains 8 concecutive values and all operations are based on these chunks. This is
+So Value<T> contains a batch of concecutive values and all operations are based on these batches. This is
 to save overhead by virtual calls needed for evaluating a query that has been dynamically constructed at runtime.
+When no value in a batch is null, Operator and Compare run plain loops over the raw values which the compiler can
+vectorize. Values coming from link lists are still evaluated one row at a time.
 
 
 Memory allocation:
@@ -342,7 +345,7 @@ struct Common<T1, T2, true, false, b> {
 
 
 struct ValueBase {
-    static const size_t chunk_size = 8;
+    static constexpr size_t chunk_size = 256;
     virtual void export_bool(ValueBase& destination) const = 0;
     virtual void export_Timestamp(ValueBase& destination) const = 0;
     virtual void export_ObjectId(ValueBase& destination) const = 0;
@@ -373,8 +376,11 @@ public:
     {
     }
 
-    virtual double init()
+    // 'will_query_ranges' is false if only single objects will be evaluated, like for a query restricted to a
+    // view
+    virtual double init(bool will_query_ranges)
     {
+        static_cast<void>(will_query_ranges);
         return 50.0; // Default dT
     }
 
@@ -384,6 +390,11 @@ public:
     virtual void collect_dependencies(std::vector<TableKey>&) const
     {
     }
+    // Returns true if the expression reads values of other objects through links or backlinks
+    virtual bool follows_links() const
+    {
+        return false;
+    }
     virtual ConstTableRef get_base_table() const = 0;
     virtual std::string description(util::serializer::SerialisationState& state) const = 0;
 
@@ -396,6 +407,8 @@ std::unique_ptr<Expression> make_expression(Args&&... args)
     return std::unique_ptr<Expression>(new T(std::forward<Args>(args)...));
 }
 
+class LinkMap;
+
 class Subexpr {
 public:
     virtual ~Subexpr()
@@ -431,6 +444,12 @@ public:
     {
     }
 
+    // Returns true if the expression reads values of other objects through links or backlinks
+    virtual bool follows_links() const
+    {
+        return false;
+    }
+
     virtual bool has_constant_evaluation() const
     {
         return false;
@@ -446,9 +465,33 @@ public:
         return {};
     }
 
+    // Called every time the query containing this expression is about to be executed. 'will_query_ranges' is
+    // false if only single objects will be evaluated
+    virtual void init_evaluation(bool)
+    {
+    }
+
+    // If this expression reads a column through links, return the link path...
+    virtual const LinkMap* get_target_links() const
+    {
+        return nullptr;
+    }
+    // ...and an expression reading the same column directly from the target table of the link path
+    virtual std::unique_ptr<Subexpr> get_target_column() const
+    {
+        return nullptr;
+    }
+
     virtual DataType get_type() const = 0;
 
     virtual void evaluate(size_t index, ValueBase& destination) = 0;
+    // Like the above, but evaluates at most `max_rows` rows. Only expressions reading a batch of rows from a
+    // column make use of the limit.
+    virtual void evaluate(size_t index, ValueBase& destination, size_t max_rows)
+    {
+        static_cast<void>(max_rows);
+        evaluate(index, destination);
+    }
     // This function supports SubColumnAggregate
     virtual void evaluate(ObjKey, ValueBase&)
     {
@@ -945,10 +988,20 @@ struct NullableVector {
             while (std::find(m_first, m_first + m_size, static_cast<int64_t>(candidate)) != m_first + m_size)
                 candidate += 0xfffffffbULL;
             std::replace(m_first, m_first + m_size, m_null, static_cast<int64_t>(candidate));
+            m_null = static_cast<int64_t>(candidate);
         }
         m_first[index] = value;
     }
 
+    // Must be called after writing non-null values directly into m_first, in case one of them happens to
+    // collide with the magic null value
+    template <typename Type = t_storage>
+    typename std::enable_if<std::is_same_v<Type, int64_t>, void>::type pick_unused_null()
+    {
+        while (std::find(m_first, m_first + m_size, m_null) != m_first + m_size)
+            m_null = static_cast<int64_t>(static_cast<uint64_t>(m_null) + 0xfffffffbULL);
+    }
+
     template <typename Type = T>
     typename std::enable_if<realm::is_any<Type, float, double, BinaryData, StringData, ObjKey, Timestamp, ObjectId,
                                           Decimal128, ref_type, SizeOfList, null>::value,
@@ -988,17 +1041,13 @@ struct NullableVector {
 
     void init(size_t size)
     {
-        if (size == m_size)
-            return;
-
-        dealloc();
-        m_size = size;
-        if (m_size > 0) {
-            if (m_size > prealloc)
-                m_first = reinterpret_cast<t_storage*>(new t_storage[m_size]);
-            else
-                m_first = m_cache;
+        // Storage is kept when shrinking so that buffers reused across batches are only allocated once
+        if (size > m_capacity) {
+            dealloc();
+            m_first = reinterpret_cast<t_storage*>(new t_storage[size]);
+            m_capacity = size;
         }
+        m_size = size;
     }
 
     void init(size_t size, T values)
@@ -1030,18 +1079,27 @@ struct NullableVector {
         }
     }
 
-    void dealloc()
+    bool has_null() const
     {
-        if (m_first) {
-            if (m_size > prealloc)
-                delete[] m_first;
-            m_first = nullptr;
+        for (size_t t = 0; t < m_size; t++) {
+            if (is_null(t))
+                return true;
         }
+        return false;
+    }
+
+    void dealloc()
+    {
+        if (m_first != m_cache)
+            delete[] m_first;
+        m_first = m_cache;
+        m_capacity = prealloc;
     }
 
     t_storage m_cache[prealloc];
     t_storage* m_first = &m_cache[0];
     size_t m_size = 0;
+    size_t m_capacity = prealloc;
 
     int64_t m_null = reinterpret_cast<int64_t>(&m_null); // choose magic value to represent nulls
 };
@@ -1352,6 +1410,17 @@ public:
     }
 
 
+    // Repeat the single value of a constant so that it lines up with a batch of `values` rows
+    void broadcast(size_t values)
+    {
+        REALM_ASSERT_DEBUG(!ValueBase::m_from_link_list && ValueBase::m_values == 1);
+        auto v = m_storage.get(0);
+        init(false, values);
+        for (size_t i = 0; i < values; i++) {
+            m_storage.set(i, v);
+        }
+    }
+
     template <class TOperator>
     REALM_FORCEINLINE void fun(const Value* left, const Value* right)
     {
@@ -1362,6 +1431,23 @@ public:
             size_t min = std::min(left->m_values, right->m_values);
             init(false, min);
 
+            if constexpr (realm::is_any_v<T, int64_t, float, double>) {
+                if (!left->m_storage.has_null() && !right->m_storage.has_null()) {
+                    // No nulls to propagate, so operate directly on the raw values
+                    TOperator op;
+                    auto l = left->m_storage.m_first;
+                    auto r = right->m_storage.m_first;
+                    auto d = m_storage.m_first;
+                    for (size_t i = 0; i < min; i++) {
+                        d[i] = op(l[i], r[i]);
+                    }
+                    if constexpr (std::is_same_v<T, int64_t>) {
+                        m_storage.pick_unused_null();
+                    }
+                    return;
+                }
+            }
+
             for (size_t i = 0; i < min; i++) {
                 m_storage.set(i, o(left->m_storage.get(i), right->m_storage.get(i)));
             }
@@ -1409,6 +1495,13 @@ public:
     REALM_FORCEINLINE std::enable_if_t<std::is_convertible<T, D>::value> export2(ValueBase& destination) const
     {
         Value<D>& d = static_cast<Value<D>&>(destination);
+        if constexpr (std::is_same_v<T, D>) {
+            // Same representation, so the values and the nulls can be copied as they are
+            d.m_storage = m_storage;
+            d.ValueBase::m_from_link_list = ValueBase::m_from_link_list;
+            d.ValueBase::m_values = ValueBase::m_values;
+            return;
+        }
         d.init(ValueBase::m_from_link_list, ValueBase::m_values, D());
         for (size_t t = 0; t < ValueBase::m_values; t++) {
             if (m_storage.is_null(t))
@@ -1674,6 +1767,42 @@ public:
         return not_found; // no match
     }
 
+    // Evaluate TCond for the first `sz` rows of two values that do not come from link lists and store the
+    // outcome for each row in `matches`. If `left_is_const`, the single value of `left` is compared to every row.
+    template <class TCond>
+    static void compare_batch(const Value<T>* left, const Value<T>* right, bool left_is_const, size_t sz,
+                              bool* matches)
+    {
+        REALM_ASSERT_DEBUG(!left->m_from_link_list && !right->m_from_link_list);
+        TCond c;
+        const auto& l = left->m_storage;
+        const auto& r = right->m_storage;
+
+        if constexpr (realm::is_any_v<T, int64_t, float, double>) {
+            if (!l.has_null() && !r.has_null()) {
+                auto rv = r.m_first;
+                if (left_is_const) {
+                    auto lv = l.m_first[0];
+                    for (size_t m = 0; m < sz; m++) {
+                        matches[m] = c(lv, rv[m], false, false);
+                    }
+                }
+                else {
+                    auto lv = l.m_first;
+                    for (size_t m = 0; m < sz; m++) {
+                        matches[m] = c(lv[m], rv[m], false, false);
+                    }
+                }
+                return;
+            }
+        }
+
+        for (size_t m = 0; m < sz; m++) {
+            size_t lm = left_is_const ? 0 : m;
+            matches[m] = c(l[lm], r[m], l.is_null(lm), r.is_null(m));
+        }
+    }
+
     std::unique_ptr<Subexpr> clone() const override
     {
         return make_subexpr<Value<T>>(*this);
@@ -2380,6 +2509,11 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_link_map.has_links();
+    }
+
     void evaluate(size_t index, ValueBase& destination) override
     {
         if (links_exist()) {
@@ -2455,6 +2589,16 @@ public:
         return m_link_map.has_links();
     }
 
+    const LinkMap* get_target_links() const override
+    {
+        return links_exist() ? &m_link_map : nullptr;
+    }
+
+    std::unique_ptr<Subexpr> get_target_column() const override
+    {
+        return make_subexpr<Columns<T>>(m_column_key, m_link_map.get_target_table());
+    }
+
     bool only_unary_links() const
     {
         return m_link_map.only_unary_links();
@@ -2705,6 +2849,11 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_link_map.has_links();
+    }
+
     // Return main table of query (table on which table->where()... is invoked). Note that this is not the same as
     // any linked-to payload tables
     ConstTableRef get_base_table() const override
@@ -2783,6 +2932,11 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_link_map.has_links();
+    }
+
     void evaluate(size_t index, ValueBase& destination) override
     {
         size_t count = m_link_map.count_links(index);
@@ -2852,6 +3006,12 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        // The backlinks are read from the objects linking to this one
+        return true;
+    }
+
     void evaluate(size_t index, ValueBase& destination) override
     {
         size_t count;
@@ -2906,6 +3066,16 @@ public:
         m_expr->set_cluster(cluster);
     }
 
+    void collect_dependencies(std::vector<TableKey>& tables) const override
+    {
+        m_expr->collect_dependencies(tables);
+    }
+
+    bool follows_links() const override
+    {
+        return m_expr->follows_links();
+    }
+
     // Recursively fetch tables of columns in expression tree. Used when user first builds a stand-alone expression
     // and binds it to a Query at a later time
     ConstTableRef get_base_table() const override
@@ -3073,6 +3243,11 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_link_map.has_links();
+    }
+
     std::string description(util::serializer::SerialisationState& state) const override
     {
         return state.describe_expression_type(m_comparison_type) + state.describe_columns(m_link_map, ColKey());
@@ -3203,6 +3378,11 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return links_exist();
+    }
+
     void evaluate(size_t index, ValueBase& destination) override
     {
         if constexpr (std::is_same_v<T, ObjectId> || std::is_same_v<T, Int> || std::is_same_v<T, Bool>) {
@@ -3224,6 +3404,38 @@ public:
         return ColumnListBase::m_comparison_type;
     }
 
+    bool has_search_index() const override
+    {
+        return m_link_map.get_target_table()->has_search_index(m_column_key);
+    }
+
+    std::vector<ObjKey> find_all(Mixed value) const override
+    {
+        std::vector<ObjKey> ret;
+        std::vector<ObjKey> result;
+
+        if (value.is_null() && !m_column_key.is_nullable()) {
+            return ret;
+        }
+
+        StringIndex* index = m_link_map.get_target_table()->get_search_index(m_column_key);
+        REALM_ASSERT(index);
+        if (value.is_null()) {
+            index->find_all(result, realm::null{});
+        }
+        else {
+            T val = value.get<T>();
+            index->find_all(result, val);
+        }
+
+        for (ObjKey k : result) {
+            auto ndxs = m_link_map.get_origin_ndxs(k);
+            ret.insert(ret.end(), ndxs.begin(), ndxs.end());
+        }
+
+        return ret;
+    }
+
     SizeOperator<SizeOfList> size();
 
     ColumnListElementLength<T> element_lengths() const
@@ -3389,6 +3601,11 @@ public:
         m_list.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_list.follows_links();
+    }
+
     std::unique_ptr<Subexpr> clone() const override
     {
         return std::unique_ptr<Subexpr>(new ColumnListElementLength<T>(*this));
@@ -3458,6 +3675,11 @@ public:
         m_list.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_list.follows_links();
+    }
+
     void evaluate(size_t index, ValueBase& destination) override
     {
         if constexpr (std::is_same_v<T, ObjectId> || std::is_same_v<T, Int> || std::is_same_v<T, Bool>) {
@@ -3692,6 +3914,11 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return links_exist();
+    }
+
     // Recursively fetch tables of columns in expression tree. Used when user first builds a stand-alone expression
     // and binds it to a Query at a later time
     ConstTableRef get_base_table() const override
@@ -3700,7 +3927,7 @@ public:
     }
 
     template <class LeafType2 = LeafType>
-    void evaluate_internal(size_t index, ValueBase& destination)
+    void evaluate_internal(size_t index, ValueBase& destination, size_t max_rows)
     {
         using U = typename LeafType2::value_type;
 
@@ -3726,31 +3953,30 @@ public:
             // Not a Link column
             size_t colsize = leaf->size();
 
-            // Now load `ValueBase::chunk_size` rows from from the leaf into m_storage. If it's an integer
-            // leaf, then it contains the method get_chunk() which copies these values in a super fast way (first
-            // case of the `if` below. Otherwise, copy the values one by one in a for-loop (the `else` case).
-            if (std::is_same_v<U, int64_t> && index + ValueBase::chunk_size <= colsize) {
-                Value<int64_t> v(false, ValueBase::chunk_size);
+            // Now load up to `max_rows` rows from the leaf into m_storage. If it's an integer leaf, then it
+            // contains the method get_chunk() which copies 8 values at a time in a super fast way. Otherwise, copy
+            // the values one by one in a for-loop.
+            size_t rows = std::min(colsize - index, std::min(std::max(max_rows, size_t(1)), ValueBase::chunk_size));
+            using V = typename util::RemoveOptional<U>::type;
 
-                // If you want to modify 'chunk_size' then update Array::get_chunk()
-                REALM_ASSERT_3(ValueBase::chunk_size, ==, 8);
+            Value<V> v(false, rows);
 
+            size_t t = 0;
+            if constexpr (std::is_same_v<U, int64_t>) {
                 auto leaf_2 = static_cast<const Array*>(leaf);
-                leaf_2->get_chunk(index, v.m_storage.m_first);
-
-                destination.import(v);
+                // get_chunk() always reads 8 values
+                for (; t + 8 <= rows; t += 8)
+                    leaf_2->get_chunk(index + t, v.m_storage.m_first + t);
+                for (; t < rows; t++)
+                    v.m_storage.m_first[t] = leaf->get(index + t);
+                v.m_storage.pick_unused_null();
             }
             else {
-                size_t rows = colsize - index;
-                if (rows > ValueBase::chunk_size)
-                    rows = ValueBase::chunk_size;
-                Value<typename util::RemoveOptional<U>::type> v(false, rows);
-
-                for (size_t t = 0; t < rows; t++)
+                for (; t < rows; t++)
                     v.m_storage.set(t, leaf->get(index + t));
-
-                destination.import(v);
             }
+
+            destination.import(v);
         }
     }
 
@@ -3761,15 +3987,20 @@ public:
 
     // Load values from Column into destination
     void evaluate(size_t index, ValueBase& destination) override
+    {
+        evaluate(index, destination, ValueBase::chunk_size);
+    }
+
+    void evaluate(size_t index, ValueBase& destination, size_t max_rows) override
     {
         if (m_nullable && std::is_same_v<typename LeafType::value_type, int64_t>) {
-            evaluate_internal<ArrayIntNull>(index, destination);
+            evaluate_internal<ArrayIntNull>(index, destination, max_rows);
         }
         else if (m_nullable && std::is_same_v<typename LeafType::value_type, bool>) {
-            evaluate_internal<ArrayBoolNull>(index, destination);
+            evaluate_internal<ArrayBoolNull>(index, destination, max_rows);
         }
         else {
-            evaluate_internal<LeafType>(index, destination);
+            evaluate_internal<LeafType>(index, destination, max_rows);
         }
     }
 
@@ -3800,6 +4031,16 @@ public:
         return m_link_map.has_links();
     }
 
+    const LinkMap* get_target_links() const override
+    {
+        return links_exist() ? &m_link_map : nullptr;
+    }
+
+    std::unique_ptr<Subexpr> get_target_column() const override
+    {
+        return make_subexpr<Columns<T>>(m_column_key, m_link_map.get_target_table());
+    }
+
     bool only_unary_links() const
     {
         return m_link_map.only_unary_links();
@@ -3882,6 +4123,11 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_link_map.has_links();
+    }
+
     void evaluate(size_t, ValueBase&) override
     {
         // SubColumns can only be used in an expression in conjunction with its aggregate methods.
@@ -3958,6 +4204,11 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_link_map.has_links();
+    }
+
     void evaluate(size_t index, ValueBase& destination) override
     {
         std::vector<ObjKey> keys = m_link_map.get_links(index);
@@ -3993,6 +4244,9 @@ private:
     LinkMap m_link_map;
 };
 
+// Keys, in ascending order, of all objects matching `query`
+std::vector<ObjKey> find_matching_keys(const Query& query);
+
 class SubQueryCount : public Subexpr2<Int> {
 public:
     SubQueryCount(const Query& q, const LinkMap& link_map)
@@ -4024,16 +4278,43 @@ public:
         m_link_map.collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        // The subquery is evaluated for the linked objects
+        return true;
+    }
+
+    void init_evaluation(bool will_query_ranges) override
+    {
+        m_matching_keys.clear();
+        m_has_matching_keys = false;
+        // Evaluate the subquery once for the whole target table rather than once per link, but only
+        // when all rows will be checked and the target table is not larger than the base table
+        if (will_query_ranges && m_link_map.get_target_table()->size() <= m_link_map.get_base_table()->size()) {
+            m_matching_keys = find_matching_keys(m_query);
+            m_has_matching_keys = true;
+        }
+        else {
+            // The subquery is evaluated for the linked objects one by one
+            m_query.init(false);
+        }
+    }
+
     void evaluate(size_t index, ValueBase& destination) override
     {
         std::vector<ObjKey> links = m_link_map.get_links(index);
-        // std::sort(links.begin(), links.end());
-        m_query.init();
-
-        size_t count = std::accumulate(links.begin(), links.end(), size_t(0), [this](size_t running_count, ObjKey k) {
-            ConstObj obj = m_link_map.get_target_table()->get_object(k);
-            return running_count + m_query.eval_object(obj);
-        });
+        size_t count;
+        if (m_has_matching_keys) {
+            count = std::count_if(links.begin(), links.end(), [this](ObjKey k) {
+                return std::binary_search(m_matching_keys.begin(), m_matching_keys.end(), k);
+            });
+        }
+        else {
+            count = std::accumulate(links.begin(), links.end(), size_t(0), [this](size_t running_count, ObjKey k) {
+                ConstObj obj = m_link_map.get_target_table()->get_object(k);
+                return running_count + m_query.eval_object(obj);
+            });
+        }
 
         destination.import(Value<Int>(false, 1, size_t(count)));
     }
@@ -4058,6 +4339,8 @@ public:
 private:
     Query m_query;
     LinkMap m_link_map;
+    std::vector<ObjKey> m_matching_keys;
+    bool m_has_matching_keys = false;
 };
 
 // The unused template parameter is a hack to avoid a circular dependency between table.hpp and query_expression.hpp.
@@ -4289,11 +4572,21 @@ public:
         m_left->set_cluster(cluster);
     }
 
+    void init_evaluation(bool will_query_ranges) override
+    {
+        m_left->init_evaluation(will_query_ranges);
+    }
+
     void collect_dependencies(std::vector<TableKey>& tables) const override
     {
         m_left->collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_left->follows_links();
+    }
+
     // Recursively fetch tables of columns in expression tree. Used when user first builds a stand-alone expression
     // and binds it to a Query at a later time
     ConstTableRef get_base_table() const override
@@ -4303,10 +4596,15 @@ public:
 
     // destination = operator(left)
     void evaluate(size_t index, ValueBase& destination) override
+    {
+        evaluate(index, destination, ValueBase::chunk_size);
+    }
+
+    void evaluate(size_t index, ValueBase& destination, size_t max_rows) override
     {
         Value<T> result;
         Value<T> left;
-        m_left->evaluate(index, left);
+        m_left->evaluate(index, left, max_rows);
         result.template fun<oper>(&left);
         destination.import(result);
     }
@@ -4370,6 +4668,23 @@ public:
         m_right->set_cluster(cluster);
     }
 
+    void init_evaluation(bool will_query_ranges) override
+    {
+        m_left->init_evaluation(will_query_ranges);
+        m_right->init_evaluation(will_query_ranges);
+    }
+
+    void collect_dependencies(std::vector<TableKey>& tables) const override
+    {
+        m_left->collect_dependencies(tables);
+        m_right->collect_dependencies(tables);
+    }
+
+    bool follows_links() const override
+    {
+        return m_left->follows_links() || m_right->follows_links();
+    }
+
     // Recursively fetch tables of columns in expression tree. Used when user first builds a stand-alone expression
     // and
     // binds it to a Query at a later time
@@ -4388,13 +4703,24 @@ public:
     // destination = operator(left, right)
     void evaluate(size_t index, ValueBase& destination) override
     {
-        Value<T> result;
-        Value<T> left;
-        Value<T> right;
-        m_left->evaluate(index, left);
-        m_right->evaluate(index, right);
-        result.template fun<oper>(&left, &right);
-        destination.import(result);
+        evaluate(index, destination, ValueBase::chunk_size);
+    }
+
+    void evaluate(size_t index, ValueBase& destination, size_t max_rows) override
+    {
+        m_left->evaluate(index, m_left_value, max_rows);
+        m_right->evaluate(index, m_right_value, max_rows);
+
+        // A constant operand holds a single value which must be repeated to match a batch of rows
+        if (!m_left_value.m_from_link_list && !m_right_value.m_from_link_list) {
+            if (m_right_value.m_values == 1 && m_left_value.m_values > 1 && m_right->has_constant_evaluation())
+                m_right_value.broadcast(m_left_value.m_values);
+            else if (m_left_value.m_values == 1 && m_right_value.m_values > 1 && m_left->has_constant_evaluation())
+                m_left_value.broadcast(m_right_value.m_values);
+        }
+
+        m_result.template fun<oper>(&m_left_value, &m_right_value);
+        destination.import(m_result);
     }
 
     virtual std::string description(util::serializer::SerialisationState& state) const override
@@ -4419,6 +4745,10 @@ private:
     typedef typename oper::type T;
     std::unique_ptr<TLeft> m_left;
     std::unique_ptr<TRight> m_right;
+    // Buffers for the operands and the result, kept to avoid reallocating them for every batch
+    Value<T> m_left_value;
+    Value<T> m_right_value;
+    Value<T> m_result;
 };
 
 namespace {
@@ -4464,11 +4794,27 @@ public:
             m_left->set_cluster(cluster);
             m_right->set_cluster(cluster);
         }
+        m_batch_start = m_batch_end = 0;
     }
 
-    double init() override
+    double init(bool will_query_ranges) override
     {
+        m_batch_start = m_batch_end = 0;
+        m_has_matches = false;
+        m_matches.clear();
+        m_target_links = nullptr;
+        m_target_keys.clear();
+        m_left->init_evaluation(will_query_ranges);
+        m_right->init_evaluation(will_query_ranges);
+
         double dT = m_left_is_const ? 10.0 : 50.0;
+        // Evaluating the condition on the whole target table only pays off when all rows will be checked
+        if (will_query_ranges && m_left_is_const && m_right->get_comparison_type() == ExpressionComparisonType::Any &&
+            !(std::is_same_v<TCond, Equal> && m_right->has_search_index())) {
+            if (const LinkMap* link_map = m_right->get_target_links()) {
+                return init_semi_join(*link_map, dT);
+            }
+        }
         if (std::is_same_v<TCond, Equal> && m_left_is_const && m_right->has_search_index() &&
             m_right->get_comparison_type() == ExpressionComparisonType::Any) {
             if (m_left_value.m_storage.is_null(0)) {
@@ -4517,6 +4863,11 @@ public:
         m_right->collect_dependencies(tables);
     }
 
+    bool follows_links() const override
+    {
+        return m_left->follows_links() || m_right->follows_links();
+    }
+
     size_t find_first(size_t start, size_t end) const override
     {
         if (m_has_matches) {
@@ -4557,36 +4908,60 @@ public:
             return m_cluster->lower_bound_key(ObjKey(actual_key.value - m_cluster->get_offset()));
         }
 
-        size_t match;
-        Value<T> right;
-        const ExpressionComparisonType right_cmp_type = m_right->get_comparison_type();
-        if (m_left_is_const) {
-            for (; start < end;) {
-                m_right->evaluate(start, right);
-                match = Value<T>::template compare_const<TCond>(&m_left_value, &right, right_cmp_type);
-                if (match != not_found && match + start < end)
-                    return start + match;
-
-                size_t rows = (m_left_value.m_from_link_list || right.m_from_link_list)
-                                  ? 1
-                                  : minimum(right.m_values, m_left_value.m_values);
-                start += rows;
+        if (m_target_links) {
+            // Semi-join: the row matches if it links to one of the matching target objects
+            for (; start < end; ++start) {
+                for (ObjKey k : m_target_links->get_links(start)) {
+                    if (std::binary_search(m_target_keys.begin(), m_target_keys.end(), k))
+                        return start;
+                }
             }
+            return not_found;
         }
-        else {
-            Value<T> left;
-            const ExpressionComparisonType left_cmp_type = m_left->get_comparison_type();
-            for (; start < end;) {
-                m_left->evaluate(start, left);
-                m_right->evaluate(start, right);
-                match = Value<T>::template compare<TCond>(&left, &right, left_cmp_type, right_cmp_type);
-                if (match != not_found && match + start < end)
-                    return start + match;
-
-                size_t rows =
-                    (left.m_from_link_list || right.m_from_link_list) ? 1 : minimum(right.m_values, left.m_values);
-                start += rows;
+
+        const ExpressionComparisonType right_cmp_type = m_right->get_comparison_type();
+        const ExpressionComparisonType left_cmp_type =
+            m_left_is_const ? ExpressionComparisonType::Any : m_left->get_comparison_type();
+        for (; start < end;) {
+            // Rows already evaluated by a previous call are looked up in the match buffer
+            if (start >= m_batch_start && start < m_batch_end) {
+                size_t last = std::min(end, m_batch_end);
+                const bool* first = m_batch_matches + (start - m_batch_start);
+                const bool* stop = m_batch_matches + (last - m_batch_start);
+                const bool* p = std::find(first, stop, true);
+                if (p != stop)
+                    return m_batch_start + (p - m_batch_matches);
+                start = last;
+                continue;
+            }
+
+            size_t wanted = std::min(end - start, ValueBase::chunk_size);
+            m_right->evaluate(start, m_right_batch, wanted);
+            const Value<T>* left = &m_left_value;
+            if (!m_left_is_const) {
+                m_left->evaluate(start, m_left_batch, wanted);
+                left = &m_left_batch;
             }
+
+            if (left->m_from_link_list || m_right_batch.m_from_link_list) {
+                // One row at a time
+                size_t match =
+                    m_left_is_const
+                        ? Value<T>::template compare_const<TCond>(left, &m_right_batch, right_cmp_type)
+                        : Value<T>::template compare<TCond>(&m_left_batch, &m_right_batch, left_cmp_type,
+                                                            right_cmp_type);
+                if (match != not_found)
+                    return start;
+                start++;
+                continue;
+            }
+
+            size_t rows = m_left_is_const ? m_right_batch.m_values : minimum(m_right_batch.m_values, left->m_values);
+            if (rows == 0)
+                break;
+            Value<T>::template compare_batch<TCond>(left, &m_right_batch, m_left_is_const, rows, m_batch_matches);
+            m_batch_start = start;
+            m_batch_end = start + rows;
         }
 
         return not_found; // no match
@@ -4611,6 +4986,47 @@ public:
     }
 
 private:
+    // Evaluate `m_left_value TCond column` once on the target table of the link path instead of once per
+    // link per row. If the matching target objects are fewer than the rows to check, their backlinks give the
+    // matching rows directly. Otherwise each row is tested for linking to one of them.
+    double init_semi_join(const LinkMap& link_map, double dT)
+    {
+        // A row without links compares as null, so this is only valid if null does not match
+        if (TCond()(m_left_value.m_storage[0], T(), m_left_value.m_storage.is_null(0), true))
+            return dT;
+
+        // Scanning the target table must not cost more than following the links of every row, which visits at
+        // least one target object per row
+        if (link_map.get_target_table()->size() > link_map.get_base_table()->size())
+            return dT;
+
+        std::unique_ptr<Subexpr> target_column = m_right->get_target_column();
+        if (!target_column)
+            return dT;
+        Query target_query(make_expression<Compare<TCond, T>>(m_left->clone(), std::move(target_column)));
+        std::vector<ObjKey> target_keys = find_matching_keys(target_query);
+
+        if (target_keys.size() <= link_map.get_base_table()->size()) {
+            for (auto k : target_keys) {
+                for (auto origin : link_map.get_origin_ndxs(k)) {
+                    if (origin && !origin.is_unresolved())
+                        m_matches.push_back(origin);
+                }
+            }
+            std::sort(m_matches.begin(), m_matches.end());
+            m_matches.erase(std::unique(m_matches.begin(), m_matches.end()), m_matches.end());
+
+            m_has_matches = true;
+            m_index_get = 0;
+            m_index_end = m_matches.size();
+            return 0;
+        }
+
+        m_target_keys = std::move(target_keys);
+        m_target_links = &link_map;
+        return dT;
+    }
+
     Compare(const Compare& other)
         : m_left(other.m_left->clone())
         , m_right(other.m_right->clone())
@@ -4630,6 +5046,15 @@ private:
     std::vector<ObjKey> m_matches;
     mutable size_t m_index_get = 0;
     size_t m_index_end = 0;
+    const LinkMap* m_target_links = nullptr;
+    std::vector<ObjKey> m_target_keys;
+
+    // Outcome of the comparison for rows [m_batch_start, m_batch_end) of the current cluster
+    mutable Value<T> m_left_batch;
+    mutable Value<T> m_right_batch;
+    mutable bool m_batch_matches[ValueBase::chunk_size];
+    mutable size_t m_batch_start = 0;
+    mutable size_t m_batch_end = 0;
 };
 }
 #endif // REALM_QUERY_EXPRESSION_HPP
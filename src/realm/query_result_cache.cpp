@@ -0,0 +1,116 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/query_result_cache.hpp>
+
+using namespace realm;
+
+namespace {
+
+size_t entry_size(const std::string& key, const TableVersions& versions, const QueryResultCache::Result& result)
+{
+    // Approximate, including the bookkeeping of the list and the index
+    return sizeof(QueryResultCache::Result) + 2 * key.size() + versions.size() * sizeof(TableVersions::value_type) +
+           result.keys.size() * sizeof(ObjKey) + 128;
+}
+
+// Unlike TableVersions::operator==, this also compares the table keys, as
+// queries on different tables can have the same description
+bool same_versions(const TableVersions& a, const TableVersions& b)
+{
+    return static_cast<const std::vector<std::pair<TableKey, uint64_t>>&>(a) ==
+           static_cast<const std::vector<std::pair<TableKey, uint64_t>>&>(b);
+}
+
+} // anonymous namespace
+
+QueryResultCache::QueryResultCache(size_t memory_budget)
+    : m_memory_budget(memory_budget)
+{
+}
+
+bool QueryResultCache::lookup(const std::string& key, const TableVersions& versions, Result& result)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        ++m_misses;
+        return false;
+    }
+    if (!same_versions(it->second->versions, versions)) {
+        // One of the tables has changed since
+        erase(it->second);
+        ++m_misses;
+        return false;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    result = it->second->result;
+    ++m_hits;
+    return true;
+}
+
+void QueryResultCache::insert(const std::string& key, const TableVersions& versions, Result result)
+{
+    size_t size = entry_size(key, versions, result);
+    if (size > m_memory_budget)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it != m_index.end())
+        erase(it->second);
+    while (m_memory_usage + size > m_memory_budget)
+        erase(std::prev(m_entries.end()));
+
+    m_entries.push_front(Entry{key, versions, std::move(result), size});
+    m_index.emplace(key, m_entries.begin());
+    m_memory_usage += size;
+}
+
+void QueryResultCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_index.clear();
+    m_entries.clear();
+    m_memory_usage = 0;
+}
+
+size_t QueryResultCache::get_memory_usage() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory_usage;
+}
+
+size_t QueryResultCache::get_hit_count() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+size_t QueryResultCache::get_miss_count() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+void QueryResultCache::erase(EntryList::iterator it)
+{
+    m_memory_usage -= it->size;
+    m_index.erase(it->key);
+    m_entries.erase(it);
+}
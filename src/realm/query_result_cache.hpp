@@ -0,0 +1,90 @@
+/*************************************************************************
+ *
+ * Copyright 2020 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_QUERY_RESULT_CACHE_HPP
+#define REALM_QUERY_RESULT_CACHE_HPP
+
+#include <realm/keys.hpp>
+#include <realm/mixed.hpp>
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace realm {
+
+/// Results of queries shared by all transactions of a DB, see
+/// DBOptions::query_result_cache_size. Results are stored under the
+/// description of the query and the operation performed, together with the
+/// committed versions of the tables the query depends on. A result is only
+/// returned if none of those tables have been changed since it was stored.
+///
+/// When the memory used by the results exceeds the budget, the least recently
+/// used results are evicted.
+class QueryResultCache {
+public:
+    struct Result {
+        std::vector<ObjKey> keys;
+        Mixed value;
+        size_t count = 0;
+        ObjKey key;
+    };
+
+    explicit QueryResultCache(size_t memory_budget);
+
+    /// Returns true and sets \a result if a result is stored under \a key for
+    /// the given table versions. A result stored for other versions is
+    /// discarded.
+    bool lookup(const std::string& key, const TableVersions& versions, Result& result);
+    void insert(const std::string& key, const TableVersions& versions, Result result);
+    void clear();
+
+    size_t get_memory_budget() const noexcept
+    {
+        return m_memory_budget;
+    }
+    size_t get_memory_usage() const;
+    size_t get_hit_count() const;
+    size_t get_miss_count() const;
+
+private:
+    struct Entry {
+        std::string key;
+        TableVersions versions;
+        Result result;
+        size_t size;
+    };
+    using EntryList = std::list<Entry>;
+
+    const size_t m_memory_budget;
+    mutable std::mutex m_mutex;
+    // Most recently used first
+    EntryList m_entries;
+    std::unordered_map<std::string, EntryList::iterator> m_index;
+    size_t m_memory_usage = 0;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+
+    void erase(EntryList::iterator it);
+};
+
+} // namespace realm
+
+#endif // REALM_QUERY_RESULT_CACHE_HPP
@@ -16,6 +16,7 @@
  *
  **************************************************************************/
 
+#include <cstring>
 #include <stdexcept>
 
 #ifdef REALM_DEBUG
@@ -564,7 +565,10 @@ void Table::populate_search_index(ColKey col_key)
         ObjKey key = o.get_key();
         DataType type = get_column_type(col_key);
 
-        if (type == type_Int) {
+        if (col_key.is_list()) {
+            index->insert_list(key); // Throws
+        }
+        else if (type == type_Int) {
             if (is_nullable(col_key)) {
                 Optional<int64_t> value = o.get<Optional<int64_t>>(col_key);
                 index->insert(key, value); // Throws
@@ -602,26 +606,58 @@ void Table::populate_search_index(ColKey col_key)
                 index->insert(key, value); // Throws
             }
         }
+        else if (type == type_Float) {
+            float value = o.get<float>(col_key);
+            index->insert(key, value); // Throws
+        }
+        else if (type == type_Double) {
+            double value = o.get<double>(col_key);
+            index->insert(key, value); // Throws
+        }
+        else if (type == type_Decimal) {
+            Decimal128 value = o.get<Decimal128>(col_key);
+            index->insert(key, value); // Throws
+        }
         else {
             REALM_ASSERT_RELEASE(false && "Data type does not support search index");
         }
     }
 }
 
-void Table::add_search_index(ColKey col_key)
+void Table::add_search_index(ColKey col_key, IndexType type)
 {
     check_column(col_key);
     size_t column_ndx = col_key.get_index().val;
 
-    // Early-out if already indexed
-    if (m_index_accessors[column_ndx] != nullptr)
+    if (type == IndexType::None) {
+        remove_search_index(col_key);
         return;
+    }
 
-    if (!StringIndex::type_supported(DataType(col_key.get_type())) || col_key.get_attrs().test(col_attr_List)) {
+    // Validate before touching an existing index, so that it is kept if the
+    // new kind is not allowed
+    if (!StringIndex::type_supported(DataType(col_key.get_type())) ||
+        (type == IndexType::CaseInsensitive && col_key.get_type() != col_type_String) ||
+        ((type == IndexType::NGram || type == IndexType::Fulltext) &&
+         (col_key.get_type() != col_type_String || col_key.is_list()))) {
         // FIXME: This is what we used to throw, so keep throwing that for compatibility reasons, even though it
         // should probably be a type mismatch exception instead.
         throw LogicError(LogicError::illegal_combination);
     }
+    // Primary key lookups rely on a general index
+    if (type != IndexType::General && col_key == get_primary_key_column())
+        throw LogicError(LogicError::illegal_combination);
+    // Older versions would read the index as a general one
+    if (type != IndexType::General)
+        check_file_format(21);
+
+    // Early-out if already indexed
+    if (StringIndex* index = m_index_accessors[column_ndx]) {
+        if (index->get_index_type() == type)
+            return;
+        // Replace the existing index
+        remove_search_index(col_key);
+    }
 
     // m_index_accessors always has the same number of pointers as the number of columns. Columns without search
     // index have 0-entries.
@@ -629,7 +665,7 @@ void Table::add_search_index(ColKey col_key)
     REALM_ASSERT(m_index_accessors[column_ndx] == nullptr);
 
     // Create the index
-    StringIndex* index = new StringIndex(ClusterColumn(&m_clusters, col_key), get_alloc()); // Throws
+    StringIndex* index = new StringIndex(ClusterColumn(&m_clusters, col_key, type), get_alloc()); // Throws
     m_index_accessors[column_ndx] = index;
 
     // Insert ref to index
@@ -640,11 +676,25 @@ void Table::add_search_index(ColKey col_key)
     auto spec_ndx = leaf_ndx2spec_ndx(col_key.get_index());
     auto attr = m_spec.get_column_attr(spec_ndx);
     attr.set(col_attr_Indexed);
+    if (type == IndexType::CaseInsensitive)
+        attr.set(col_attr_CaseInsensitive_Indexed);
+    if (type == IndexType::NGram)
+        attr.set(col_attr_NGram_Indexed);
+    if (type == IndexType::Fulltext)
+        attr.set(col_attr_FullText_Indexed);
     m_spec.set_column_attr(spec_ndx, attr); // Throws
 
     populate_search_index(col_key);
 }
 
+void Table::check_file_format(int file_format_version) const
+{
+    if (Group* group = get_parent_group()) {
+        if (_impl::GroupFriend::get_file_format_version(*group) < file_format_version)
+            throw LogicError(LogicError::file_format_too_old);
+    }
+}
+
 void Table::remove_search_index(ColKey col_key)
 {
     check_column(col_key);
@@ -667,6 +717,9 @@ void Table::remove_search_index(ColKey col_key)
     auto spec_ndx = leaf_ndx2spec_ndx(column_ndx);
     auto attr = m_spec.get_column_attr(spec_ndx);
     attr.reset(col_attr_Indexed);
+    attr.reset(col_attr_CaseInsensitive_Indexed);
+    attr.reset(col_attr_NGram_Indexed);
+    attr.reset(col_attr_FullText_Indexed);
     m_spec.set_column_attr(spec_ndx, attr); // Throws
 }
 
@@ -700,9 +753,119 @@ size_t Table::get_num_unique_values(ColKey col_key) const
 }
 
 
+namespace {
+// The statistics of a column are stored as an array holding the key of the column, the counts
+// and the bit patterns of the histogram boundaries.
+enum { s_stats_col_key, s_stats_row_count, s_stats_null_count, s_stats_distinct_count, s_stats_histogram };
+} // anonymous namespace
+
+void Table::update_statistics(ColKey col_key)
+{
+    check_column(col_key);
+    ColumnType type = col_key.get_type();
+    if (col_key.get_attrs().test(col_attr_List) || is_link_type(type) || type == col_type_BackLink)
+        throw LogicError(LogicError::illegal_type);
+
+    ColumnStatisticsBuilder builder;
+    for (auto& obj : *this) {
+        builder.add(obj.get_any(col_key));
+    }
+    ColumnStatistics stats = builder.get();
+
+    remove_statistics(col_key);
+    while (m_top.size() <= top_position_for_statistics)
+        m_top.add(0);
+    Array stats_refs(m_alloc);
+    stats_refs.set_parent(&m_top, top_position_for_statistics);
+    if (ref_type ref = m_top.get_as_ref(top_position_for_statistics)) {
+        stats_refs.init_from_ref(ref);
+    }
+    else {
+        stats_refs.create(Array::type_HasRefs); // Throws
+        stats_refs.update_parent();
+    }
+
+    Array entry(m_alloc);
+    entry.create(Array::type_Normal); // Throws
+    entry.add(col_key.value);
+    entry.add(int64_t(stats.row_count));
+    entry.add(int64_t(stats.null_count));
+    entry.add(int64_t(stats.distinct_count));
+    for (double d : stats.histogram) {
+        int64_t bits;
+        std::memcpy(&bits, &d, sizeof(bits));
+        entry.add(bits);
+    }
+    stats_refs.add(from_ref(entry.get_ref()));
+}
+
+void Table::update_statistics()
+{
+    for_each_public_column([this](ColKey col_key) {
+        ColumnType type = col_key.get_type();
+        if (!col_key.get_attrs().test(col_attr_List) && !is_link_type(type))
+            update_statistics(col_key);
+        return false;
+    });
+}
+
+util::Optional<ColumnStatistics> Table::get_statistics(ColKey col_key) const
+{
+    if (m_top.size() <= top_position_for_statistics)
+        return util::none;
+    ref_type ref = m_top.get_as_ref(top_position_for_statistics);
+    if (!ref)
+        return util::none;
+
+    Array stats_refs(m_alloc);
+    stats_refs.init_from_ref(ref);
+    for (size_t i = 0; i < stats_refs.size(); ++i) {
+        Array entry(m_alloc);
+        entry.init_from_ref(stats_refs.get_as_ref(i));
+        if (entry.get(s_stats_col_key) != col_key.value)
+            continue;
+
+        ColumnStatistics stats;
+        stats.row_count = uint64_t(entry.get(s_stats_row_count));
+        stats.null_count = uint64_t(entry.get(s_stats_null_count));
+        stats.distinct_count = uint64_t(entry.get(s_stats_distinct_count));
+        for (size_t j = s_stats_histogram; j < entry.size(); ++j) {
+            int64_t bits = entry.get(j);
+            double d;
+            std::memcpy(&d, &bits, sizeof(d));
+            stats.histogram.push_back(d);
+        }
+        return stats;
+    }
+    return util::none;
+}
+
+void Table::remove_statistics(ColKey col_key)
+{
+    if (m_top.size() <= top_position_for_statistics)
+        return;
+    ref_type ref = m_top.get_as_ref(top_position_for_statistics);
+    if (!ref)
+        return;
+
+    Array stats_refs(m_alloc);
+    stats_refs.set_parent(&m_top, top_position_for_statistics);
+    stats_refs.init_from_ref(ref);
+    for (size_t i = 0; i < stats_refs.size(); ++i) {
+        ref_type entry_ref = stats_refs.get_as_ref(i);
+        if (Array::get(m_alloc.translate(entry_ref), s_stats_col_key) == col_key.value) {
+            Array::destroy(entry_ref, m_alloc);
+            stats_refs.erase(i);
+            return;
+        }
+    }
+}
+
+
 void Table::erase_root_column(ColKey col_key)
 {
     check_column(col_key);
+    remove_statistics(col_key);
     ColumnType col_type = col_key.get_type();
     if (is_link_type(col_type)) {
         auto target_table = get_opposite_table(col_key);
@@ -770,7 +933,7 @@ void Table::do_erase_root_column(ColKey col_key)
     // If the column had a source index we have to remove and destroy that as well
     ref_type index_ref = m_index_refs.get_as_ref(col_ndx);
     if (index_ref) {
-        Array::destroy_deep(index_ref, m_index_refs.get_alloc());
+        destroy_deep_deferred(index_ref);
         m_index_refs.set(col_ndx, 0);
         delete m_index_accessors[col_ndx];
         m_index_accessors[col_ndx] = nullptr;
@@ -794,6 +957,49 @@ void Table::do_erase_root_column(ColKey col_key)
     bump_storage_version();
 }
 
+void Table::destroy_deep_deferred(ref_type ref) const
+{
+    if (Group* group = get_parent_group()) {
+        group->defer_destroy_deep(ref);
+    }
+    else {
+        Array::destroy_deep(ref, m_alloc);
+    }
+}
+
+void Table::set_cluster_node_size(size_t node_size)
+{
+    if (node_size != 0 && (node_size < 4 || node_size > 0x10000 || (node_size & (node_size - 1)) != 0))
+        throw LogicError(LogicError::illegal_combination);
+    if (!is_empty() || (m_tombstones && !m_tombstones->is_empty()))
+        throw LogicError(LogicError::illegal_combination);
+    // Older versions would ignore the size and misread the key ranges of the
+    // inner nodes
+    if (node_size != 0)
+        check_file_format(21);
+
+    while (m_top.size() <= top_position_for_cluster_node_size)
+        m_top.add(0);
+    m_top.set(top_position_for_cluster_node_size, RefOrTagged::make_tagged(node_size));
+
+    // The key ranges of compact inner nodes depend on the node size, so start
+    // over with a single empty cluster
+    CascadeState state(CascadeState::Mode::None);
+    m_clusters.clear(state);
+    if (m_tombstones)
+        m_tombstones->clear(state);
+    m_clusters.update_node_shift_factor();
+    if (m_tombstones)
+        m_tombstones->update_node_shift_factor();
+}
+
+size_t Table::get_stored_cluster_node_size() const noexcept
+{
+    if (m_top.size() <= top_position_for_cluster_node_size)
+        return 0;
+    return size_t(m_top.get_as_ref_or_tagged(top_position_for_cluster_node_size).get_as_int());
+}
+
 bool Table::set_embedded(bool embedded)
 {
     if (embedded == m_is_embedded)
@@ -888,7 +1094,27 @@ Table::~Table() noexcept
 
 bool Table::has_search_index(ColKey col_key) const noexcept
 {
-    return m_index_accessors[col_key.get_index().val] != nullptr;
+    StringIndex* index = m_index_accessors[col_key.get_index().val];
+    return index && index->get_index_type() == IndexType::General;
+}
+
+IndexType Table::search_index_type(ColKey col_key) const noexcept
+{
+    if (StringIndex* index = m_index_accessors[col_key.get_index().val])
+        return index->get_index_type();
+    return IndexType::None;
+}
+
+IndexType Table::get_index_type_from_spec(ColKey col_key) const noexcept
+{
+    auto attr = m_spec.get_column_attr(leaf_ndx2spec_ndx(col_key.get_index()));
+    if (attr.test(col_attr_CaseInsensitive_Indexed))
+        return IndexType::CaseInsensitive;
+    if (attr.test(col_attr_NGram_Indexed))
+        return IndexType::NGram;
+    if (attr.test(col_attr_FullText_Indexed))
+        return IndexType::Fulltext;
+    return IndexType::General;
 }
 
 void Table::migrate_column_info()
@@ -1622,7 +1848,7 @@ bool Table::is_list(ColKey col_key) const
 }
 
 
-ref_type Table::create_empty_table(Allocator& alloc, TableKey key)
+ref_type Table::create_empty_table(Allocator& alloc, TableKey key, uint64_t version)
 {
     Array top(alloc);
     _impl::DeepArrayDestroyGuard dg(&top);
@@ -1660,6 +1886,7 @@ ref_type Table::create_empty_table(Allocator& alloc, TableKey key)
     }
     rot = RefOrTagged::make_tagged(0);
     top.add(rot); // Column key
+    rot = RefOrTagged::make_tagged(version);
     top.add(rot); // Version
     dg.release();
     // Opposite keys (table and column)
@@ -1685,6 +1912,8 @@ ref_type Table::create_empty_table(Allocator& alloc, TableKey key)
     top.add(0); // pk col key
     top.add(0); // flags
     top.add(0); // tombstones
+    top.add(0); // statistics
+    top.add(0); // cluster node size
 
     REALM_ASSERT(top.size() == top_array_size);
 
@@ -1710,8 +1939,6 @@ void Table::ensure_graveyard()
 
 void Table::batch_erase_rows(const KeyColumn& keys)
 {
-    Group* g = get_parent_group();
-
     size_t num_objs = keys.size();
     std::vector<ObjKey> vec;
     vec.reserve(num_objs);
@@ -1724,21 +1951,29 @@ void Table::batch_erase_rows(const KeyColumn& keys)
     sort(vec.begin(), vec.end());
     vec.erase(unique(vec.begin(), vec.end()), vec.end());
 
+    do_remove_objects(vec);
+}
+
+void Table::do_remove_objects(const std::vector<ObjKey>& keys)
+{
+    Group* g = get_parent_group();
+
     if (has_any_embedded_objects() || (g && g->has_cascade_notification_handler())) {
         CascadeState state(CascadeState::Mode::Strong, g);
-        std::for_each(vec.begin(), vec.end(),
+        std::for_each(keys.begin(), keys.end(),
                       [this, &state](ObjKey k) { state.m_to_be_deleted.emplace_back(m_key, k); });
         nullify_links(state);
         remove_recursive(state);
     }
     else {
         CascadeState state(CascadeState::Mode::None, g);
-        for (auto k : vec) {
-            if (g) {
+        if (g && for_each_backlink_column([](ColKey) { return true; })) {
+            for (auto k : keys) {
                 m_clusters.nullify_links(k, state);
             }
-            m_clusters.erase(k, state);
         }
+        // Objects are erased leaf by leaf
+        m_clusters.erase(keys, state);
     }
 }
 
@@ -1807,8 +2042,8 @@ TableRef Table::get_link_target(ColKey col_key) noexcept
 
 size_t Table::count_int(ColKey col_key, int64_t value) const
 {
-    if (auto index = this->get_search_index(col_key)) {
-        return index->count(value);
+    if (has_search_index(col_key)) {
+        return get_search_index(col_key)->count(value);
     }
 
     size_t count;
@@ -1822,18 +2057,30 @@ size_t Table::count_int(ColKey col_key, int64_t value) const
 }
 size_t Table::count_float(ColKey col_key, float value) const
 {
+    if (has_search_index(col_key)) {
+        return get_search_index(col_key)->count(value);
+    }
+
     size_t count;
     aggregate<act_Count, float, float>(col_key, value, &count);
     return count;
 }
 size_t Table::count_double(ColKey col_key, double value) const
 {
+    if (has_search_index(col_key)) {
+        return get_search_index(col_key)->count(value);
+    }
+
     size_t count;
     aggregate<act_Count, double, double>(col_key, value, &count);
     return count;
 }
 size_t Table::count_decimal(ColKey col_key, Decimal128 value) const
 {
+    if (has_search_index(col_key)) {
+        return get_search_index(col_key)->count(value);
+    }
+
     ArrayDecimal128 leaf(get_alloc());
     size_t cnt = 0;
     bool null_value = value.is_null();
@@ -1855,8 +2102,8 @@ size_t Table::count_decimal(ColKey col_key, Decimal128 value) const
 }
 size_t Table::count_string(ColKey col_key, StringData value) const
 {
-    if (auto index = this->get_search_index(col_key)) {
-        return index->count(value);
+    if (has_search_index(col_key)) {
+        return get_search_index(col_key)->count(value);
     }
     size_t count;
     aggregate<act_Count, StringData, StringData>(col_key, value, &count);
@@ -2054,8 +2301,8 @@ ObjKey Table::find_first(ColKey col_key, T value) const
 
     // You cannot call GetIndexData on ObjKey
     if constexpr (!std::is_same_v<T, ObjKey>) {
-        if (StringIndex* index = get_search_index(col_key)) {
-            return index->find_first(value);
+        if (has_search_index(col_key)) {
+            return get_search_index(col_key)->find_first(value);
         }
 
         if (col_key == m_primary_key_col) {
@@ -2482,12 +2729,12 @@ void Table::refresh_index_accessors()
         }
         else if (has_old_accessor && ref != 0) { // still there, refresh:
             auto col_key = m_leaf_ndx2colkey[col_ndx];
-            ClusterColumn virtual_col(&m_clusters, col_key);
+            ClusterColumn virtual_col(&m_clusters, col_key, get_index_type_from_spec(col_key));
             m_index_accessors[col_ndx]->refresh_accessor_tree(virtual_col);
         }
         else if (!has_old_accessor && ref != 0) { // new index!
             auto col_key = m_leaf_ndx2colkey[col_ndx];
-            ClusterColumn virtual_col(&m_clusters, col_key);
+            ClusterColumn virtual_col(&m_clusters, col_key, get_index_type_from_spec(col_key));
             m_index_accessors[col_ndx] = new StringIndex(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
         }
     }
@@ -3010,6 +3257,135 @@ void Table::create_objects(const std::vector<ObjKey>& keys)
     }
 }
 
+void Table::bulk_insert(const std::vector<ObjKey>& keys, const std::vector<ColumnValues>& columns)
+{
+    if (m_is_embedded || m_primary_key_col)
+        throw LogicError(LogicError::wrong_kind_of_table);
+
+    // The leaves are attached before the backlinks and search indexes are
+    // updated, so check all arguments first, so that nothing is changed if one
+    // of them is wrong.
+    for (size_t i = 0; i < columns.size(); i++) {
+        ColKey col_key = columns[i].col_key;
+        check_column(col_key);
+        if (col_key.get_attrs().test(col_attr_List))
+            throw LogicError(LogicError::list_type_mismatch);
+        if (columns[i].values.size() != keys.size())
+            throw LogicError(LogicError::illegal_combination);
+        for (size_t j = 0; j < i; j++) {
+            if (columns[j].col_key == col_key)
+                throw LogicError(LogicError::illegal_combination);
+        }
+        check_column_values(col_key, columns[i].values);
+    }
+
+    bool ascending = true;
+    for (size_t i = 0; i < keys.size(); i++) {
+        if (keys[i].value < 0)
+            throw LogicError(LogicError::row_index_out_of_range);
+        if (i > 0 && keys[i].value <= keys[i - 1].value)
+            ascending = false;
+    }
+
+    if (ascending && (keys.empty() || keys.front().value > m_clusters.get_last_key_value())) {
+        m_clusters.bulk_insert(keys, columns);
+        return;
+    }
+
+    std::vector<ObjKey> sorted_keys = keys;
+    std::sort(sorted_keys.begin(), sorted_keys.end());
+    for (size_t i = 0; i < sorted_keys.size(); i++) {
+        if ((i > 0 && sorted_keys[i] == sorted_keys[i - 1]) || is_valid(sorted_keys[i]))
+            throw KeyAlreadyUsed("When inserting");
+    }
+
+    Replication* repl = get_repl();
+    FieldValues values;
+    for (size_t i = 0; i < keys.size(); i++) {
+        values.clear();
+        for (auto& c : columns)
+            values.emplace_back(c.col_key, c.values[i]);
+        if (repl)
+            repl->create_object(this, GlobalKey(keys[i], 0));
+        create_object(keys[i], values);
+    }
+}
+
+void Table::check_column_values(ColKey col_key, const std::vector<Mixed>& values) const
+{
+    auto type = col_key.get_type();
+    bool nullable = col_key.is_nullable();
+    TableRef target_table = type == col_type_Link ? get_opposite_table(col_key) : TableRef();
+    for (auto& value : values) {
+        if (value.is_null()) {
+            if (!nullable)
+                throw LogicError(LogicError::column_not_nullable);
+            continue;
+        }
+        if (type == col_type_OldMixed)
+            continue;
+        if (value.get_type() != DataType(type))
+            throw LogicError(LogicError::illegal_type);
+        if (target_table) {
+            if (!target_table->is_valid(value.get<ObjKey>()))
+                throw LogicError(LogicError::target_row_index_out_of_range);
+            if (target_table->is_embedded())
+                throw LogicError(LogicError::wrong_kind_of_table);
+        }
+    }
+}
+
+void Table::set_column_values(ColKey col_key, const std::vector<ObjKey>& keys, const std::vector<Mixed>& values)
+{
+    if (values.size() != keys.size())
+        throw LogicError(LogicError::illegal_combination);
+    do_set_column_values(col_key, keys, [&](size_t i) {
+        return values[i];
+    });
+}
+
+void Table::set_column_values(ColKey col_key, const std::vector<ObjKey>& keys, Mixed value)
+{
+    do_set_column_values(col_key, keys, [&](size_t) {
+        return value;
+    });
+}
+
+void Table::do_set_column_values(ColKey col_key, const std::vector<ObjKey>& keys,
+                                 util::FunctionRef<Mixed(size_t)> value_at)
+{
+    check_column(col_key);
+    if (col_key.get_attrs().test(col_attr_List))
+        throw LogicError(LogicError::list_type_mismatch);
+
+    auto type = col_key.get_type();
+    if (type == col_type_Link || type == col_type_OldMixed) {
+        // Links must update the backlinks of their targets one by one. Check all
+        // arguments first, so that nothing is changed if one of them is wrong.
+        TableRef target_table = type == col_type_Link ? get_opposite_table(col_key) : TableRef();
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (!is_valid(keys[i]))
+                throw KeyNotFound("No such object");
+            if (!target_table)
+                continue;
+            Mixed value = value_at(i);
+            if (value.is_null())
+                continue;
+            if (value.get_type() != type_Link)
+                throw LogicError(LogicError::illegal_type);
+            ObjKey target_key = value.get<ObjKey>();
+            if (!target_table->is_valid(target_key))
+                throw LogicError(LogicError::target_row_index_out_of_range);
+            if (target_table->is_embedded())
+                throw LogicError(LogicError::wrong_kind_of_table);
+        }
+        for (size_t i = 0; i < keys.size(); i++)
+            get_object(keys[i]).set(col_key, value_at(i));
+        return;
+    }
+    m_clusters.set_values(col_key, keys, value_at);
+}
+
 void Table::dump_objects()
 {
     m_clusters.dump_objects();
@@ -3036,6 +3412,39 @@ void Table::remove_object(ObjKey key)
     }
 }
 
+void Table::remove_objects(std::vector<ObjKey> keys)
+{
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (auto k : keys) {
+        if (k.is_unresolved() || !is_valid(k))
+            throw KeyNotFound("When removing objects");
+    }
+
+    do_remove_objects(keys);
+}
+
+size_t Table::remove_object_range(ObjKey begin, ObjKey end)
+{
+    std::vector<ObjKey> keys;
+    m_clusters.traverse_range(begin, end, [&](const Cluster* cluster) {
+        int64_t offset = cluster->get_offset();
+        size_t sz = cluster->node_size();
+        size_t ndx = begin.value > offset ? cluster->lower_bound_key(ObjKey(begin.value - offset)) : 0;
+        for (; ndx < sz; ndx++) {
+            ObjKey key = cluster->get_real_key(ndx);
+            if (!(key < end))
+                return true;
+            keys.push_back(key);
+        }
+        return false;
+    });
+
+    if (!keys.empty())
+        do_remove_objects(keys);
+    return keys.size();
+}
+
 void Table::invalidate_object(ObjKey key)
 {
     if (m_is_embedded)
@@ -3530,7 +3939,7 @@ ColKey Table::set_nullability(ColKey col_key, bool nullable, bool throw_on_null)
 
     check_column(col_key);
 
-    bool si = has_search_index(col_key);
+    IndexType index_type = search_index_type(col_key);
     std::string column_name(get_column_name(col_key));
     auto type = col_key.get_type();
     auto attr = col_key.get_attrs();
@@ -3557,8 +3966,8 @@ ColKey Table::set_nullability(ColKey col_key, bool nullable, bool throw_on_null)
     erase_root_column(col_key);
     m_spec.rename_column(colkey2spec_ndx(new_col), column_name);
 
-    if (si)
-        add_search_index(new_col);
+    if (index_type != IndexType::None)
+        add_search_index(new_col, index_type);
 
     if (is_pk_col) {
         // If we go from non nullable to nullable, no values change,
@@ -33,6 +33,7 @@
 #include <realm/spec.hpp>
 #include <realm/query.hpp>
 #include <realm/cluster_tree.hpp>
+#include <realm/column_statistics.hpp>
 #include <realm/keys.hpp>
 #include <realm/global_key.hpp>
 
@@ -58,6 +59,8 @@ class Columns;
 template <class>
 class SubQuery;
 class ColKeys;
+template <class>
+class ColumnScan;
 struct GlobalKey;
 class LinkChain;
 
@@ -123,6 +126,9 @@ public:
     ///
     static const size_t max_column_name_length = 63;
     static const uint64_t max_num_columns = 0xFFFFUL; // <-- must be power of two -1
+    /// Adding a column to a populated table creates a leaf of default values
+    /// in every cluster, so the cost is linear in the number of clusters. For
+    /// most types the leaf is created in one allocation.
     ColKey add_column(DataType type, StringData name, bool nullable = false);
     ColKey add_column_list(DataType type, StringData name, bool nullable = false);
 
@@ -138,18 +144,42 @@ public:
     bool set_embedded(bool embedded);
     //@}
 
+    /// The max number of objects in each cluster of this table, which is also
+    /// the max number of children of the inner nodes of the cluster tree.
+    /// Small clusters make point lookups and updates cheaper, large clusters
+    /// make scans faster. The size must be a power of two between 4 and 65536,
+    /// or zero to get the default size. It is part of the physical layout of
+    /// the table and is not replicated. Throws LogicError if the size is not
+    /// allowed or the table is not empty. Sizes other than the default require
+    /// file format 21.
+    void set_cluster_node_size(size_t node_size);
+    size_t get_cluster_node_size() const noexcept
+    {
+        return m_clusters.get_node_size();
+    }
+
     /// True for `col_type_Link` and `col_type_LinkList`.
     static bool is_link_type(ColumnType) noexcept;
 
     //@{
 
-    /// has_search_index() returns true if, and only if a search index has been
-    /// added to the specified column. Rather than throwing, it returns false if
-    /// the table accessor is detached or the specified index is out of range.
+    /// has_search_index() returns true if, and only if a general search index
+    /// has been added to the specified column. Rather than throwing, it returns
+    /// false if the table accessor is detached or the specified index is out of
+    /// range.
+    ///
+    /// search_index_type() returns the kind of search index on the specified
+    /// column, or IndexType::None if it has none.
     ///
-    /// add_search_index() adds a search index to the specified column of the
-    /// table. It has no effect if a search index has already been added to the
-    /// specified column (idempotency).
+    /// add_search_index() adds a search index of the specified kind to the
+    /// specified column of the table. It has no effect if a search index of
+    /// that kind has already been added to the specified column (idempotency).
+    /// An index of another kind is replaced. A case insensitive index can only
+    /// be added to a string column, and an n-gram or full-text index only to a
+    /// string column which is not a list. The primary key column can only have
+    /// a general index. An existing index is kept if the new kind is rejected.
+    /// Indexes of other kinds than general require file format 21, so they
+    /// cannot be added to a file of an older format opened without history.
     ///
     /// remove_search_index() removes the search index from the specified column
     /// of the table. It has no effect if the specified column has no search
@@ -159,7 +189,8 @@ public:
     /// \param col_key The key of a column of the table.
 
     bool has_search_index(ColKey col_key) const noexcept;
-    void add_search_index(ColKey col_key);
+    IndexType search_index_type(ColKey col_key) const noexcept;
+    void add_search_index(ColKey col_key, IndexType type = IndexType::General);
     void remove_search_index(ColKey col_key);
 
     void enumerate_string_column(ColKey col_key);
@@ -174,6 +205,20 @@ public:
     /// debugging purposes.
     size_t get_num_unique_values(ColKey col_key) const;
 
+    /// update_statistics() computes statistics about the values of the
+    /// specified column (see ColumnStatistics), or of all columns which are not
+    /// lists or links, and stores them in the file. Queries use them to order
+    /// their conditions, and to choose between a search index and a scan,
+    /// before execution starts. The statistics are not maintained as the table
+    /// changes, and are ignored by queries once the size of the table has
+    /// changed considerably, so they should be updated after bulk changes.
+    ///
+    /// get_statistics() returns the statistics last computed for the column,
+    /// if any.
+    void update_statistics(ColKey col_key);
+    void update_statistics();
+    util::Optional<ColumnStatistics> get_statistics(ColKey col_key) const;
+
     template <class T>
     Columns<T> column(ColKey col_key) const; // FIXME: Should this one have been declared noexcept?
     template <class T>
@@ -233,6 +278,24 @@ public:
     void create_objects(size_t number, std::vector<ObjKey>& keys);
     /// Create a number of objects with keys supplied
     void create_objects(const std::vector<ObjKey>& keys);
+    /// Create an object for each key, taking the values of each column in
+    /// \a columns from its list of values at the position of the key. Columns
+    /// not mentioned get their default value, and must not be lists.
+    ///
+    /// If the keys are ascending and bigger than the keys of all existing
+    /// objects, which is the case when loading into an empty table, the leaves
+    /// of the table are built directly from the values and attached to the
+    /// table as a whole. Otherwise the objects are created one by one.
+    void bulk_insert(const std::vector<ObjKey>& keys, const std::vector<ColumnValues>& columns);
+    /// Set the value of a column for each object in \a keys to the value at the
+    /// same position in \a values. The objects of each leaf are made writeable
+    /// once and written together, and the search index of the column is
+    /// updated for all of them in one pass. If a key is given more than once,
+    /// the last value is used. Throws KeyNotFound if one of the objects does
+    /// not exist, in which case nothing is changed.
+    void set_column_values(ColKey col_key, const std::vector<ObjKey>& keys, const std::vector<Mixed>& values);
+    /// Set the value of a column to \a value for all objects in \a keys
+    void set_column_values(ColKey col_key, const std::vector<ObjKey>& keys, Mixed value);
     /// Does the key refer to an object within the table?
     bool is_valid(ObjKey key) const
     {
@@ -273,11 +336,30 @@ public:
     {
         return m_clusters.traverse(func);
     }
+    // Only visit the clusters that may hold objects with keys in [begin, end)
+    bool traverse_clusters(ObjKey begin, ObjKey end, ClusterTree::TraverseFunction func) const
+    {
+        return m_clusters.traverse_range(begin, end, func);
+    }
+    // Scan the values of an Int, Float or Double column leaf by leaf. Defined
+    // in <realm/column_scan.hpp>
+    template <class T>
+    ColumnScan<T> scan(ColKey col_key) const;
 
     /// remove_object() removes the specified object from the table.
     /// Any links from the specified object into objects residing in an embedded
     /// table will cause those objects to be deleted as well, and so on recursively.
     void remove_object(ObjKey key);
+    /// remove_objects() removes the specified objects like remove_object(). The
+    /// objects are erased leaf by leaf, and their entries in the search indexes
+    /// are erased column by column. Throws KeyNotFound if any of the
+    /// keys does not refer to an object in the table.
+    void remove_objects(std::vector<ObjKey> keys);
+    /// remove_object_range() removes all objects with keys in [begin, end) like
+    /// remove_objects() and returns the number of objects removed. Subtrees of
+    /// the table holding only objects in the range are detached as a whole if
+    /// the table has no link columns.
+    size_t remove_object_range(ObjKey begin, ObjKey end);
     /// remove_object_recursive() will delete linked rows if the removed link was the
     /// last one holding on to the row in question. This will be done recursively.
     void remove_object_recursive(ObjKey key);
@@ -299,6 +381,15 @@ public:
     ConstIterator end() const;
     Iterator begin();
     Iterator end();
+    // Iterators pointing to the first object with a key not less than 'key'
+    ConstIterator lower_bound(ObjKey key) const
+    {
+        return ConstIterator(m_clusters, key);
+    }
+    Iterator lower_bound(ObjKey key)
+    {
+        return Iterator(m_clusters, key);
+    }
     void remove_object(const ConstIterator& it)
     {
         remove_object(it->get_key());
@@ -361,12 +452,10 @@ public:
     double average_double(ColKey col_key, size_t* value_count = nullptr) const;
     Decimal128 average_decimal(ColKey col_key, size_t* value_count = nullptr) const;
 
-    // Will return pointer to search index accessor. Will return nullptr if no index
+    // Will return pointer to search index accessor of any kind. Will return nullptr if no index
     StringIndex* get_search_index(ColKey col) const noexcept
     {
         report_invalid_key(col);
-        if (!has_search_index(col))
-            return nullptr;
         return m_index_accessors[col.get_index().val];
     }
     template <class T>
@@ -410,6 +499,13 @@ public:
     // the content in the table changes.
     uint_fast64_t get_content_version() const noexcept;
 
+    // Report the version of the table stored in the file. It is bumped by every commit which
+    // changes the table and, unlike the content version, can be compared between transactions.
+    // A table starts at the version of the snapshot it was created in, so a table recreated
+    // with the key of a removed table never reports a version seen for the removed one.
+    // None if the table has been changed in the current write transaction.
+    util::Optional<uint64_t> get_commit_version() const noexcept;
+
     // Report the current instance version. This is a 64-bit value which is bumped
     // whenever the table accessor is recycled.
     uint_fast64_t get_instance_version() const noexcept;
@@ -620,9 +716,19 @@ private:
     TableRef m_own_ref;
 
     void batch_erase_rows(const KeyColumn& keys);
+    // Keys must be ascending and refer to existing objects
+    void do_remove_objects(const std::vector<ObjKey>& keys);
+    void do_set_column_values(ColKey col_key, const std::vector<ObjKey>& keys,
+                              util::FunctionRef<Mixed(size_t)> value_at);
+    // Throws LogicError unless all values can be stored in the column
+    void check_column_values(ColKey col_key, const std::vector<Mixed>& values) const;
     size_t do_set_link(ColKey col_key, size_t row_ndx, size_t target_row_ndx);
 
     void populate_search_index(ColKey col_key);
+    // Throws LogicError if the file format is older than the given one
+    void check_file_format(int file_format_version) const;
+    void remove_statistics(ColKey col_key);
+    IndexType get_index_type_from_spec(ColKey col_key) const noexcept;
 
     // Migration support
     void migrate_column_info();
@@ -670,6 +776,11 @@ private:
     void erase_root_column(ColKey col_key);
     ColKey do_insert_root_column(ColKey col_key, ColumnType, StringData name);
     void do_erase_root_column(ColKey col_key);
+    // Destroy the node structure at 'ref' of a removed column. The nodes of
+    // previous versions are left for the group to free over the next commits.
+    void destroy_deep_deferred(ref_type ref) const;
+    // The cluster node size stored in the top array, or zero for the default
+    size_t get_stored_cluster_node_size() const noexcept;
 
     bool has_any_embedded_objects();
     void set_opposite_column(ColKey col_key, TableKey opposite_table, ColKey opposite_column);
@@ -723,8 +834,9 @@ private:
     static size_t get_size_from_ref(ref_type spec_ref, ref_type columns_ref, Allocator&) noexcept;
 
     /// Create an empty table with independent spec and return just
-    /// the reference to the underlying memory.
-    static ref_type create_empty_table(Allocator&, TableKey = TableKey());
+    /// the reference to the underlying memory. The version stored in the
+    /// table starts at \a version.
+    static ref_type create_empty_table(Allocator&, TableKey = TableKey(), uint64_t version = 0);
 
     void nullify_links(CascadeState&);
     void remove_recursive(CascadeState&);
@@ -770,7 +882,9 @@ private:
     static constexpr int top_position_for_flags = 12;
     // flags contents: bit 0 - is table embedded?
     static constexpr int top_position_for_tombstones = 13;
-    static constexpr int top_array_size = 14;
+    static constexpr int top_position_for_statistics = 14;
+    static constexpr int top_position_for_cluster_node_size = 15;
+    static constexpr int top_array_size = 16;
 
     enum { s_collision_map_lo = 0, s_collision_map_hi = 1, s_collision_map_local_id = 2, s_collision_map_num_slots };
 
@@ -793,7 +907,12 @@ private:
     friend class Group;
     friend class Transaction;
     friend class Cluster;
+    friend class ClusterNodeInner;
     friend class ClusterTree;
+    template <class>
+    friend class ColumnScan;
+    friend class Projection;
+    friend class ArrowExporter;
     friend class ColKeyIterator;
     friend class ConstObj;
     friend class Obj;
@@ -995,6 +1114,13 @@ inline uint_fast64_t Table::get_content_version() const noexcept
     return m_alloc.get_content_version();
 }
 
+inline util::Optional<uint64_t> Table::get_commit_version() const noexcept
+{
+    if (!m_top.is_attached() || !m_top.is_read_only() || m_top.size() <= top_position_for_version)
+        return util::none;
+    return m_in_file_version_at_transaction_boundary;
+}
+
 inline uint_fast64_t Table::get_instance_version() const noexcept
 {
     return m_alloc.get_instance_version();
@@ -20,6 +20,8 @@
 #include <realm/column_integer.hpp>
 #include <realm/index_string.hpp>
 #include <realm/db.hpp>
+#include <realm/object_change_set.hpp>
+#include <realm/query_engine.hpp>
 
 #include <unordered_set>
 
@@ -458,6 +460,15 @@ void ConstTableView::sync_if_needed() const
     }
 }
 
+void ConstTableView::sync_if_needed(const ObjectChangeSet& changes) const
+{
+    if (!is_in_sync()) {
+        auto self = const_cast<ConstTableView*>(this);
+        if (!self->do_sync_incremental(changes))
+            self->do_sync();
+    }
+}
+
 
 void TableView::remove(size_t row_ndx)
 {
@@ -613,6 +624,123 @@ void ConstTableView::do_sync()
     m_last_seen_versions = get_dependency_versions();
 }
 
+bool ConstTableView::do_sync_incremental(const ObjectChangeSet& changes)
+{
+    // Only views produced by an unrestricted query over a single table, in table order or
+    // sorted on columns of the table itself, can be updated from the changed objects alone.
+    if (m_linklist_source || m_source_column_key || !m_query.m_table || m_query.m_view)
+        return false;
+    if (m_start != 0 || m_end != size_t(-1) || m_limit != size_t(-1))
+        return false;
+    if (m_last_seen_versions.empty())
+        return false;
+    TableKey table_key = m_table->get_key();
+    for (auto& version : m_last_seen_versions) {
+        if (version.first != table_key)
+            return false;
+    }
+    // Whether an object matches must only depend on its own values, which is not the case when
+    // the query follows links, even to objects of the same table
+    if (ParentNode* root = m_query.root_node()) {
+        if (root->has_link_conditions())
+            return false;
+    }
+    if (!changes.has_object_changes_only(table_key))
+        return false;
+    // The changes must start where the view was last synchronized and bring it up to date
+    if (!changes.covers_versions(table_key, m_last_seen_versions.front().second, m_table->get_content_version()))
+        return false;
+
+    const SortDescriptor* sort = nullptr;
+    if (!m_descriptor_ordering.is_empty()) {
+        if (m_descriptor_ordering.size() > 1 || m_descriptor_ordering.get_type(0) != DescriptorType::Sort)
+            return false;
+        sort = static_cast<const SortDescriptor*>(m_descriptor_ordering[0]);
+    }
+
+    const std::vector<ObjKey>& changed = changes.get_changed_objects(table_key);
+    // Rerunning the query is cheaper when a large part of the table has changed
+    if (changed.size() > m_table->size() / 4 + 16)
+        return false;
+
+    // Sorting on the columns of linked objects is not supported. Objects comparing equal are
+    // ordered by key, as the query produces them in table order before sorting.
+    BaseDescriptor::IndexPairs pairs;
+    auto comes_before = [&](ObjKey a, ObjKey b) {
+        pairs.clear();
+        pairs.emplace_back(a, size_t(a.value));
+        pairs.emplace_back(b, size_t(b.value));
+        BaseDescriptor::Sorter predicate = sort->sorter(*m_table, pairs);
+        predicate.cache_first_column(pairs);
+        return predicate(pairs[0], pairs[1]);
+    };
+    if (sort) {
+        pairs.emplace_back(ObjKey(0), 0);
+        if (sort->sorter(*m_table, pairs).has_links())
+            return false;
+    }
+
+    // Position of the first entry in the view which does not come before the key
+    auto lower_bound = [&](ObjKey key) {
+        size_t lo = 0;
+        size_t hi = m_key_values.size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            ObjKey k = m_key_values.get(mid);
+            if (sort ? comes_before(k, key) : k < key)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    };
+
+    util::CriticalSection cs(m_race_detector);
+    // Only the changed objects are evaluated
+    m_query.init(false);
+
+    // Take out all changed objects. The position of a modified object in a sorted view cannot
+    // be found from its new values, so those are searched for.
+    if (!sort) {
+        for (auto key : changed) {
+            size_t ndx = lower_bound(key);
+            if (ndx < m_key_values.size() && m_key_values.get(ndx) == key)
+                m_key_values.erase(ndx);
+        }
+    }
+    else if (changed.size() <= 16) {
+        for (auto key : changed) {
+            size_t ndx = m_key_values.find_first(key);
+            if (ndx != realm::npos)
+                m_key_values.erase(ndx);
+        }
+    }
+    else {
+        std::vector<ObjKey> kept;
+        kept.reserve(m_key_values.size());
+        for (size_t i = 0; i < m_key_values.size(); ++i) {
+            ObjKey key = m_key_values.get(i);
+            if (!std::binary_search(changed.begin(), changed.end(), key))
+                kept.push_back(key);
+        }
+        m_key_values.clear();
+        for (auto key : kept)
+            m_key_values.add(key);
+    }
+
+    // And put back the ones still matching
+    for (auto key : changed) {
+        if (!m_table->is_valid(key))
+            continue;
+        ConstObj obj = m_table->get_object(key);
+        if (m_query.eval_object(obj))
+            m_key_values.insert(lower_bound(key), key);
+    }
+
+    m_last_seen_versions = get_dependency_versions();
+    return true;
+}
+
 void ConstTableView::do_sort(const DescriptorOrdering& ordering)
 {
     if (ordering.is_empty())
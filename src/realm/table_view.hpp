@@ -27,6 +27,8 @@
 
 namespace realm {
 
+class ObjectChangeSet;
+
 // Views, tables and synchronization between them:
 //
 // Views are built through queries against either tables or another view.
@@ -312,6 +314,14 @@ public:
     // before any of the other access-methods whenever the view may have become
     // outdated.
     void sync_if_needed() const override;
+    // Synchronize a view using the objects changed since it was last in sync,
+    // as collected by an ObjectChangeSet observing the advance of the read
+    // transaction. Only the changed objects are tested against the query and
+    // inserted, removed or moved within the view. Views that depend on other
+    // tables, or which are restricted, distinct or limited, are synchronized
+    // by rerunning the query. So are views last synchronized at another
+    // version than the one the changes start from.
+    void sync_if_needed(const ObjectChangeSet& changes) const;
     // Return the version of the source it was created from.
     TableVersions get_dependency_versions() const
     {
@@ -374,6 +384,7 @@ protected:
     void get_dependencies(TableVersions&) const override;
 
     void do_sync();
+    bool do_sync_incremental(const ObjectChangeSet& changes);
     void do_sort(const DescriptorOrdering&);
 
     mutable ConstTableRef m_table;
@@ -30,6 +30,9 @@
 
 #include <cctype>
 #include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
 
 namespace realm {
 namespace util {
@@ -65,9 +68,19 @@ inline std::string print_with_nan_check(T val)
         }
         return "nan";
     }
+    // Use the default precision when that is enough to read the value back, and
+    // otherwise as many digits as needed to tell it apart from any other value
     std::stringstream ss;
     ss << val;
-    return ss.str();
+    std::string out = ss.str();
+    std::istringstream is(out);
+    T parsed;
+    if (!(is >> parsed) || parsed != val) {
+        ss.str("");
+        ss << std::setprecision(std::numeric_limits<T>::max_digits10) << val;
+        out = ss.str();
+    }
+    return out;
 }
 
 template <>
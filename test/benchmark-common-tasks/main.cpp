@@ -174,6 +174,239 @@ struct BenchmarkUnorderedTableViewClearIndexed : BenchmarkUnorderedTableViewClea
     }
 };
 
+struct BenchmarkTTLExpiry : Benchmark {
+    const char* name() const
+    {
+        return "TTLExpiry";
+    }
+    void before_all(DBRef group)
+    {
+        const size_t rows = BASE_SIZE * 4;
+        WrtTrans tr(group);
+        TableRef tbl = tr.add_table(name());
+        m_col = tbl->add_column(type_Timestamp, "expires");
+        m_col_session = tbl->add_column(type_String, "session");
+        tbl->add_search_index(m_col_session);
+#ifdef REALM_CLUSTER_IF
+        for (size_t i = 0; i < rows; ++i) {
+            // Every other entry has expired, in runs of a few entries
+            tbl->create_object()
+                .set(m_col, Timestamp((i / 4) % 2 ? 2000 : 1000, 0))
+                .set(m_col_session, StringData(util::to_string(i)));
+        }
+#endif
+        tr.commit();
+    }
+    void operator()(DBRef)
+    {
+#ifdef REALM_CLUSTER_IF
+        size_t removed = (m_table->column<Timestamp>(m_col) < Timestamp(1500, 0)).remove();
+        REALM_ASSERT_3(removed, >, 0);
+#endif
+    }
+    void after_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        tr.get_group().remove_table(name());
+        tr.commit();
+    }
+    ColKey m_col_session;
+};
+
+struct BenchmarkSetColumnByObj : Benchmark {
+    const char* name() const
+    {
+        return "SetColumnByObj";
+    }
+    void before_all(DBRef group)
+    {
+        const size_t rows = BASE_SIZE * 4;
+        WrtTrans tr(group);
+        TableRef tbl = tr.add_table(name());
+        m_col = tbl->add_column(type_Int, "status");
+#ifdef REALM_CLUSTER_IF
+        tbl->create_objects(rows, m_keys);
+#endif
+        tr.commit();
+    }
+    void operator()(DBRef)
+    {
+#ifdef REALM_CLUSTER_IF
+        for (auto key : m_keys)
+            m_table->get_object(key).set<Int>(m_col, 2);
+#endif
+    }
+    void after_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        tr.get_group().remove_table(name());
+        tr.commit();
+        Benchmark::after_all(group);
+    }
+};
+
+struct BenchmarkSetColumnValues : BenchmarkSetColumnByObj {
+    const char* name() const
+    {
+        return "SetColumnValues";
+    }
+    void operator()(DBRef)
+    {
+#ifdef REALM_CLUSTER_IF
+        m_table->set_column_values(m_col, m_keys, Mixed(int64_t(2)));
+#endif
+    }
+};
+
+struct BenchmarkAddColumnToLargeTable : Benchmark {
+    const char* name() const
+    {
+        return "AddColumnToLargeTable";
+    }
+    void before_all(DBRef group)
+    {
+        const size_t rows = BASE_SIZE * 4;
+        WrtTrans tr(group);
+        TableRef tbl = tr.add_table(name());
+        m_col = tbl->add_column(type_Int, "int");
+#ifdef REALM_CLUSTER_IF
+        tbl->create_objects(rows, m_keys);
+#endif
+        tr.commit();
+    }
+    void operator()(DBRef)
+    {
+        // The transaction is rolled back after each run
+        m_table->add_column(type_Int, "status");
+        m_table->add_column(type_Double, "score", true);
+        m_table->add_column(type_String, "comment", true);
+    }
+    void after_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        tr.get_group().remove_table(name());
+        tr.commit();
+        Benchmark::after_all(group);
+    }
+};
+
+struct BenchmarkRemoveLargeTable : Benchmark {
+    const char* name() const
+    {
+        return "RemoveLargeTable";
+    }
+    void before_all(DBRef group)
+    {
+        const size_t rows = BASE_SIZE * 4;
+        WrtTrans tr(group);
+        TableRef tbl = tr.add_table(name());
+        auto col_int = tbl->add_column(type_Int, "int");
+        auto col_str = tbl->add_column(type_String, "string");
+        tbl->add_column(type_Double, "double", true);
+        tbl->add_column(type_Timestamp, "timestamp", true);
+        for (size_t i = 0; i < rows; i++) {
+            std::string str = util::to_string(i % 1000);
+            tbl->create_object().set(col_int, int64_t(i)).set(col_str, StringData(str));
+        }
+        tbl->add_search_index(col_int);
+        tbl->add_search_index(col_str);
+        tr.commit();
+    }
+    void operator()(DBRef)
+    {
+        // The transaction is rolled back after each run
+        m_tr->get_group().remove_table(name());
+    }
+    void after_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        tr.get_group().remove_table(name());
+        tr.commit();
+        Benchmark::after_all(group);
+    }
+};
+
+// A table with the given cluster node size, see Table::set_cluster_node_size()
+template <size_t node_size>
+struct BenchmarkWithClusterNodeSize : Benchmark {
+    void before_all(DBRef group)
+    {
+        const size_t rows = BASE_SIZE;
+        WrtTrans tr(group);
+        TableRef tbl = tr.add_table(name());
+#ifdef REALM_CLUSTER_IF
+        tbl->set_cluster_node_size(node_size);
+        m_col = tbl->add_column(type_Int, "int");
+        // Leave room for the inserted objects between the existing ones
+        for (size_t i = 0; i < rows; i++) {
+            m_keys.push_back(ObjKey(int64_t(2 * i)));
+            tbl->create_object(m_keys.back()).set(m_col, int64_t(i));
+        }
+        // Look the objects up in random order
+        std::mt19937 gen(1);
+        std::shuffle(m_keys.begin(), m_keys.end(), gen);
+#endif
+        tr.commit();
+    }
+    void after_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        tr.get_group().remove_table(name());
+        tr.commit();
+        Benchmark::after_all(group);
+    }
+};
+
+template <size_t node_size>
+struct BenchmarkScanClusterNodeSize : BenchmarkWithClusterNodeSize<node_size> {
+    const char* name() const
+    {
+        static const std::string str = "ScanNodeSize" + util::to_string(node_size);
+        return str.c_str();
+    }
+    void operator()(DBRef)
+    {
+        int64_t sum = this->m_table->sum_int(this->m_col);
+        REALM_ASSERT(sum > 0);
+    }
+};
+
+template <size_t node_size>
+struct BenchmarkLookupClusterNodeSize : BenchmarkWithClusterNodeSize<node_size> {
+    const char* name() const
+    {
+        static const std::string str = "LookupNodeSize" + util::to_string(node_size);
+        return str.c_str();
+    }
+    void operator()(DBRef)
+    {
+#ifdef REALM_CLUSTER_IF
+        int64_t sum = 0;
+        for (size_t i = 0; i < 10000; i++)
+            sum += this->m_table->get_object(this->m_keys[i]).template get<Int>(this->m_col);
+        REALM_ASSERT(sum > 0);
+#endif
+    }
+};
+
+template <size_t node_size>
+struct BenchmarkInsertClusterNodeSize : BenchmarkWithClusterNodeSize<node_size> {
+    const char* name() const
+    {
+        static const std::string str = "InsertNodeSize" + util::to_string(node_size);
+        return str.c_str();
+    }
+    void operator()(DBRef)
+    {
+        // Insert between the existing objects. The transaction is rolled back
+        // after each run.
+#ifdef REALM_CLUSTER_IF
+        for (size_t i = 0; i < 10000; i++)
+            this->m_table->create_object(ObjKey(this->m_keys[i].value + 1)).set(this->m_col, 1);
+#endif
+    }
+};
+
 struct AddTable : Benchmark {
     const char* name() const
     {
@@ -807,6 +1040,227 @@ struct BenchmarkIntVsDoubleColumns : Benchmark {
 };
 
 
+struct BenchmarkSumIntColumnByObj : Benchmark {
+    constexpr static size_t num_rows = BASE_SIZE * 4;
+    int64_t m_expected = 0;
+    void before_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        TableRef t = tr.add_table(name());
+        m_col = t->add_column(type_Int, "ints");
+        m_expected = 0;
+        for (size_t i = 0; i < num_rows; ++i) {
+            t->create_object().set<Int>(m_col, i % 1000);
+            m_expected += i % 1000;
+        }
+        tr.commit();
+    }
+    const char* name() const
+    {
+        return "SumIntColumnByObj";
+    }
+    void operator()(DBRef)
+    {
+        int64_t sum = 0;
+        for (auto obj : *m_table)
+            sum += obj.get<Int>(m_col);
+        REALM_ASSERT_3(sum, ==, m_expected);
+    }
+    void after_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        tr.get_group().remove_table(name());
+        tr.commit();
+    }
+};
+
+struct BenchmarkSumIntColumnByScan : BenchmarkSumIntColumnByObj {
+    const char* name() const
+    {
+        return "SumIntColumnByScan";
+    }
+    void operator()(DBRef)
+    {
+        int64_t sum = 0;
+        ColumnScan<Int> scan = m_table->scan<Int>(m_col);
+        ColumnSpan<Int> span;
+        while (scan.next(span)) {
+            for (size_t i = 0; i < span.size; ++i)
+                sum += span[i];
+        }
+        REALM_ASSERT_3(sum, ==, m_expected);
+    }
+};
+
+
+struct BenchmarkReadFieldsByObj : Benchmark {
+    constexpr static size_t num_rows = BASE_SIZE * 4;
+    ColKey m_col_int;
+    ColKey m_col_double;
+    ColKey m_col_str;
+    double m_expected = 0;
+    void before_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        TableRef t = tr.add_table(name());
+        m_col_int = t->add_column(type_Int, "int");
+        m_col_double = t->add_column(type_Double, "double");
+        m_col_str = t->add_column(type_String, "str");
+        m_expected = 0;
+        for (size_t i = 0; i < num_rows; ++i) {
+            t->create_object()
+                .set<Int>(m_col_int, i % 1000)
+                .set(m_col_double, double(i % 100) / 2)
+                .set(m_col_str, i % 2 ? "odd" : "even");
+            m_expected += i % 1000 + double(i % 100) / 2 + (i % 2 ? 3 : 4);
+        }
+        tr.commit();
+    }
+    const char* name() const
+    {
+        return "ReadFieldsByObj";
+    }
+    void operator()(DBRef)
+    {
+        double sum = 0;
+        for (auto obj : *m_table)
+            sum += obj.get<Int>(m_col_int) + obj.get<double>(m_col_double) + obj.get<String>(m_col_str).size();
+        REALM_ASSERT_3(sum, ==, m_expected);
+    }
+    void after_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        tr.get_group().remove_table(name());
+        tr.commit();
+    }
+};
+
+struct BenchmarkReadFieldsByProjection : BenchmarkReadFieldsByObj {
+    const char* name() const
+    {
+        return "ReadFieldsByProjection";
+    }
+    void operator()(DBRef)
+    {
+        double sum = 0;
+        Projection proj(m_table, {m_col_int, m_col_double, m_col_str});
+        while (proj.next())
+            sum += proj.get<Int>(0) + proj.get<double>(1) + proj.get<String>(2).size();
+        REALM_ASSERT_3(sum, ==, m_expected);
+    }
+};
+
+struct BenchmarkExportTableToJson : BenchmarkReadFieldsByObj {
+    const char* name() const
+    {
+        return "ExportTableToJson";
+    }
+    void operator()(DBRef)
+    {
+        std::stringstream ss;
+        m_table->to_json(ss);
+        REALM_ASSERT(ss.tellp() > 0);
+    }
+};
+
+struct BenchmarkExportTableToArrow : BenchmarkReadFieldsByObj {
+    const char* name() const
+    {
+        return "ExportTableToArrow";
+    }
+    void operator()(DBRef)
+    {
+        ArrowArray array;
+        ArrowSchema schema;
+        export_to_arrow(*m_table, {m_col_int, m_col_double, m_col_str}, &array, &schema);
+        REALM_ASSERT_3(array.length, ==, int64_t(num_rows));
+        array.release(&array);
+        schema.release(&schema);
+    }
+};
+
+struct BenchmarkExportQueryToJson : BenchmarkReadFieldsByObj {
+    const char* name() const
+    {
+        return "ExportQueryToJson";
+    }
+    void operator()(DBRef)
+    {
+        std::stringstream ss;
+        m_table->where().less(m_col_int, 500).find_all().to_json(ss);
+        REALM_ASSERT(ss.tellp() > 0);
+    }
+};
+
+struct BenchmarkExportQueryToArrow : BenchmarkReadFieldsByObj {
+    const char* name() const
+    {
+        return "ExportQueryToArrow";
+    }
+    void operator()(DBRef)
+    {
+        ArrowArray array;
+        ArrowSchema schema;
+        Query query = m_table->where().less(m_col_int, 500);
+        export_to_arrow(query, {m_col_int, m_col_double, m_col_str}, &array, &schema);
+        REALM_ASSERT_3(array.length, ==, int64_t(num_rows / 2));
+        array.release(&array);
+        schema.release(&schema);
+    }
+};
+
+struct BenchmarkQueryColumnArithmetic : Benchmark {
+    ColKey price_col_ndx;
+    ColKey qty_col_ndx;
+    ColKey cost_col_ndx;
+    constexpr static size_t num_rows = BASE_SIZE * 4;
+    void before_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        TableRef t = tr.add_table(name());
+        price_col_ndx = t->add_column(type_Int, "price");
+        qty_col_ndx = t->add_column(type_Int, "qty");
+        cost_col_ndx = t->add_column(type_Double, "cost");
+        for (size_t i = 0; i < num_rows; ++i) {
+#ifdef REALM_CLUSTER_IF
+            t->create_object()
+                .set<Int>(price_col_ndx, i % 100)
+                .set<Int>(qty_col_ndx, i % 37)
+                .set(cost_col_ndx, double(i % 50) * 1.5);
+#else
+            auto ndx = t->add_empty_row();
+            t->set_int(price_col_ndx, ndx, i % 100);
+            t->set_int(qty_col_ndx, ndx, i % 37);
+            t->set_double(cost_col_ndx, ndx, double(i % 50) * 1.5);
+#endif
+        }
+        tr.commit();
+    }
+    const char* name() const
+    {
+        return "QueryColumnArithmetic";
+    }
+    void operator()(DBRef)
+    {
+        TableRef table = m_table;
+        auto price = table->column<Int>(price_col_ndx);
+        auto qty = table->column<Int>(qty_col_ndx);
+        auto cost = table->column<Double>(cost_col_ndx);
+        Query q1 = (price * qty > 1000);
+        Query q2 = (price > qty);
+        Query q3 = (cost * 2.0 - price < qty);
+        size_t matches = q1.count() + q2.count() + q3.count();
+        REALM_ASSERT_3(matches, >, 0);
+    }
+
+    void after_all(DBRef group)
+    {
+        WrtTrans tr(group);
+        tr.get_group().remove_table(name());
+        tr.commit();
+    }
+};
+
 struct BenchmarkWithIntUIDsRandomOrderSeqAccess : BenchmarkWithIntsTable {
     const char* name() const
     {
@@ -1443,6 +1897,21 @@ struct BenchmarkQueryInsensitiveStringIndexed : BenchmarkQueryInsensitiveString
     }
 };
 
+struct BenchmarkQueryInsensitiveStringCaseFoldedIndexed : BenchmarkQueryInsensitiveString {
+    const char* name() const
+    {
+        return "QueryInsensitiveStringCaseFoldedIndexed";
+    }
+    void before_all(DBRef group)
+    {
+        BenchmarkQueryInsensitiveString::before_all(group);
+        WrtTrans tr(group);
+        TableRef t = tr.get_table(name());
+        t->add_search_index(m_col, IndexType::CaseInsensitive);
+        tr.commit();
+    }
+};
+
 struct BenchmarkSetLongString : BenchmarkWithLongStrings {
     const char* name() const
     {
@@ -1888,6 +2357,20 @@ int benchmark_common_tasks_main()
 
     BENCH(BenchmarkUnorderedTableViewClear);
     BENCH(BenchmarkUnorderedTableViewClearIndexed);
+    BENCH(BenchmarkTTLExpiry);
+    BENCH(BenchmarkSetColumnByObj);
+    BENCH(BenchmarkSetColumnValues);
+    BENCH(BenchmarkAddColumnToLargeTable);
+    BENCH(BenchmarkRemoveLargeTable);
+    BENCH(BenchmarkScanClusterNodeSize<16>);
+    BENCH(BenchmarkScanClusterNodeSize<256>);
+    BENCH(BenchmarkScanClusterNodeSize<4096>);
+    BENCH(BenchmarkLookupClusterNodeSize<16>);
+    BENCH(BenchmarkLookupClusterNodeSize<256>);
+    BENCH(BenchmarkLookupClusterNodeSize<4096>);
+    BENCH(BenchmarkInsertClusterNodeSize<16>);
+    BENCH(BenchmarkInsertClusterNodeSize<256>);
+    BENCH(BenchmarkInsertClusterNodeSize<4096>);
 
     // getting/setting - tableview or not
     BENCH(BenchmarkGetString);
@@ -1911,6 +2394,7 @@ int benchmark_common_tasks_main()
 
     BENCH(BenchmarkQueryInsensitiveString);
     BENCH(BenchmarkQueryInsensitiveStringIndexed);
+    BENCH(BenchmarkQueryInsensitiveStringCaseFoldedIndexed);
     BENCH(BenchmarkQueryChainedOrStrings<false>);
     BENCH(BenchmarkQueryChainedOrStrings<true>);
     BENCH(BenchmarkQueryNotChainedOrStrings<false>);
@@ -1920,6 +2404,15 @@ int benchmark_common_tasks_main()
     BENCH(BenchmarkQueryIntEquality);
     BENCH(BenchmarkQueryIntEqualityIndexed);
     BENCH(BenchmarkIntVsDoubleColumns);
+    BENCH(BenchmarkSumIntColumnByObj);
+    BENCH(BenchmarkSumIntColumnByScan);
+    BENCH(BenchmarkReadFieldsByObj);
+    BENCH(BenchmarkReadFieldsByProjection);
+    BENCH(BenchmarkExportTableToJson);
+    BENCH(BenchmarkExportTableToArrow);
+    BENCH(BenchmarkExportQueryToJson);
+    BENCH(BenchmarkExportQueryToArrow);
+    BENCH(BenchmarkQueryColumnArithmetic);
     BENCH(BenchmarkQueryStringOverLinks);
     BENCH(BenchmarkQueryTimestampGreaterOverLinks);
     BENCH(BenchmarkQueryTimestampGreater);
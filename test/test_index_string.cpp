@@ -258,8 +258,6 @@ TEST(StringIndex_NonIndexable)
     TableRef target_table = group.add_table("target");
     table->add_column_link(type_Link, "link", *target_table);
     table->add_column_link(type_LinkList, "linkList", *target_table);
-    table->add_column(type_Double, "double");
-    table->add_column(type_Float, "float");
     table->add_column(type_Binary, "binary");
 
     for (auto col : table->get_column_keys()) {
@@ -1790,4 +1788,508 @@ TEST(StringIndex_QuerySingleObject)
     CHECK_EQUAL(q.count(), 0);
 }
 
+TEST(StringIndex_ListOfPrimitives)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col_str = table->add_column_list(type_String, "strings", true);
+    auto col_int = table->add_column_list(type_Int, "ints");
+
+    auto o1 = table->create_object();
+    auto o2 = table->create_object();
+    auto o3 = table->create_object();
+    auto strings1 = o1.get_list<String>(col_str);
+    strings1.add("Hello");
+    strings1.add("Hello world");
+    strings1.add("Hell");
+    strings1.add(StringData());
+    o1.get_list<Int>(col_int).add(5);
+
+    // Index created on a populated column
+    table->add_search_index(col_str);
+    table->add_search_index(col_int);
+    CHECK(table->has_search_index(col_str));
+
+    auto strings2 = o2.get_list<String>(col_str);
+    strings2.add("Hello world");
+    strings2.add("Hello world");
+    strings2.add("Hello");
+    auto ints2 = o2.get_list<Int>(col_int);
+    ints2.add(5);
+    ints2.add(7);
+    o3.get_list<String>(col_str).add("Goodbye");
+
+    StringIndex* ndx = table->get_search_index(col_str);
+    CHECK_EQUAL(ndx->count(StringData("Hello")), 2);
+    CHECK_EQUAL(ndx->count(StringData("Hello world")), 3);
+    CHECK_EQUAL(ndx->count(StringData("Hell")), 1);
+    CHECK_EQUAL(ndx->count(StringData("He")), 0);
+    CHECK_EQUAL(ndx->count(StringData("Hello worl")), 0);
+    CHECK_EQUAL(ndx->find_first(StringData("Hell")), o1.get_key());
+    CHECK_EQUAL(ndx->find_first(StringData()), o1.get_key());
+    CHECK(ndx->has_duplicate_values());
+    table->verify();
+
+    Query q = table->column<Lst<String>>(col_str) == "Hello world";
+    CHECK_EQUAL(q.count(), 2);
+    q = table->column<Lst<String>>(col_str) == "Goodbye";
+    CHECK_EQUAL(q.find(), o3.get_key());
+    q = table->column<Lst<Int>>(col_int) == 5;
+    CHECK_EQUAL(q.count(), 2);
+    q = table->column<Lst<Int>>(col_int) == 7;
+    CHECK_EQUAL(q.find(), o2.get_key());
+
+    strings2.set(0, "Goodbye");
+    strings2.remove(1);
+    CHECK_EQUAL(ndx->count(StringData("Hello world")), 1);
+    CHECK_EQUAL(ndx->count(StringData("Goodbye")), 2);
+    strings1.clear();
+    CHECK_EQUAL(ndx->count(StringData("Hello")), 1);
+    CHECK_EQUAL(ndx->count(StringData("Hell")), 0);
+    CHECK_EQUAL(ndx->count(StringData()), 0);
+    q = table->column<Lst<String>>(col_str) == "Hello";
+    CHECK_EQUAL(q.find(), o2.get_key());
+    table->verify();
+
+    o2.remove();
+    CHECK_EQUAL(ndx->count(StringData("Hello world")), 0);
+    CHECK_EQUAL(ndx->count(StringData("Goodbye")), 1);
+    CHECK_EQUAL(table->get_search_index(col_int)->count(int64_t(5)), 1);
+    table->verify();
+
+    table->remove_search_index(col_str);
+    CHECK_NOT(table->has_search_index(col_str));
+    q = table->column<Lst<String>>(col_str) == "Goodbye";
+    CHECK_EQUAL(q.find(), o3.get_key());
+}
+
+TEST(StringIndex_ListOfPrimitivesNull)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col = table->add_column_list(type_String, "strings", true);
+    table->add_search_index(col);
+
+    // Values made of zero bytes must not be confused with null
+    std::vector<std::string> zeros = {std::string(), std::string(3, '\0'), std::string(4, '\0'),
+                                      std::string(5, '\0'), std::string(8, '\0')};
+    auto o_null = table->create_object();
+    o_null.get_list<String>(col).add(StringData());
+    std::vector<ObjKey> keys;
+    for (auto& z : zeros) {
+        auto obj = table->create_object();
+        obj.get_list<String>(col).add(StringData(z));
+        keys.push_back(obj.get_key());
+    }
+    auto o_both = table->create_object();
+    o_both.get_list<String>(col).add(StringData(zeros[2]));
+    o_both.get_list<String>(col).add(StringData());
+    table->verify();
+
+    StringIndex* ndx = table->get_search_index(col);
+    CHECK_EQUAL(ndx->count(StringData()), 2);
+    for (size_t i = 0; i < zeros.size(); ++i) {
+        CHECK_EQUAL(ndx->count(StringData(zeros[i])), i == 2 ? 2 : 1);
+        CHECK_EQUAL(ndx->find_first(StringData(zeros[i])), keys[i]);
+    }
+
+    auto check_queries = [&] {
+        Query q = table->column<Lst<String>>(col) == StringData();
+        CHECK_EQUAL(q.count(), 2);
+        CHECK_EQUAL(q.find(), std::min(o_null.get_key(), o_both.get_key()));
+        for (size_t i = 0; i < zeros.size(); ++i) {
+            q = table->column<Lst<String>>(col) == StringData(zeros[i]);
+            CHECK_EQUAL(q.count(), i == 2 ? 2 : 1);
+            CHECK_EQUAL(q.find(), keys[i]);
+        }
+    };
+    check_queries();
+
+    o_both.get_list<String>(col).remove(1);
+    o_null.remove();
+    CHECK_EQUAL(ndx->count(StringData()), 0);
+    CHECK_EQUAL(ndx->count(StringData(zeros[2])), 2);
+    table->verify();
+    o_null = table->create_object();
+    o_null.get_list<String>(col).add(StringData());
+    o_both.get_list<String>(col).add(StringData());
+    check_queries();
+
+    // Replacing null by zero bytes and back
+    o_null.get_list<String>(col).set(0, StringData(zeros[3]));
+    CHECK_EQUAL(ndx->count(StringData()), 1);
+    CHECK_EQUAL(ndx->count(StringData(zeros[3])), 2);
+    o_null.get_list<String>(col).set(0, StringData());
+    check_queries();
+
+    // The same results are found without the index
+    table->remove_search_index(col);
+    check_queries();
+
+    // Zero is stored as eight zero bytes
+    auto col_int = table->add_column_list(type_Int, "ints", true);
+    table->add_search_index(col_int);
+    o_null.get_list<Optional<Int>>(col_int).add(util::none);
+    o_both.get_list<Optional<Int>>(col_int).add(0);
+    o_both.get_list<Optional<Int>>(col_int).add(util::none);
+    ndx = table->get_search_index(col_int);
+    CHECK_EQUAL(ndx->count(null{}), 2);
+    CHECK_EQUAL(ndx->count(Int(0)), 1);
+    CHECK_EQUAL(ndx->find_first(Int(0)), o_both.get_key());
+    o_both.get_list<Optional<Int>>(col_int).set(0, util::none);
+    CHECK_EQUAL(ndx->count(null{}), 3);
+    CHECK_EQUAL(ndx->count(Int(0)), 0);
+    table->verify();
+}
+
+TEST(StringIndex_CaseInsensitive)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col = table->add_column(type_String, "name", true);
+    auto col_int = table->add_column(type_Int, "int");
+
+    auto o1 = table->create_object().set(col, "Hello");
+    auto o2 = table->create_object().set(col, "HELLO");
+    auto o3 = table->create_object().set(col, "hello world");
+    auto o4 = table->create_object();
+
+    table->add_search_index(col, IndexType::CaseInsensitive);
+    CHECK(table->search_index_type(col) == IndexType::CaseInsensitive);
+    CHECK_NOT(table->has_search_index(col));
+    CHECK_THROW_EX(table->add_search_index(col_int, IndexType::CaseInsensitive), LogicError,
+                   e.kind() == LogicError::illegal_combination);
+    // A rejected kind keeps the existing index
+    table->add_search_index(col_int);
+    CHECK_THROW_EX(table->add_search_index(col_int, IndexType::NGram), LogicError,
+                   e.kind() == LogicError::illegal_combination);
+    CHECK(table->search_index_type(col_int) == IndexType::General);
+    table->remove_search_index(col_int);
+
+    // The primary key column can only have a general index
+    auto pk_table = g.add_table_with_primary_key("pk", type_String, "id");
+    auto col_pk = pk_table->get_primary_key_column();
+    pk_table->add_search_index(col_pk);
+    CHECK_THROW_EX(pk_table->add_search_index(col_pk, IndexType::CaseInsensitive), LogicError,
+                   e.kind() == LogicError::illegal_combination);
+    CHECK_THROW_EX(pk_table->add_search_index(col_pk, IndexType::NGram), LogicError,
+                   e.kind() == LogicError::illegal_combination);
+    CHECK(pk_table->search_index_type(col_pk) == IndexType::General);
+
+    auto o5 = table->create_object().set(col, "hELLo");
+    StringIndex* ndx = table->get_search_index(col);
+    CHECK_EQUAL(ndx->count(StringData("hello")), 3);
+    CHECK_EQUAL(ndx->count(StringData("HELLO WORLD")), 1);
+    CHECK_EQUAL(ndx->count(StringData()), 1);
+    CHECK_EQUAL(ndx->find_first(StringData("HeLLo")), o1.get_key());
+
+    // Case sensitive lookups must not use the index
+    CHECK_EQUAL(table->find_first_string(col, "HELLO"), o2.get_key());
+    CHECK_EQUAL(table->count_string(col, "Hello"), 1);
+    CHECK_EQUAL(table->where().equal(col, "hello").count(), 0);
+    CHECK_EQUAL(table->where().equal(col, "HELLO").find(), o2.get_key());
+
+    Query q = table->where().equal(col, "hello", false);
+    CHECK_EQUAL(q.count(), 3);
+    CHECK_EQUAL(table->where().equal(col, "Hello World", false).find(), o3.get_key());
+    CHECK_EQUAL(table->where().equal(col, "Hell", false).count(), 0);
+
+    o1.set(col, "Goodbye");
+    o4.set(col, "HELLO");
+    CHECK_EQUAL(q.count(), 3);
+    o2.set(col, "hello"); // Same folded value
+    CHECK_EQUAL(q.count(), 3);
+    o5.remove();
+    CHECK_EQUAL(q.count(), 2);
+    CHECK_EQUAL(ndx->count(StringData("goodbye")), 1);
+    table->verify();
+
+    // A general index replaces the case insensitive one
+    table->add_search_index(col);
+    CHECK(table->has_search_index(col));
+    CHECK(table->search_index_type(col) == IndexType::General);
+    CHECK_EQUAL(table->where().equal(col, "hello", false).count(), 2);
+    table->remove_search_index(col);
+    CHECK(table->search_index_type(col) == IndexType::None);
+    CHECK_EQUAL(table->where().equal(col, "hello", false).count(), 2);
+}
+
+TEST(StringIndex_CaseInsensitivePersisted)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    auto db = DB::create(path);
+    ColKey col;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("foo");
+        col = table->add_column(type_String, "name");
+        table->add_search_index(col, IndexType::CaseInsensitive);
+        table->create_object().set(col, "Hello");
+        wt->commit();
+    }
+    auto rt = db->start_read();
+    auto table = rt->get_table("foo");
+    CHECK(table->search_index_type(col) == IndexType::CaseInsensitive);
+    CHECK_EQUAL(table->where().equal(col, "HELLO", false).count(), 1);
+    CHECK_EQUAL(table->where().equal(col, "HELLO").count(), 0);
+}
+
+TEST(StringIndex_NGram)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col = table->add_column(type_String, "indexed", true);
+    auto col_plain = table->add_column(type_String, "plain", true);
+    auto col_list = table->add_column_list(type_String, "list");
+
+    CHECK_THROW_EX(table->add_search_index(col_list, IndexType::NGram), LogicError,
+                   e.kind() == LogicError::illegal_combination);
+    table->add_search_index(col, IndexType::NGram);
+    CHECK(table->search_index_type(col) == IndexType::NGram);
+    CHECK_NOT(table->has_search_index(col));
+
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    const char* words[] = {"apple", "Banana", "cherry", "date", "ELDER", "fig", "grape", "ab", "", "x"};
+    auto random_value = [&]() -> std::string {
+        std::string str;
+        size_t n = random.draw_int_mod(4);
+        for (size_t i = 0; i < n; ++i) {
+            str += words[random.draw_int_mod(10)];
+            if (random.draw_bool())
+                str += " ";
+        }
+        return str;
+    };
+    std::vector<ObjKey> keys;
+    for (size_t i = 0; i < 300; ++i) {
+        Obj obj = table->create_object();
+        if (random.draw_int_mod(20) == 0) {
+            obj.set_null(col);
+            obj.set_null(col_plain);
+        }
+        else {
+            std::string str = random_value();
+            obj.set(col, StringData(str));
+            obj.set(col_plain, StringData(str));
+        }
+        keys.push_back(obj.get_key());
+    }
+
+    auto check_all = [&] {
+        const char* needles[] = {"app", "APPLE", "apple fig", "nan", "erry d", "ab", "", "e", "rape", "zzz", "date "};
+        for (const char* needle : needles) {
+            for (bool case_sensitive : {true, false}) {
+                CHECK_EQUAL(table->where().contains(col, StringData(needle), case_sensitive).count(),
+                            table->where().contains(col_plain, StringData(needle), case_sensitive).count());
+                CHECK_EQUAL(table->where().begins_with(col, StringData(needle), case_sensitive).count(),
+                            table->where().begins_with(col_plain, StringData(needle), case_sensitive).count());
+                CHECK_EQUAL(table->where().ends_with(col, StringData(needle), case_sensitive).count(),
+                            table->where().ends_with(col_plain, StringData(needle), case_sensitive).count());
+            }
+        }
+        const char* patterns[] = {"*ana*", "app*gra?e*", "?ig*", "*date", "Ba*", "*", "*e?d*"};
+        for (const char* pattern : patterns) {
+            for (bool case_sensitive : {true, false}) {
+                CHECK_EQUAL(table->where().like(col, StringData(pattern), case_sensitive).count(),
+                            table->where().like(col_plain, StringData(pattern), case_sensitive).count());
+            }
+        }
+        // Combined with another condition
+        CHECK_EQUAL(table->where().contains(col, "ana").contains(col, "grape", false).count(),
+                    table->where().contains(col_plain, "ana").contains(col_plain, "grape", false).count());
+        CHECK_EQUAL((table->where().contains(col, "ana").Or().contains(col, "cherry")).count(),
+                    (table->where().contains(col_plain, "ana").Or().contains(col_plain, "cherry")).count());
+    };
+    check_all();
+
+    for (size_t i = 0; i < 100; ++i) {
+        size_t ndx = random.draw_int_mod(keys.size());
+        Obj obj = table->get_object(keys[ndx]);
+        if (random.draw_bool()) {
+            std::string str = random_value();
+            obj.set(col, StringData(str));
+            obj.set(col_plain, StringData(str));
+        }
+        else {
+            obj.remove();
+            keys.erase(keys.begin() + ndx);
+        }
+    }
+    table->verify();
+    check_all();
+
+    std::vector<ObjKey> candidates;
+    StringIndex* ndx = table->get_search_index(col);
+    CHECK_NOT(ndx->find_ngram_candidates({StringData("ab"), StringData("")}, candidates));
+    CHECK(ndx->find_ngram_candidates({StringData("zzz")}, candidates));
+    CHECK(candidates.empty());
+}
+
+TEST(StringIndex_FullText)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col = table->add_column(type_String, "body", true);
+    auto col_list = table->add_column_list(type_String, "list");
+    auto col_int = table->add_column(type_Int, "int");
+
+    CHECK_THROW_EX(table->add_search_index(col_list, IndexType::Fulltext), LogicError,
+                   e.kind() == LogicError::illegal_combination);
+    CHECK_THROW_EX(table->add_search_index(col_int, IndexType::Fulltext), LogicError,
+                   e.kind() == LogicError::illegal_combination);
+    CHECK_THROW_EX(table->where().text_match(col, "apple"), LogicError, e.kind() == LogicError::no_search_index);
+
+    auto o0 = table->create_object().set(col, "The quick brown fox");
+    auto o1 = table->create_object().set(col, "A QUICK red fox, jumping!");
+    auto o2 = table->create_object().set(col, "lazy dog; quick-witted");
+    auto o3 = table->create_object().set(col, "Æble og pære");
+    auto o4 = table->create_object();
+    table->create_object().set(col, "");
+
+    table->add_search_index(col, IndexType::Fulltext);
+    CHECK(table->search_index_type(col) == IndexType::Fulltext);
+    CHECK_NOT(table->has_search_index(col));
+
+    auto matches = [&](StringData text) {
+        return table->where().text_match(col, text).count();
+    };
+    CHECK_EQUAL(matches("quick"), 3);
+    CHECK_EQUAL(matches("Quick fox"), 2);
+    CHECK_EQUAL(matches("quick fox brown"), 1);
+    CHECK_EQUAL(matches("fox, quick!"), 2);
+    CHECK_EQUAL(matches("qui"), 0);
+    CHECK_EQUAL(matches("brown OR red"), 2);
+    CHECK_EQUAL(matches("brown OR dog quick"), 2);
+    CHECK_EQUAL(matches("brown or dog"), 0);
+    CHECK_EQUAL(matches("ÆBLE"), 1);
+    CHECK_EQUAL(matches("pære"), 1);
+    CHECK_EQUAL(matches(""), 0);
+    CHECK_EQUAL(matches(" OR "), 0);
+    CHECK_EQUAL(table->where().text_match(col, "fox").find(), o0.get_key());
+    CHECK_EQUAL(table->where().text_match(col, "fox").not_equal(col, "The quick brown fox").find(), o1.get_key());
+
+    // Updates are reflected in the index
+    o0.set(col, "slow green turtle");
+    o4.set(col, "quick turtle");
+    o2.remove();
+    CHECK_EQUAL(matches("quick"), 2);
+    CHECK_EQUAL(matches("turtle"), 2);
+    CHECK_EQUAL(matches("quick turtle"), 1);
+    CHECK_EQUAL(matches("dog"), 0);
+    o1.set_null(col);
+    CHECK_EQUAL(matches("fox"), 0);
+    table->verify();
+
+    table->remove_search_index(col);
+    CHECK(table->search_index_type(col) == IndexType::None);
+    CHECK_THROW_EX(table->where().text_match(col, "quick"), LogicError, e.kind() == LogicError::no_search_index);
+}
+
+TEST_TYPES(StringIndex_FloatingPoint, float, double)
+{
+    using T = TEST_TYPE;
+    Group g;
+    auto table = g.add_table("foo");
+    auto col = table->add_column(ColumnTypeTraits<T>::id, "value");
+    auto col_nullable = table->add_column(ColumnTypeTraits<T>::id, "nullable", true);
+    auto col_list = table->add_column_list(ColumnTypeTraits<T>::id, "list");
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    const T other_nan = -std::numeric_limits<T>::signaling_NaN();
+
+    std::vector<T> values = {T(1.5), T(0.0), T(-0.0), T(1.5), nan, other_nan, T(-3.25), T(1e10)};
+    std::vector<ObjKey> keys;
+    for (T v : values) {
+        Obj obj = table->create_object().set(col, v).set(col_nullable, v);
+        keys.push_back(obj.get_key());
+    }
+    table->create_object().set(col, T(99)); // null in the nullable column
+    table->add_search_index(col);
+    table->add_search_index(col_nullable);
+    table->add_search_index(col_list);
+    CHECK(table->has_search_index(col));
+
+    auto check_counts = [&](ColKey c) {
+        // -0.0 == 0.0 and NaN never compares equal
+        CHECK_EQUAL(table->where().equal(c, T(0.0)).count(), 2);
+        CHECK_EQUAL(table->where().equal(c, T(-0.0)).count(), 2);
+        CHECK_EQUAL(table->where().equal(c, T(1.5)).count(), 2);
+        CHECK_EQUAL(table->where().equal(c, T(2.5)).count(), 0);
+        CHECK_EQUAL(table->where().equal(c, nan).count(), 0);
+        CHECK_EQUAL(table->where().equal(c, T(-3.25)).find(), keys[6]);
+        CHECK_EQUAL(table->where().equal(c, T(1.5)).greater(c, T(1)).count(), 2);
+        CHECK_EQUAL(table->where().equal(c, T(1.5)).Or().equal(c, T(1e10)).count(), 3);
+        CHECK_EQUAL(table->find_first(c, T(1e10)), keys[7]);
+        CHECK_EQUAL(table->find_first(c, nan), ObjKey());
+    };
+    check_counts(col);
+    check_counts(col_nullable);
+    CHECK_EQUAL(table->where().equal(col_nullable, null()).count(), 1);
+    if constexpr (std::is_same_v<T, float>) {
+        CHECK_EQUAL(table->count_float(col, 1.5f), 2);
+    }
+    else {
+        CHECK_EQUAL(table->count_double(col, 1.5), 2);
+    }
+
+    // Updates are reflected in the index
+    table->get_object(keys[0]).set(col, T(-0.0)).set(col_nullable, T(2.5));
+    table->get_object(keys[1]).set_null(col_nullable);
+    table->remove_object(keys[3]);
+    CHECK_EQUAL(table->where().equal(col, T(0.0)).count(), 3);
+    CHECK_EQUAL(table->where().equal(col, T(1.5)).count(), 0);
+    CHECK_EQUAL(table->where().equal(col_nullable, T(2.5)).count(), 1);
+    CHECK_EQUAL(table->where().equal(col_nullable, null()).count(), 2);
+
+    auto list = table->get_object(keys[1]).get_list<T>(col_list);
+    list.add(T(-0.0));
+    list.add(nan);
+    list.add(T(7));
+    CHECK_EQUAL((table->column<Lst<T>>(col_list) == T(0.0)).count(), 1);
+    CHECK_EQUAL((table->column<Lst<T>>(col_list) == T(7)).count(), 1);
+    list.clear();
+    CHECK_EQUAL((table->column<Lst<T>>(col_list) == T(7)).count(), 0);
+    table->verify();
+}
+
+TEST(StringIndex_Decimal)
+{
+    Group g;
+    auto table = g.add_table("foo");
+    auto col = table->add_column(type_Decimal, "value", true);
+    table->add_search_index(col);
+
+    auto o1 = table->create_object().set(col, Decimal128("1.0"));
+    auto o2 = table->create_object().set(col, Decimal128("1.00"));
+    auto o3 = table->create_object().set(col, Decimal128("100E-2"));
+    auto o4 = table->create_object().set(col, Decimal128("-0.000"));
+    auto o5 = table->create_object().set(col, Decimal128("0"));
+    auto o6 = table->create_object().set(col, Decimal128("1000"));
+    auto o7 = table->create_object().set(col, Decimal128("1E3"));
+    auto o8 = table->create_object().set(col, Decimal128::nan("0"));
+    auto o9 = table->create_object();
+
+    CHECK_EQUAL(table->where().equal(col, Decimal128(1)).count(), 3);
+    CHECK_EQUAL(table->where().equal(col, Decimal128("0.0")).count(), 2);
+    CHECK_EQUAL(table->where().equal(col, Decimal128("1000.000")).count(), 2);
+    CHECK_EQUAL(table->where().equal(col, Decimal128("10")).count(), 0);
+    CHECK_EQUAL(table->where().equal(col, Decimal128::nan("0")).count(), 0);
+    CHECK_EQUAL(table->where().equal(col, realm::null()).count(), 1);
+    CHECK_EQUAL(table->where().equal(col, realm::null()).find(), o9.get_key());
+    CHECK_EQUAL(table->count_decimal(col, Decimal128("1")), 3);
+    CHECK_EQUAL(table->find_first_decimal(col, Decimal128("1E3")), o6.get_key());
+
+    o1.set(col, Decimal128("1E3"));
+    o7.set_null(col);
+    o8.set(col, Decimal128("1"));
+    CHECK_EQUAL(table->where().equal(col, Decimal128(1)).count(), 3);
+    CHECK_EQUAL(table->where().equal(col, Decimal128(1000)).count(), 2);
+    CHECK_EQUAL(table->where().equal(col, realm::null()).count(), 2);
+    o2.remove();
+    o3.remove();
+    o4.remove();
+    CHECK_EQUAL(table->where().equal(col, Decimal128(1)).count(), 1);
+    CHECK_EQUAL(table->where().equal(col, Decimal128(0)).find(), o5.get_key());
+    table->verify();
+}
+
 #endif // TEST_INDEX_STRING
@@ -789,6 +789,33 @@ TEST(Parser_StringOperations)
     CHECK_THROW_ANY(verify_query(test_context, t, "NULL LIKE[c] name", 1));
 }
 
+TEST(Parser_TextMatch)
+{
+    Group g;
+    TableRef t = g.add_table("article");
+    ColKey body_col = t->add_column(type_String, "body", true);
+    ColKey title_col = t->add_column(type_String, "title", true);
+    std::vector<std::string> bodies = {"Realm is a mobile database", "A database for mobile apps", "Cats and dogs",
+                                       "MOBILE phones"};
+    for (auto& body : bodies) {
+        t->create_object().set(body_col, StringData(body)).set(title_col, StringData(body));
+    }
+
+    CHECK_THROW_ANY(verify_query(test_context, t, "body TEXT 'mobile'", 3));
+    t->add_search_index(body_col, IndexType::Fulltext);
+
+    verify_query(test_context, t, "body TEXT 'mobile'", 3);
+    verify_query(test_context, t, "body text 'Mobile Database'", 2);
+    verify_query(test_context, t, "body TEXT 'dogs OR phones'", 2);
+    verify_query(test_context, t, "body TEXT 'mobile' AND title BEGINSWITH 'A'", 1);
+    verify_query(test_context, t, "NOT body TEXT 'mobile'", 1);
+    CHECK_THROW_ANY(verify_query(test_context, t, "'mobile' TEXT body", 0));
+    CHECK_THROW_ANY(verify_query(test_context, t, "title TEXT 'mobile'", 0));
+    std::string message;
+    CHECK_THROW_ANY_GET_MESSAGE(verify_query(test_context, t, "body TEXT[c] 'mobile'", 3), message);
+    CHECK(message.find("[c]") != std::string::npos);
+}
+
 
 TEST(Parser_Timestamps)
 {
@@ -1867,7 +1894,6 @@ TEST(Parser_list_of_primitive_ints)
     auto col_int = t->add_column(type_Int, "single_int");
     auto col_int_list_nullable = t->add_column_list(type_Int, "integers_nullable", true);
     auto col_int_nullable = t->add_column(type_Int, "single_int_nullable", true);
-    CHECK_THROW_ANY(t->add_search_index(col_int_list));
 
     size_t num_objects = 10;
     for (size_t i = 0; i < num_objects; ++i) {
@@ -1920,6 +1946,16 @@ TEST(Parser_list_of_primitive_ints)
         verify_query(test_context, t, util::format("NONE integers != %1", i), 1);
         verify_query(test_context, t, util::format("%1 IN integers", i), 1);
     }
+    // Lists of primitives can be indexed, which must not change the results
+    t->add_search_index(col_int_list);
+    CHECK(t->has_search_index(col_int_list));
+    for (size_t i = 0; i < num_objects; ++i) {
+        verify_query(test_context, t, util::format("integers == %1", i), 1);
+        verify_query(test_context, t, util::format("ANY integers == %1", i), 1);
+        verify_query(test_context, t, util::format("NONE integers == %1", i), num_objects - 1);
+        verify_query(test_context, t, util::format("%1 IN integers", i), 1);
+    }
+    t->remove_search_index(col_int_list);
     verify_query(test_context, t, "integers.@count == 0", 0);
     verify_query(test_context, t, "integers.@size == 0", 0);
     verify_query(test_context, t, "integers.@count == 1", num_objects);
@@ -2067,7 +2103,6 @@ TEST(Parser_list_of_primitive_strings)
 
     constexpr bool nullable = true;
     auto col_str_list = t->add_column_list(type_String, "strings", nullable);
-    CHECK_THROW_ANY(t->add_search_index(col_str_list));
 
     auto get_string = [](size_t i) -> std::string { return util::format("string_%1", i); };
     size_t num_populated_objects = 10;
@@ -2108,6 +2143,19 @@ TEST(Parser_list_of_primitive_strings)
         verify_query(test_context, t, util::format("strings ENDSWITH[c] '%1'", si), 1);
         verify_query(test_context, t, util::format("strings LIKE[c] '%1'", si), 1);
     }
+    // Lists of primitives can be indexed, which must not change the results
+    t->add_search_index(col_str_list);
+    CHECK(t->has_search_index(col_str_list));
+    for (size_t i = 0; i < num_populated_objects; ++i) {
+        std::string si = get_string(i);
+        verify_query(test_context, t, util::format("strings == '%1'", si), 1);
+        verify_query(test_context, t, util::format("ANY strings == '%1'", si), 1);
+        verify_query(test_context, t, util::format("NONE strings == '%1'", si), num_total_objects - 1);
+        verify_query(test_context, t, util::format("'%1' IN strings", si), 1);
+    }
+    verify_query(test_context, t, "strings == NULL", 1);
+    verify_query(test_context, t, "strings == ''", 1);
+    t->remove_search_index(col_str_list);
     verify_query(test_context, t, "strings CONTAINS[c] 'STR'", num_populated_objects);
     verify_query(test_context, t, "strings BEGINSWITH[c] 'STR'", num_populated_objects);
     verify_query(test_context, t, "strings ENDSWITH[c] 'G_1'", 1);
@@ -4364,4 +4412,71 @@ TEST(Parser_Decimal128)
 }
 
 
+TEST(Parser_PreparedQuery)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history(path));
+    DBRef db = DB::create(*hist);
+    {
+        auto wt = db->start_write();
+        TableRef t = wt->add_table("person");
+        ColKey int_col = t->add_column(type_Int, "age");
+        ColKey str_col = t->add_column(type_String, "name", true);
+        ColKey double_col = t->add_column(type_Double, "fees");
+        ColKey link_col = t->add_column_link(type_Link, "buddy", *t);
+        t->add_search_index(str_col);
+        std::vector<std::string> names = {"Billy", "Bob", "Joe", "Jane", "Joel"};
+        std::vector<ObjKey> keys;
+        for (size_t i = 0; i < names.size(); ++i) {
+            Obj obj = t->create_object();
+            obj.set(int_col, int64_t(i * 10));
+            obj.set(str_col, StringData(names[i]));
+            obj.set(double_col, 1.5 * i);
+            keys.push_back(obj.get_key());
+        }
+        t->get_object(keys[1]).set(link_col, keys[0]);
+        wt->commit();
+    }
+
+    query_builder::AnyContext ctx;
+    auto run = [&](query_builder::PreparedQuery& prepared, ConstTableRef table, std::vector<util::Any> values) {
+        query_builder::ArgumentConverter<util::Any, query_builder::AnyContext> args(ctx, values.data(),
+                                                                                    values.size());
+        return prepared.bind(table, args).count();
+    };
+
+    query_builder::PreparedQuery prepared("age >= $0 && (name == $1 || fees < $2) SORT(age DESC)");
+    CHECK_EQUAL(prepared.get_ordering().orderings.size(), 1);
+    {
+        auto rt = db->start_read();
+        ConstTableRef t = rt->get_table("person");
+        CHECK_EQUAL(run(prepared, t, {Int(10), StringData("Joe"), 0.0}), 1);
+        CHECK_NOT(prepared.was_rebound());
+        CHECK_EQUAL(run(prepared, t, {Int(0), StringData("Bob"), 4.0}), 3);
+        CHECK(prepared.was_rebound());
+        CHECK_EQUAL(run(prepared, t, {Int(30), StringData("Billy"), 10.0}), 2);
+        CHECK(prepared.was_rebound());
+        // A null argument needs a query of its own, but leaves the prepared one usable
+        CHECK_EQUAL(run(prepared, t, {Int(0), realm::null(), 0.0}), 0);
+        CHECK_NOT(prepared.was_rebound());
+    }
+    {
+        // The query is reused in a later transaction
+        auto rt = db->start_read();
+        ConstTableRef t = rt->get_table("person");
+        CHECK_EQUAL(run(prepared, t, {Int(20), StringData("Joe"), 0.0}), 1);
+        CHECK(prepared.was_rebound());
+    }
+
+    // Conditions through links are built again for every set of arguments
+    query_builder::PreparedQuery through_link("buddy.age == $0");
+    {
+        auto rt = db->start_read();
+        ConstTableRef t = rt->get_table("person");
+        CHECK_EQUAL(run(through_link, t, {Int(0)}), 1);
+        CHECK_EQUAL(run(through_link, t, {Int(10)}), 0);
+        CHECK_NOT(through_link.was_rebound());
+    }
+}
+
 #endif // TEST_PARSER
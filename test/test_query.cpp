@@ -1451,6 +1451,75 @@ TEST(Query_Expressions0)
     CHECK_EQUAL(match, null_key);
 }
 
+TEST(Query_ExpressionBatches)
+{
+    // Enough rows to span several batches and leaves, with and without nulls in a batch
+    Table table;
+    auto col_a = table.add_column(type_Int, "a", true);
+    auto col_b = table.add_column(type_Int, "b");
+    auto col_d = table.add_column(type_Double, "d", true);
+
+    const size_t num_rows = 2500;
+    for (size_t i = 0; i < num_rows; ++i) {
+        Obj obj = table.create_object().set(col_b, int64_t(i % 17));
+        if (i < 1500 && i % 97 != 0) {
+            obj.set(col_a, int64_t(i % 23));
+            obj.set(col_d, double(i % 11) / 2);
+        }
+        else if (i >= 1500) {
+            obj.set(col_a, int64_t(i % 23));
+            obj.set(col_d, double(i % 11) / 2);
+        }
+    }
+
+    auto a = table.column<Int>(col_a);
+    auto b = table.column<Int>(col_b);
+    auto d = table.column<Double>(col_d);
+
+    auto check = [&](Query q, auto&& pred) {
+        std::vector<ObjKey> expected;
+        for (auto& obj : table) {
+            if (pred(obj))
+                expected.push_back(obj.get_key());
+        }
+        TableView tv = q.find_all();
+        CHECK_EQUAL(tv.size(), expected.size());
+        for (size_t i = 0; i < std::min(tv.size(), expected.size()); ++i) {
+            CHECK_EQUAL(tv.get_key(i), expected[i]);
+        }
+        // Restricting the query to a view evaluates one object at a time
+        TableView all = table.where().find_all();
+        CHECK_EQUAL(table.where(&all).and_query(q).count(), expected.size());
+    };
+
+    check(a * b > 100, [&](const Obj& obj) {
+        auto va = obj.get<util::Optional<Int>>(col_a);
+        return va && *va * obj.get<Int>(col_b) > 100;
+    });
+    check(a > b, [&](const Obj& obj) {
+        auto va = obj.get<util::Optional<Int>>(col_a);
+        return va && *va > obj.get<Int>(col_b);
+    });
+    check(b == a + 1, [&](const Obj& obj) {
+        auto va = obj.get<util::Optional<Int>>(col_a);
+        return va && *va + 1 == obj.get<Int>(col_b);
+    });
+    check(2 * d - b < 1.5, [&](const Obj& obj) {
+        auto vd = obj.get<util::Optional<Double>>(col_d);
+        return vd && 2 * *vd - obj.get<Int>(col_b) < 1.5;
+    });
+    check(a == null(), [&](const Obj& obj) {
+        return obj.is_null(col_a);
+    });
+    check(b - 3 != a, [&](const Obj& obj) {
+        auto va = obj.get<util::Optional<Int>>(col_a);
+        return !va || obj.get<Int>(col_b) - 3 != *va;
+    });
+    check(b / 2 >= 4, [&](const Obj& obj) {
+        return obj.get<Int>(col_b) / 2 >= 4;
+    });
+}
+
 TEST(Query_StrIndexCrash)
 {
     // Rasmus "8" index crash
@@ -5390,4 +5459,353 @@ TEST(Query_AllocatorBug)
     CHECK_EQUAL(cnt, 421);
 }
 
+TEST(Query_Statistics)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_double = table.add_column(type_Double, "double");
+    auto col_str = table.add_column(type_String, "str");
+    table.add_search_index(col_int);
+    table.add_search_index(col_double);
+
+    for (int i = 0; i < 2000; i++) {
+        auto obj = table.create_object();
+        obj.set(col_int, i % 3);
+        obj.set(col_double, double(i % 500));
+        obj.set(col_str, util::format("s%1", i % 7));
+    }
+
+    auto check = [&] {
+        CHECK_EQUAL(table.where().equal(col_int, 1).count(), 667);
+        CHECK_EQUAL(table.where().equal(col_double, 10.0).count(), 4);
+        CHECK_EQUAL(table.where().equal(col_int, 2).equal(col_double, 600.0).count(), 0);
+        CHECK_EQUAL(table.where().equal(col_int, 2).equal(col_double, 5.0).count(), 2);
+        CHECK_EQUAL(table.where().equal(col_str, "s3").greater(col_double, 450.0).count(), 28);
+        CHECK_EQUAL(table.where().less(col_double, 100.0).equal(col_int, 0).count(), 134);
+        CHECK_EQUAL(table.where().equal(col_int, 1).sum_int(col_int), 667);
+
+        auto tv = table.where().greater_equal(col_int, 1).equal(col_str, "s0").find_all();
+        size_t expected = 0;
+        for (auto& obj : table) {
+            if (obj.get<Int>(col_int) >= 1 && obj.get<String>(col_str) == "s0")
+                CHECK_EQUAL(tv.get(expected++).get_key(), obj.get_key());
+        }
+        CHECK_EQUAL(tv.size(), expected);
+    };
+
+    check();
+    table.update_statistics();
+    check();
+}
+
+TEST(Query_ResultCache)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history(path));
+    DBOptions options(crypt_key());
+    options.query_result_cache_size = 1024 * 1024;
+    DBRef db = DB::create(*hist, options);
+    QueryResultCache* cache = db->get_query_result_cache();
+    CHECK(cache);
+
+    ColKey col_int, col_double;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        col_int = table->add_column(type_Int, "int");
+        col_double = table->add_column(type_Double, "double");
+        for (int i = 0; i < 100; ++i)
+            table->create_object().set(col_int, i % 10).set(col_double, i / 3.0);
+        auto other = wt->add_table("other");
+        other->add_column(type_Int, "int");
+        wt->commit();
+    }
+
+    auto check = [&](size_t count, double sum) {
+        auto rt = db->start_read();
+        auto table = rt->get_table("table");
+        Query q = table->where().equal(col_int, 3);
+        CHECK_EQUAL(q.count(), count);
+        CHECK_EQUAL(q.find_all().size(), count);
+        CHECK_EQUAL(q.find(), q.find_all().get_key(0));
+        CHECK_APPROXIMATELY_EQUAL(table->where().greater(col_double, 10.0).sum_double(col_double), sum, 1e-9);
+    };
+
+    check(10, 1495.0);
+    size_t hits = cache->get_hit_count();
+    check(10, 1495.0);
+    CHECK_EQUAL(cache->get_hit_count(), hits + 5);
+
+    // Changing another table keeps the results
+    {
+        auto wt = db->start_write();
+        wt->get_table("other")->create_object();
+        wt->commit();
+    }
+    hits = cache->get_hit_count();
+    check(10, 1495.0);
+    CHECK_EQUAL(cache->get_hit_count(), hits + 5);
+
+    // Changing the table discards them
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        table->create_object().set(col_int, 3).set(col_double, 20.0);
+        wt->commit();
+    }
+    hits = cache->get_hit_count();
+    check(11, 1515.0);
+    // Only the second find_all() is a hit
+    CHECK_EQUAL(cache->get_hit_count(), hits + 1);
+
+    // Results are not cached for tables with uncommitted changes
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        table->create_object().set(col_int, 3);
+        size_t misses = cache->get_miss_count();
+        CHECK_EQUAL(table->where().equal(col_int, 3).count(), 12);
+        CHECK_EQUAL(cache->get_miss_count(), misses);
+        wt->rollback();
+    }
+    check(11, 1515.0);
+
+    // A recreated table does not see the results of the removed one
+    for (int round = 0; round < 2; ++round) {
+        uint64_t old_version = *db->start_read()->get_table("other")->get_commit_version();
+        {
+            auto wt = db->start_write();
+            wt->remove_table("other");
+            wt->commit();
+        }
+        {
+            auto wt = db->start_write();
+            auto other = wt->add_table("other");
+            auto col = other->add_column(type_Int, "int");
+            for (int i = 0; i <= round; ++i)
+                other->create_object().set(col, 5);
+            wt->commit();
+        }
+        auto rt = db->start_read();
+        auto other = rt->get_table("other");
+        CHECK_GREATER(*other->get_commit_version(), old_version);
+        CHECK_EQUAL(other->where().equal(other->get_column_key("int"), 5).count(), round + 1);
+    }
+
+    // Old results are evicted when the budget is exceeded
+    CHECK(cache->get_memory_usage() > 0);
+    CHECK(cache->get_memory_usage() <= cache->get_memory_budget());
+    QueryResultCache small(1024);
+    for (int i = 0; i < 100; ++i) {
+        QueryResultCache::Result result;
+        result.count = i;
+        small.insert(util::format("query %1", i), {}, result);
+        CHECK(small.get_memory_usage() <= 1024);
+    }
+    QueryResultCache::Result result;
+    CHECK(small.lookup("query 99", {}, result));
+    CHECK_EQUAL(result.count, 99);
+    CHECK_NOT(small.lookup("query 0", {}, result));
+}
+
+TEST(Query_Iterate)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_str = table.add_column(type_String, "str", true);
+
+    CHECK_NOT(table.where().iterate().next());
+
+    for (int i = 0; i < 2000; ++i) {
+        auto obj = table.create_object(ObjKey(i * 3));
+        obj.set(col_int, i % 7);
+        if (i % 5)
+            obj.set(col_str, util::format("s%1", i % 11));
+    }
+
+    auto check_matches = [&](Query q) {
+        ConstTableView tv = q.find_all();
+        std::vector<ObjKey> keys;
+        auto cursor = q.iterate();
+        while (ObjKey key = cursor.next())
+            keys.push_back(key);
+        CHECK_NOT(cursor.next());
+        CHECK_EQUAL(keys.size(), tv.size());
+        for (size_t i = 0; i < keys.size() && i < tv.size(); ++i)
+            CHECK_EQUAL(keys[i], tv.get_key(i));
+    };
+
+    check_matches(table.where());
+    check_matches(table.where().equal(col_int, 3));
+    check_matches(table.where().equal(col_int, 3).Or().equal(col_str, "s4"));
+    check_matches(table.where().equal(col_str, realm::null()));
+    check_matches(table.where().greater(col_int, 10));
+    check_matches(table.column<Int>(col_int) + 1 == 4);
+
+    // Restricted by a view
+    ConstTableView view = table.where().less(col_int, 3).find_all();
+    view.sort(col_int);
+    check_matches(table.where(&view).equal(col_str, "s2"));
+
+    // Iteration can be suspended and resumed, also after running other queries
+    Query q = table.where().equal(col_int, 5);
+    auto cursor = q.iterate();
+    std::vector<ObjKey> keys;
+    size_t batches = 0;
+    while (cursor.next_batch(keys)) {
+        CHECK(!keys.empty());
+        CHECK(keys.size() <= REALM_MAX_BPNODE_SIZE);
+        CHECK_EQUAL(table.where().equal(col_int, 5).count(), 285);
+        batches++;
+        for (auto key : keys)
+            CHECK_EQUAL(table.get_object(key).get<Int>(col_int), 5);
+    }
+    CHECK(batches > 1);
+    CHECK_NOT(cursor.next_batch(keys));
+
+    // Mixing next() and next_batch() yields each match once
+    cursor = q.iterate();
+    size_t count = 0;
+    CHECK(cursor.next());
+    count++;
+    while (cursor.next_batch(keys)) {
+        count += keys.size();
+        if (ObjKey key = cursor.next()) {
+            CHECK_EQUAL(table.get_object(key).get<Int>(col_int), 5);
+            count++;
+        }
+    }
+    CHECK_EQUAL(count, 285);
+}
+
+TEST(Query_BitmapCombination)
+{
+    // Conditions matching most objects, so that they are evaluated as bitmaps
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_null = table.add_column(type_Int, "null", true);
+    auto col_double = table.add_column(type_Double, "double");
+    auto col_str = table.add_column(type_String, "str");
+
+    for (int i = 0; i < 3000; ++i) {
+        auto obj = table.create_object();
+        obj.set(col_int, i % 4);
+        if (i % 3)
+            obj.set(col_null, i % 5);
+        obj.set(col_double, i % 7 * 0.5);
+        obj.set(col_str, i % 2 ? "odd" : "even");
+    }
+
+    auto check = [&](Query q, util::FunctionRef<bool(const Obj&)> pred) {
+        size_t count = 0;
+        int64_t sum = 0;
+        double max = -1;
+        std::vector<ObjKey> keys;
+        for (auto& obj : table) {
+            if (pred(obj)) {
+                count++;
+                sum += obj.get<Int>(col_int);
+                max = std::max(max, obj.get<double>(col_double));
+                keys.push_back(obj.get_key());
+            }
+        }
+        CHECK_EQUAL(q.count(), count);
+        CHECK_EQUAL(q.sum_int(col_int), sum);
+        if (count)
+            CHECK_EQUAL(q.maximum_double(col_double), max);
+        auto tv = q.find_all();
+        CHECK_EQUAL(tv.size(), keys.size());
+        for (size_t i = 0; i < keys.size() && i < tv.size(); ++i)
+            CHECK_EQUAL(tv.get_key(i), keys[i]);
+    };
+
+    check(table.where().greater(col_int, 0).not_equal(col_str, "odd"), [&](const Obj& obj) {
+        return obj.get<Int>(col_int) > 0 && obj.get<String>(col_str) != "odd";
+    });
+    check(table.where().not_equal(col_null, 4).less(col_double, 2.5).greater_equal(col_int, 1),
+          [&](const Obj& obj) {
+              auto v = obj.get<util::Optional<Int>>(col_null);
+              return (!v || *v != 4) && obj.get<double>(col_double) < 2.5 && obj.get<Int>(col_int) >= 1;
+          });
+    check(table.where()
+              .less(col_int, 3)
+              .group()
+              .equal(col_str, "odd")
+              .Or()
+              .greater(col_double, 1.0)
+              .end_group()
+              .Not()
+              .equal(col_null, realm::null()),
+          [&](const Obj& obj) {
+              return obj.get<Int>(col_int) < 3 &&
+                     (obj.get<String>(col_str) == "odd" || obj.get<double>(col_double) > 1.0) &&
+                     !obj.is_null(col_null);
+          });
+    check(table.where().not_equal(col_int, 2).Not().group().equal(col_str, "even").less(col_double, 3.0).end_group(),
+          [&](const Obj& obj) {
+              return obj.get<Int>(col_int) != 2 &&
+                     !(obj.get<String>(col_str) == "even" && obj.get<double>(col_double) < 3.0);
+          });
+}
+
+TEST(Query_ExplainAnalyze)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_str = table.add_column(type_String, "str");
+    auto col_double = table.add_column(type_Double, "double");
+    table.add_search_index(col_str);
+    for (int i = 0; i < 5000; ++i)
+        table.create_object().set(col_int, i % 100).set(col_str, util::format("s%1", i % 50)).set(col_double, i * 0.5);
+
+    auto explanation = table.where().explain_analyze();
+    CHECK_EQUAL(explanation.strategy, "all");
+    CHECK_EQUAL(explanation.count, 5000);
+    CHECK(explanation.nodes.empty());
+
+    Query q = table.where().greater(col_int, 90).less(col_double, 1000.0);
+    explanation = q.explain_analyze();
+    CHECK_EQUAL(explanation.strategy, "scan");
+    CHECK_EQUAL(explanation.count, q.count());
+    CHECK_EQUAL(explanation.description, q.get_description());
+    CHECK(explanation.leaves > 0);
+    CHECK_EQUAL(explanation.nodes.size(), 2);
+    CHECK_EQUAL(explanation.plan.size(), 2);
+    size_t times_best = 0;
+    for (auto& node : explanation.nodes) {
+        CHECK_EQUAL(node.depth, 0);
+        CHECK_NOT(node.uses_index);
+        CHECK(node.rows_tested > 0);
+        CHECK(node.matches <= node.rows_tested);
+        CHECK_EQUAL(node.leaves, explanation.leaves);
+        times_best += node.times_best;
+    }
+    CHECK(times_best > 0);
+    CHECK(explanation.nodes[0].description.find("int > 90") != std::string::npos);
+    CHECK(explanation.to_string().find("int > 90") != std::string::npos);
+
+    // Counting must not leave the query instrumented
+    CHECK_EQUAL(q.count(), explanation.count);
+
+    q = table.where().equal(col_str, "s7");
+    explanation = q.explain_analyze();
+    CHECK_EQUAL(explanation.strategy, "index");
+    CHECK_EQUAL(explanation.count, 100);
+    CHECK(explanation.nodes[0].uses_index);
+    CHECK(explanation.nodes[0].index_lookups > 0);
+    CHECK_EQUAL(explanation.nodes[0].rows_tested, 100);
+    CHECK_EQUAL(explanation.nodes[0].times_best, 1);
+
+    // Conditions of an Or node are nested in it
+    q = table.where().greater(col_double, 100.0).group().equal(col_int, 3).Or().less(col_int, 2).end_group();
+    explanation = q.explain_analyze();
+    CHECK_EQUAL(explanation.count, q.count());
+    CHECK_EQUAL(explanation.nodes.size(), 4);
+    CHECK_EQUAL(explanation.plan.size(), 2);
+    CHECK_EQUAL(explanation.nodes[1].depth, 0);
+    CHECK_EQUAL(explanation.nodes[2].depth, 1);
+    CHECK_EQUAL(explanation.nodes[3].depth, 1);
+    CHECK(explanation.nodes[2].rows_tested > 0);
+}
+
 #endif // TEST_QUERY
@@ -3210,6 +3210,166 @@ TEST(Query_DeepLink)
     CHECK_EQUAL(N - 1, view.size());
 }
 
+TEST(Query_LinkPathSemiJoin)
+{
+    Group group;
+    TableRef persons = group.add_table("person");
+    TableRef dogs = group.add_table("dog");
+    TableRef houses = group.add_table("house");
+    auto col_age = persons->add_column(type_Int, "age", true);
+    auto col_name = persons->add_column(type_String, "name");
+    auto col_owner = dogs->add_column_link(type_Link, "owner", *persons);
+    auto col_walkers = dogs->add_column_link(type_LinkList, "walkers", *persons);
+    auto col_dog = houses->add_column_link(type_Link, "dog", *dogs);
+
+    std::vector<ObjKey> person_keys;
+    for (int i = 0; i < 100; ++i) {
+        Obj p = persons->create_object().set(col_name, util::to_string(i % 10));
+        if (i % 7)
+            p.set(col_age, int64_t(i));
+        person_keys.push_back(p.get_key());
+    }
+    for (int i = 0; i < 300; ++i) {
+        Obj d = dogs->create_object();
+        if (i % 5)
+            d.set(col_owner, person_keys[(i * 3) % 100]);
+        auto walkers = d.get_linklist(col_walkers);
+        for (int j = 0; j < i % 4; ++j)
+            walkers.add(person_keys[(i + j * 11) % 100]);
+        houses->create_object().set(col_dog, d.get_key());
+    }
+
+    auto owner_age = [&](const Obj& dog) -> util::Optional<int64_t> {
+        ObjKey owner = dog.get<ObjKey>(col_owner);
+        if (!owner)
+            return util::none;
+        return persons->get_object(owner).get<util::Optional<int64_t>>(col_age);
+    };
+    auto count_dogs = [&](auto&& pred) {
+        size_t n = 0;
+        for (auto& dog : *dogs) {
+            if (pred(dog))
+                ++n;
+        }
+        return n;
+    };
+
+    // Few matching targets: matches are found through backlinks
+    Query q = dogs->link(col_owner).column<Int>(col_age) == 42;
+    CHECK_EQUAL(q.count(), count_dogs([&](const Obj& d) {
+                    return owner_age(d) == util::Optional<int64_t>(42);
+                }));
+    // Many matching targets: each dog is tested for linking to one of them
+    q = dogs->link(col_owner).column<Int>(col_age) > 3;
+    CHECK_EQUAL(q.count(), count_dogs([&](const Obj& d) {
+                    auto age = owner_age(d);
+                    return age && *age > 3;
+                }));
+    // Dogs without owner must match here, so this cannot be a semi-join
+    q = dogs->link(col_owner).column<Int>(col_age) == null();
+    CHECK_EQUAL(q.count(), count_dogs([&](const Obj& d) {
+                    return !owner_age(d);
+                }));
+    q = dogs->link(col_owner).column<Int>(col_age) != 42;
+    CHECK_EQUAL(q.count(), count_dogs([&](const Obj& d) {
+                    return owner_age(d) != util::Optional<int64_t>(42);
+                }));
+
+    // Link list, any walker named "3"
+    q = dogs->link(col_walkers).column<String>(col_name) == "3";
+    CHECK_EQUAL(q.count(), count_dogs([&](const Obj& d) {
+                    auto walkers = d.get_linklist(col_walkers);
+                    for (size_t i = 0; i < walkers.size(); ++i) {
+                        if (walkers.get_object(i).get<String>(col_name) == "3")
+                            return true;
+                    }
+                    return false;
+                }));
+    // All walkers named "3" is still evaluated per dog
+    q = LinkChain(dogs, ExpressionComparisonType::All).link(col_walkers).column<String>(col_name) == "3";
+    CHECK_EQUAL(q.count(), count_dogs([&](const Obj& d) {
+                    auto walkers = d.get_linklist(col_walkers);
+                    for (size_t i = 0; i < walkers.size(); ++i) {
+                        if (walkers.get_object(i).get<String>(col_name) != "3")
+                            return false;
+                    }
+                    return true;
+                }));
+
+    // Two hops
+    q = houses->link(col_dog).link(col_owner).column<Int>(col_age) >= 90;
+    size_t expected = 0;
+    for (auto& house : *houses) {
+        auto age = owner_age(dogs->get_object(house.get<ObjKey>(col_dog)));
+        if (age && *age >= 90)
+            ++expected;
+    }
+    CHECK_EQUAL(q.count(), expected);
+
+    // Through backlinks: persons walking a dog owned by someone named "7"
+    q = persons->backlink(*dogs, col_walkers).link(col_owner).column<String>(col_name) == "7";
+    expected = 0;
+    for (auto& person : *persons) {
+        size_t n = person.get_backlink_count(*dogs, col_walkers);
+        for (size_t i = 0; i < n; ++i) {
+            ObjKey owner = dogs->get_object(person.get_backlink(*dogs, col_walkers, i)).get<ObjKey>(col_owner);
+            if (owner && persons->get_object(owner).get<String>(col_name) == "7") {
+                ++expected;
+                break;
+            }
+        }
+    }
+    CHECK_EQUAL(q.count(), expected);
+
+    // Subquery count
+    Query young = persons->column<Int>(col_age) < 30;
+    q = dogs->column<Link>(col_walkers, young).count() >= 2;
+    CHECK_EQUAL(q.count(), count_dogs([&](const Obj& d) {
+                    auto walkers = d.get_linklist(col_walkers);
+                    size_t n = 0;
+                    for (size_t i = 0; i < walkers.size(); ++i) {
+                        auto age = walkers.get_object(i).get<util::Optional<int64_t>>(col_age);
+                        if (age && *age < 30)
+                            ++n;
+                    }
+                    return n >= 2;
+                }));
+
+    // The target side is evaluated again when the query is rerun
+    q = dogs->link(col_owner).column<Int>(col_age) == 42;
+    size_t before = q.count();
+    persons->get_object(person_keys[3]).set(col_age, 42);
+    CHECK_EQUAL(q.count(), before + count_dogs([&](const Obj& d) {
+                               return d.get<ObjKey>(col_owner) == person_keys[3];
+                           }));
+
+    // Queries restricted by a view are evaluated per row
+    q = dogs->link(col_owner).column<Int>(col_age) > 3;
+    ConstTableView owned = (dogs->column<Link>(col_owner) != null()).find_all();
+    Query restricted = dogs->where(&owned).and_query(q);
+    CHECK_EQUAL(restricted.count(), count_dogs([&](const Obj& d) {
+                    auto age = owner_age(d);
+                    return age && *age > 3;
+                }));
+    q = dogs->column<Link>(col_walkers, young).count() >= 2;
+    restricted = dogs->where(&owned).and_query(q);
+    size_t n_young_walked = 0;
+    for (auto& dog : *dogs) {
+        if (!dog.get<ObjKey>(col_owner))
+            continue;
+        auto walkers = dog.get_linklist(col_walkers);
+        size_t n = 0;
+        for (size_t i = 0; i < walkers.size(); ++i) {
+            auto age = walkers.get_object(i).get<util::Optional<int64_t>>(col_age);
+            if (age && *age < 30)
+                ++n;
+        }
+        if (n >= 2)
+            ++n_young_walked;
+    }
+    CHECK_EQUAL(restricted.count(), n_young_walked);
+}
+
 TEST(Query_LinksToDeletedOrMovedRow)
 {
     // This test is not that relevant with stable keys
@@ -4811,6 +4971,99 @@ TEST(Query_LinksTo)
     CHECK_EQUAL(found_key, source_keys[2]);
 }
 
+TEST(Query_LinksToBacklinks)
+{
+    Group group;
+
+    TableRef source = group.add_table("source");
+    TableRef target = group.add_table("target");
+
+    auto col_int = source->add_column(type_Int, "int");
+    auto col_link = source->add_column_link(type_Link, "link", *target);
+    auto col_linklist = source->add_column_link(type_LinkList, "linklist", *target);
+
+    std::vector<ObjKey> target_keys;
+    target->create_objects(50, target_keys);
+
+    // Enough objects to span several clusters
+    for (int i = 0; i < 2000; ++i) {
+        Obj obj = source->create_object();
+        obj.set(col_int, i);
+        obj.set(col_link, target_keys[i % 50]);
+        auto list = obj.get_linklist(col_linklist);
+        if (i % 3 == 0) {
+            // The same target twice must only produce the origin object once
+            list.add(target_keys[i % 7]);
+            list.add(target_keys[i % 7]);
+        }
+    }
+
+    auto check = [&](Query q, std::function<bool(const ConstObj&)> pred) {
+        size_t expected = 0;
+        int64_t expected_sum = 0;
+        ObjKey first;
+        for (auto& obj : *source) {
+            if (pred(obj)) {
+                if (!first)
+                    first = obj.get_key();
+                ++expected;
+                expected_sum += obj.get<Int>(col_int);
+            }
+        }
+        CHECK_EQUAL(q.count(), expected);
+        CHECK_EQUAL(q.find_all().size(), expected);
+        CHECK_EQUAL(q.sum_int(col_int), expected_sum);
+        CHECK_EQUAL(q.find(), first);
+    };
+    auto links_to = [&](const ConstObj& obj, std::vector<ObjKey> keys) {
+        ObjKey link = obj.get<ObjKey>(col_link);
+        return std::find(keys.begin(), keys.end(), link) != keys.end();
+    };
+    auto list_links_to = [&](const ConstObj& obj, ObjKey key) {
+        auto list = obj.get_linklist(col_linklist);
+        return list.find_first(key) != realm::npos;
+    };
+
+    check(source->where().links_to(col_link, target_keys[3]), [&](const ConstObj& obj) {
+        return links_to(obj, {target_keys[3]});
+    });
+    check(source->where().links_to(col_link, {target_keys[40], target_keys[3], null_key}),
+          [&](const ConstObj& obj) {
+              return links_to(obj, {target_keys[40], target_keys[3]});
+          });
+    check(source->where().links_to(col_linklist, target_keys[5]), [&](const ConstObj& obj) {
+        return list_links_to(obj, target_keys[5]);
+    });
+    check(source->where().greater(col_int, 1000).links_to(col_link, target_keys[7]), [&](const ConstObj& obj) {
+        return obj.get<Int>(col_int) > 1000 && links_to(obj, {target_keys[7]});
+    });
+    check(source->where().Not().links_to(col_link, target_keys[7]), [&](const ConstObj& obj) {
+        return !links_to(obj, {target_keys[7]});
+    });
+    check(source->where().links_to(col_link, target_keys[1]).Or().links_to(col_linklist, target_keys[2]),
+          [&](const ConstObj& obj) {
+              return links_to(obj, {target_keys[1]}) || list_links_to(obj, target_keys[2]);
+          });
+
+    // Restricted to a view
+    TableView view = source->where().less(col_int, 500).find_all();
+    Query q = source->where(&view).links_to(col_link, target_keys[9]);
+    size_t expected = 0;
+    for (size_t i = 0; i < view.size(); ++i) {
+        if (links_to(view.get(i), {target_keys[9]}))
+            ++expected;
+    }
+    CHECK_EQUAL(q.count(), expected);
+
+    // A removed target is no longer linked to
+    ObjKey removed = target_keys[11];
+    target->remove_object(removed);
+    CHECK_EQUAL(source->where().links_to(col_link, removed).count(), 0);
+    check(source->where().links_to(col_link, {removed, target_keys[12]}), [&](const ConstObj& obj) {
+        return links_to(obj, {target_keys[12]});
+    });
+}
+
 TEST(Query_Group_bug)
 {
     // Tests for a bug in queries with OR nodes at different nesting levels
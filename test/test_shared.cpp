@@ -3924,6 +3924,120 @@ TEST(Shared_RemoveTableWithEnumAndLinkColumns)
     }
 }
 
+TEST(Shared_RemoveTableDeferredDestroy)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    DBRef db = DB::create(path);
+    const size_t num_rows = 20000;
+    const size_t num_cols = 64;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("big");
+        for (size_t i = 0; i < num_cols; i++)
+            table->add_column(type_Int, "int_" + util::to_string(i));
+        auto col_str = table->add_column(type_String, "str");
+        table->add_search_index(col_str);
+        for (size_t i = 0; i < num_rows; i++)
+            table->create_object(ObjKey(i)).set(col_str, "Name " + util::to_string(i % 100));
+        auto other = wt->add_table("other");
+        auto col_int = other->add_column(type_Int, "int");
+        other->add_column(type_String, "str");
+        for (size_t i = 0; i < 1000; i++)
+            other->create_object().set(col_int, int64_t(i));
+        wt->commit();
+    }
+
+    // Removing a column leaves its leaves to be freed later
+    {
+        auto wt = db->start_write();
+        auto other = wt->get_table("other");
+        other->remove_column(other->get_column_key("str"));
+        CHECK_GREATER(wt->get_deferred_destroy_count(), 0);
+        // The slots added in front of the list read as if they were missing
+        CHECK_EQUAL(wt->get_sync_file_id(), 0);
+        wt->verify();
+        CHECK_GREATER(wt->destroy_deferred(size_t(-1)), 0);
+        CHECK_EQUAL(wt->get_deferred_destroy_count(), 0);
+        CHECK_EQUAL(wt->destroy_deferred(10), 0);
+        wt->verify();
+        wt->commit();
+    }
+
+    // A slot given a value while the list exists is kept when it goes away
+    {
+        auto wt = db->start_write();
+        auto other = wt->get_table("other");
+        other->remove_column(other->get_column_key("int"));
+        wt->set_sync_file_id(7);
+        CHECK_GREATER(wt->destroy_deferred(size_t(-1)), 0);
+        wt->commit();
+    }
+    {
+        auto rt = db->start_read();
+        CHECK_EQUAL(rt->get_sync_file_id(), 7);
+        CHECK_EQUAL(rt->get_deferred_destroy_count(), 0);
+        rt->verify();
+    }
+
+    // A rollback restores the table
+    {
+        auto wt = db->start_write();
+        wt->remove_table("big");
+        CHECK_NOT(wt->has_table("big"));
+        CHECK_GREATER(wt->get_deferred_destroy_count(), 0);
+        wt->rollback();
+    }
+    {
+        auto rt = db->start_read();
+        CHECK_EQUAL(rt->get_table("big")->size(), num_rows);
+        CHECK_EQUAL(rt->get_deferred_destroy_count(), 0);
+    }
+
+    // The table is gone right away, and the name can be reused
+    {
+        auto wt = db->start_write();
+        wt->remove_table("big");
+        CHECK_NOT(wt->has_table("big"));
+        CHECK_EQUAL(wt->size(), 1);
+        auto table = wt->add_table("big");
+        CHECK_EQUAL(table->get_column_count(), 0);
+        wt->verify();
+
+        // Free a few nodes at a time
+        for (int i = 0; i < 10; i++) {
+            CHECK_EQUAL(wt->destroy_deferred(10), 10);
+            CHECK_GREATER(wt->get_deferred_destroy_count(), 0);
+        }
+        wt->verify();
+        wt->commit();
+    }
+
+    // The commit frees a bounded number of nodes, the rest is persisted
+    {
+        auto rt = db->start_read();
+        CHECK_GREATER(rt->get_deferred_destroy_count(), 0);
+        rt->verify();
+    }
+    db->close();
+    db = DB::create(path);
+    {
+        auto rt = db->start_read();
+        CHECK_GREATER(rt->get_deferred_destroy_count(), 0);
+        CHECK_EQUAL(rt->get_table("other")->size(), 1000);
+    }
+    for (int i = 0; i < 10; i++) {
+        auto wt = db->start_write();
+        wt->get_table("other")->create_object();
+        wt->commit();
+    }
+    {
+        auto wt = db->start_write();
+        CHECK_EQUAL(wt->get_deferred_destroy_count(), 0);
+        CHECK_EQUAL(wt->get_table("other")->size(), 1010);
+        wt->verify();
+    }
+}
+
 TEST(Shared_GenerateObjectIdAfterRollback)
 {
     // Test case generated in [realm-core-6.0.0-alpha.0] on Mon Aug 13 14:43:06 2018.
@@ -4283,4 +4397,77 @@ TEST(Shared_ManyColumns)
     foo->create_object().set("Prop0", 500);
 }
 
+namespace {
+
+// This must match the file header declared in alloc_slab.hpp
+struct FileHeader {
+    uint64_t m_top_ref[2];
+    uint8_t m_mnemonic[4];
+    uint8_t m_file_format[2];
+    uint8_t m_reserved;
+    uint8_t m_flags;
+};
+
+} // anonymous namespace
+
+// Files of format 20 keep their format when opened without history, so data
+// requiring format 21 must not be written to them
+TEST(Shared_FileFormat20Features)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    ColKey col;
+    {
+        DBRef db = DB::create(path);
+        auto wt = db->start_write();
+        col = wt->add_table("table")->add_column(type_String, "str");
+        wt->commit();
+    }
+    {
+        util::File f(path, util::File::mode_Update);
+        util::File::Map<FileHeader> header_map(f, util::File::access_ReadWrite);
+        auto header = header_map.get_addr();
+        CHECK(header->m_file_format[0] == 21 || header->m_file_format[1] == 21);
+        header->m_file_format[0] = header->m_file_format[1] = 20;
+        header_map.sync();
+    }
+    {
+        DBRef db = DB::create(path);
+        auto wt = db->start_write();
+        CHECK_EQUAL(_impl::GroupFriend::get_file_format_version(*wt), 20);
+        auto table = wt->get_table("table");
+        CHECK_LOGIC_ERROR(table->add_search_index(col, IndexType::CaseInsensitive), LogicError::file_format_too_old);
+        CHECK_LOGIC_ERROR(table->add_search_index(col, IndexType::NGram), LogicError::file_format_too_old);
+        CHECK_LOGIC_ERROR(table->add_search_index(col, IndexType::Fulltext), LogicError::file_format_too_old);
+        CHECK_NOT(table->has_search_index(col));
+        table->add_search_index(col);
+        CHECK_LOGIC_ERROR(table->add_search_index(col, IndexType::CaseInsensitive), LogicError::file_format_too_old);
+        CHECK_LOGIC_ERROR(table->add_search_index(col, IndexType::NGram), LogicError::file_format_too_old);
+        CHECK(table->search_index_type(col) == IndexType::General);
+        auto empty = wt->add_table("empty");
+        size_t default_node_size = empty->get_cluster_node_size();
+        CHECK_LOGIC_ERROR(empty->set_cluster_node_size(16), LogicError::file_format_too_old);
+        empty->set_cluster_node_size(0);
+        CHECK_EQUAL(empty->get_cluster_node_size(), default_node_size);
+        wt->commit();
+    }
+    {
+        // Opening the file with history upgrades it
+        std::unique_ptr<Replication> hist(make_in_realm_history(path));
+        DBRef db = DB::create(*hist);
+        auto wt = db->start_write();
+        CHECK_EQUAL(_impl::GroupFriend::get_file_format_version(*wt), 21);
+        auto table = wt->get_table("table");
+        table->add_search_index(col, IndexType::CaseInsensitive);
+        CHECK(table->search_index_type(col) == IndexType::CaseInsensitive);
+        table->add_search_index(col, IndexType::NGram);
+        CHECK(table->search_index_type(col) == IndexType::NGram);
+        table->add_search_index(col, IndexType::Fulltext);
+        CHECK(table->search_index_type(col) == IndexType::Fulltext);
+        auto empty = wt->get_table("empty");
+        empty->set_cluster_node_size(16);
+        CHECK_EQUAL(empty->get_cluster_node_size(), 16);
+        wt->commit();
+    }
+}
+
 #endif // TEST_SHARED
@@ -2196,6 +2196,122 @@ TEST(Table_AddColumnWithThreeLevelBptree)
     table.verify();
 }
 
+TEST(Table_AddColumnDefaults)
+{
+    Group g;
+    Table& table = *g.add_table("table");
+    std::vector<ObjKey> keys;
+    table.add_column(type_Int, "int0");
+    table.create_objects(3 * REALM_MAX_BPNODE_SIZE + 11, keys);
+
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_int_null = table.add_column(type_Int, "int_null", true);
+    auto col_bool = table.add_column(type_Bool, "bool");
+    auto col_bool_null = table.add_column(type_Bool, "bool_null", true);
+    auto col_float_null = table.add_column(type_Float, "float_null", true);
+    auto col_double = table.add_column(type_Double, "double");
+    auto col_double_null = table.add_column(type_Double, "double_null", true);
+    auto col_str = table.add_column(type_String, "str");
+    auto col_str_null = table.add_column(type_String, "str_null", true);
+    auto col_ts_null = table.add_column(type_Timestamp, "ts_null", true);
+    auto col_link = table.add_column_link(type_Link, "link", table);
+    table.verify();
+
+    for (auto col : {col_int_null, col_bool_null, col_float_null, col_double_null, col_str_null, col_ts_null}) {
+        CHECK_EQUAL(table.where().equal(col, null()).count(), keys.size());
+    }
+    for (auto key : {keys.front(), keys.back()}) {
+        ConstObj obj = table.get_object(key);
+        CHECK_EQUAL(obj.get<Int>(col_int), 0);
+        CHECK_EQUAL(obj.get<Bool>(col_bool), false);
+        CHECK_EQUAL(obj.get<Double>(col_double), 0.);
+        CHECK_EQUAL(obj.get<String>(col_str), "");
+        CHECK_NOT(obj.get<String>(col_str).is_null());
+        CHECK(obj.is_null(col_link));
+    }
+
+    // The default leaves can be written to like any other
+    Obj obj = table.get_object(keys[5]);
+    obj.set(col_int, 7).set(col_int_null, 0).set(col_str_null, "foo").set(col_ts_null, Timestamp(1, 2));
+    obj.set(col_double_null, 1.5).set(col_link, keys[6]);
+    CHECK_EQUAL(obj.get<util::Optional<Int>>(col_int_null), 0);
+    CHECK(table.get_object(keys[4]).is_null(col_int_null));
+    CHECK_EQUAL(obj.get<Timestamp>(col_ts_null), Timestamp(1, 2));
+    CHECK(table.get_object(keys[6]).is_null(col_ts_null));
+    CHECK_EQUAL(table.where().equal(col_str_null, "foo").count(), 1);
+    CHECK_EQUAL(table.where().equal(col_double_null, null()).count(), keys.size() - 1);
+    CHECK_EQUAL(table.get_object(keys[6]).get_backlink_count(), 1);
+    table.create_object();
+    table.remove_object(keys[0]);
+    table.verify();
+}
+
+TEST(Table_ClusterNodeSize)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    DBRef db = DB::create(path);
+    const int64_t num_rows = 2000;
+    auto max_cluster_size = [](ConstTableRef table) {
+        size_t max_size = 0;
+        table->traverse_clusters([&](const Cluster* cluster) {
+            max_size = std::max(max_size, cluster->node_size());
+            return false;
+        });
+        return max_size;
+    };
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        auto col_int = table->add_column(type_Int, "int");
+        auto col_str = table->add_column(type_String, "str", true);
+        CHECK_EQUAL(table->get_cluster_node_size(), size_t(1) << ClusterTree::s_default_node_shift_factor);
+        CHECK_LOGIC_ERROR(table->set_cluster_node_size(2), LogicError::illegal_combination);
+        CHECK_LOGIC_ERROR(table->set_cluster_node_size(48), LogicError::illegal_combination);
+        table->set_cluster_node_size(8);
+        CHECK_EQUAL(table->get_cluster_node_size(), 8);
+
+        // Compact and general form clusters
+        for (int64_t i = 0; i < num_rows; i++)
+            table->create_object(ObjKey(i)).set(col_int, i);
+        for (int64_t i = 0; i < num_rows; i++)
+            table->create_object(ObjKey(3 * num_rows - 2 * i)).set(col_int, i).set(col_str, "str");
+        CHECK_EQUAL(max_cluster_size(table), 8);
+        table->verify();
+        CHECK_LOGIC_ERROR(table->set_cluster_node_size(64), LogicError::illegal_combination);
+
+        // Merging
+        for (int64_t i = 0; i < num_rows; i += 3)
+            table->remove_object(ObjKey(i));
+        table->verify();
+        CHECK_EQUAL(table->size(), 2 * num_rows - (num_rows + 2) / 3);
+        CHECK_EQUAL(table->get_object(ObjKey(1)).get<Int>(col_int), 1);
+        CHECK_EQUAL(table->get_object(ObjKey(3 * num_rows)).get<String>(col_str), "str");
+        wt->commit();
+    }
+    db->close();
+    db = DB::create(path);
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("table");
+        CHECK_EQUAL(table->get_cluster_node_size(), 8);
+        CHECK_EQUAL(table->size(), 2 * num_rows - (num_rows + 2) / 3);
+        table->verify();
+
+        table->clear();
+        table->set_cluster_node_size(1024);
+        std::vector<ObjKey> keys;
+        table->create_objects(size_t(num_rows), keys);
+        CHECK_EQUAL(max_cluster_size(table), 1024);
+        table->verify();
+        wt->rollback();
+    }
+    {
+        auto rt = db->start_read();
+        CHECK_EQUAL(rt->get_table("table")->get_cluster_node_size(), 8);
+        rt->get_table("table")->verify();
+    }
+}
+
 TEST(Table_DeleteObjectsInFirstCluster)
 {
     // Designed to exercise logic if cluster size is 4
@@ -2231,6 +2347,708 @@ TEST(Table_ClearWithTwoLevelBptree)
     table.verify();
 }
 
+TEST(Table_BulkInsert)
+{
+    Group g;
+    auto target = g.add_table("target");
+    auto table = g.add_table("table");
+    auto col_int = table->add_column(type_Int, "int");
+    auto col_int_null = table->add_column(type_Int, "int_null", true);
+    auto col_str = table->add_column(type_String, "str");
+    auto col_date = table->add_column(type_Timestamp, "date", true);
+    auto col_link = table->add_column_link(type_Link, "link", *target);
+    auto col_list = table->add_column_list(type_Int, "list");
+    auto col_idx = table->add_column(type_String, "indexed", true);
+    table->add_search_index(col_idx);
+    std::vector<ObjKey> target_keys;
+    target->create_objects(10, target_keys);
+
+    const size_t num_rows = 2 * REALM_MAX_BPNODE_SIZE + 17;
+    std::vector<ObjKey> keys;
+    std::vector<Mixed> ints, int_nulls, strs, dates, links;
+    std::vector<std::string> strings;
+    for (size_t i = 0; i < num_rows; i++) {
+        strings.push_back("str " + util::to_string(i));
+    }
+    for (size_t i = 0; i < num_rows; i++) {
+        keys.push_back(ObjKey(i));
+        ints.push_back(int64_t(i));
+        int_nulls.push_back(i % 3 ? Mixed(int64_t(i)) : Mixed());
+        strs.push_back(StringData(strings[i]));
+        dates.push_back(i % 5 ? Mixed(Timestamp(i, 0)) : Mixed());
+        links.push_back(i % 2 ? Mixed(target_keys[i % 10]) : Mixed());
+    }
+    std::vector<ColumnValues> columns;
+    columns.emplace_back(col_str, strs);
+    columns.emplace_back(col_int, ints);
+    columns.emplace_back(col_int_null, int_nulls);
+    columns.emplace_back(col_date, dates);
+    columns.emplace_back(col_link, links);
+    table->bulk_insert(keys, columns);
+
+    CHECK_EQUAL(table->size(), num_rows);
+    table->verify();
+    size_t backlinks = 0;
+    for (size_t i = 0; i < num_rows; i++) {
+        Obj obj = table->get_object(ObjKey(i));
+        CHECK_EQUAL(obj.get<Int>(col_int), int64_t(i));
+        CHECK_EQUAL(obj.is_null(col_int_null), i % 3 == 0);
+        CHECK_EQUAL(obj.get<String>(col_str), strings[i]);
+        CHECK_EQUAL(obj.is_null(col_date), i % 5 == 0);
+        CHECK_EQUAL(obj.get<ObjKey>(col_link), i % 2 ? target_keys[i % 10] : ObjKey());
+        CHECK_EQUAL(obj.get_list<Int>(col_list).size(), 0);
+        CHECK(obj.is_null(col_idx));
+        if (i % 10 == 1)
+            backlinks++;
+    }
+    CHECK_EQUAL(target->get_object(target_keys[1]).get_backlink_count(), backlinks);
+    CHECK_EQUAL(table->find_first_int(col_int, 1234), ObjKey(1234));
+    CHECK_EQUAL(table->where().equal(col_idx, StringData()).count(), num_rows);
+
+    // Keys with gaps are appended as new leaves
+    keys.clear();
+    std::vector<Mixed> idx_values;
+    for (size_t i = 0; i < num_rows; i++) {
+        keys.push_back(ObjKey(5000 + 3 * i));
+        idx_values.push_back(StringData(strings[i % 10]));
+    }
+    columns.clear();
+    columns.emplace_back(col_idx, idx_values);
+    table->bulk_insert(keys, columns);
+    CHECK_EQUAL(table->size(), 2 * num_rows);
+    table->verify();
+    CHECK_EQUAL(table->get_object(ObjKey(5003)).get<String>(col_idx), "str 1");
+    CHECK_EQUAL(table->get_object(ObjKey(5003)).get<Int>(col_int), 0);
+    CHECK_EQUAL(table->where().equal(col_idx, "str 7").count(), num_rows / 10);
+    CHECK_NOT(table->is_valid(ObjKey(5001)));
+
+    // Keys in between existing objects are inserted one by one
+    table->bulk_insert({ObjKey(5001), ObjKey(5002)}, {{col_int, {int64_t(7), int64_t(8)}}});
+    CHECK_EQUAL(table->size(), 2 * num_rows + 2);
+    CHECK_EQUAL(table->get_object(ObjKey(5002)).get<Int>(col_int), 8);
+    table->verify();
+
+    CHECK_THROW(table->bulk_insert({ObjKey(100000)}, {{col_int, {}}}), LogicError);
+    CHECK_THROW(table->bulk_insert({ObjKey(100000)}, {{col_list, {Mixed()}}}), LogicError);
+
+    // A rejected batch leaves the table unchanged
+    size_t size = table->size();
+    size_t target_backlinks = target->get_object(target_keys[0]).get_backlink_count();
+    auto check_rejected = [&] {
+        CHECK_EQUAL(table->size(), size);
+        CHECK_NOT(table->is_valid(ObjKey(100000)));
+        CHECK_EQUAL(target->get_object(target_keys[0]).get_backlink_count(), target_backlinks);
+        table->verify();
+        target->verify();
+    };
+    CHECK_LOGIC_ERROR(table->bulk_insert({ObjKey(100000), ObjKey(100001)},
+                                         {{col_link, {Mixed(target_keys[0]), Mixed(ObjKey(99))}}}),
+                      LogicError::target_row_index_out_of_range);
+    check_rejected();
+    CHECK_LOGIC_ERROR(table->bulk_insert({ObjKey(100000), ObjKey(100001)},
+                                         {{col_link, {Mixed(target_keys[0]), Mixed(int64_t(1))}}}),
+                      LogicError::illegal_type);
+    check_rejected();
+    CHECK_LOGIC_ERROR(table->bulk_insert({ObjKey(100000)}, {{col_int, {Mixed()}}}), LogicError::column_not_nullable);
+    check_rejected();
+    CHECK_LOGIC_ERROR(table->bulk_insert({ObjKey(100000)}, {{col_int, {int64_t(1)}}, {col_int, {int64_t(2)}}}),
+                      LogicError::illegal_combination);
+    check_rejected();
+    CHECK_LOGIC_ERROR(table->bulk_insert({ObjKey(100000), ObjKey(-5)}, {{col_link, {Mixed(target_keys[0]), Mixed()}}}),
+                      LogicError::row_index_out_of_range);
+    check_rejected();
+    CHECK_THROW(table->bulk_insert({ObjKey(100000), ObjKey(5003)}, {{col_link, {Mixed(target_keys[0]), Mixed()}}}),
+                KeyAlreadyUsed);
+    check_rejected();
+    CHECK_THROW(table->bulk_insert({ObjKey(100000), ObjKey(1), ObjKey(100000)}, {}), KeyAlreadyUsed);
+    check_rejected();
+}
+
+TEST(Table_BulkInsertReplication)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history(path));
+    DBRef db = DB::create(*hist);
+    ColKey col_int;
+    {
+        auto wt = db->start_write();
+        col_int = wt->add_table("table")->add_column(type_Int, "int");
+        wt->commit();
+    }
+    auto rt = db->start_read();
+
+    struct CreateObserver : _impl::NullInstructionObserver {
+        std::vector<ObjKey> created;
+        size_t modified = 0;
+        bool modified_before_created = false;
+        bool create_object(ObjKey key)
+        {
+            created.push_back(key);
+            return true;
+        }
+        bool modify_object(ColKey, ObjKey key)
+        {
+            ++modified;
+            modified_before_created |= std::find(created.begin(), created.end(), key) == created.end();
+            return true;
+        }
+    };
+
+    const size_t num_rows = REALM_MAX_BPNODE_SIZE + 17;
+    std::vector<ObjKey> keys;
+    std::vector<Mixed> ints;
+    for (size_t i = 0; i < num_rows; i++) {
+        keys.push_back(ObjKey(i));
+        ints.push_back(int64_t(i * 2));
+    }
+    {
+        auto wt = db->start_write();
+        wt->get_table("table")->bulk_insert(keys, {{col_int, ints}});
+        wt->commit();
+    }
+    CreateObserver observer;
+    rt->advance_read(&observer);
+    CHECK(observer.created == keys);
+    CHECK_EQUAL(observer.modified, num_rows);
+    // Objects are created before their values are set
+    CHECK_NOT(observer.modified_before_created);
+
+    auto table = rt->get_table("table");
+    CHECK_EQUAL(table->size(), num_rows);
+    for (size_t i = 0; i < num_rows; i += 101) {
+        CHECK_EQUAL(table->get_object(keys[i]).get<Int>(col_int), int64_t(i * 2));
+    }
+
+    // Objects created one by one are replicated the same way
+    keys = {ObjKey(num_rows + 5), ObjKey(num_rows + 3)};
+    {
+        auto wt = db->start_write();
+        wt->get_table("table")->bulk_insert(keys, {{col_int, {int64_t(1), int64_t(2)}}});
+        wt->commit();
+    }
+    CreateObserver observer_2;
+    rt->advance_read(&observer_2);
+    CHECK(observer_2.created == keys);
+    CHECK_NOT(observer_2.modified_before_created);
+    CHECK_EQUAL(table->get_object(keys[1]).get<Int>(col_int), 2);
+}
+
+TEST(Table_RemoveObjects)
+{
+    Group g;
+    auto target = g.add_table("target");
+    auto table = g.add_table("table");
+    auto origin = g.add_table("origin");
+    auto col_int = table->add_column(type_Int, "int");
+    auto col_str = table->add_column(type_String, "str");
+    auto col_link = table->add_column_link(type_Link, "link", *target);
+    auto col_list = table->add_column_link(type_LinkList, "list", *target);
+    auto col_origin = origin->add_column_link(type_Link, "link", *table);
+    table->add_search_index(col_str);
+
+    std::vector<ObjKey> target_keys;
+    target->create_objects(10, target_keys);
+    const size_t num_rows = 3 * REALM_MAX_BPNODE_SIZE + 7;
+    for (size_t i = 0; i < num_rows; i++) {
+        Obj obj = table->create_object(ObjKey(i));
+        obj.set(col_int, int64_t(i));
+        obj.set(col_str, util::to_string(i % 10));
+        obj.set(col_link, target_keys[i % 10]);
+        obj.get_linklist(col_list).add(target_keys[(i + 1) % 10]);
+        if (i % 100 == 0)
+            origin->create_object().set(col_origin, ObjKey(i));
+    }
+
+    // Every third object, all objects in a range of whole leaves, and the last ones
+    std::vector<ObjKey> keys;
+    for (size_t i = 0; i < num_rows; i++) {
+        if (i % 3 == 0 || (i >= REALM_MAX_BPNODE_SIZE && i < 2 * REALM_MAX_BPNODE_SIZE) || i >= num_rows - 5)
+            keys.push_back(ObjKey(i));
+    }
+    std::reverse(keys.begin(), keys.end());
+    keys.push_back(keys.back());
+    table->remove_objects(keys);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    CHECK_EQUAL(table->size(), num_rows - keys.size());
+    table->verify();
+    size_t count = 0;
+    for (size_t i = 0; i < num_rows; i++) {
+        bool removed = std::binary_search(keys.begin(), keys.end(), ObjKey(i));
+        CHECK_EQUAL(table->is_valid(ObjKey(i)), !removed);
+        if (!removed) {
+            Obj obj = table->get_object(ObjKey(i));
+            CHECK_EQUAL(obj.get<Int>(col_int), int64_t(i));
+            CHECK_EQUAL(obj.get<String>(col_str), util::to_string(i % 10));
+            if (i % 10 == 7)
+                count++;
+        }
+    }
+    CHECK_EQUAL(table->where().equal(col_str, "7").count(), count);
+    CHECK_EQUAL(table->find_first_string(col_str, "7"), ObjKey(7));
+    CHECK_EQUAL(target->get_object(target_keys[7]).get_backlink_count(*table, col_link), count);
+    CHECK_EQUAL(target->get_object(target_keys[8]).get_backlink_count(*table, col_list), count);
+    size_t nullified = 0;
+    for (auto o : *origin) {
+        ObjKey linked = o.get<ObjKey>(col_origin);
+        CHECK(!linked || table->is_valid(linked));
+        if (!linked)
+            nullified++;
+    }
+    CHECK_EQUAL(nullified, 18);
+
+    CHECK_THROW(table->remove_objects({ObjKey(0)}), KeyNotFound);
+
+    // Query::remove() removes the matches in one batch
+    size_t num_removed = table->where().less(col_int, 500).remove();
+    CHECK_EQUAL(num_removed, 333);
+    CHECK_EQUAL(table->where().less(col_int, 500).count(), 0);
+    table->verify();
+
+    // Removing all objects leaves an empty tree to insert into
+    std::vector<ObjKey> all;
+    for (auto o : *table)
+        all.push_back(o.get_key());
+    table->remove_objects(all);
+    CHECK_EQUAL(table->size(), 0);
+    CHECK_EQUAL(table->where().equal(col_str, "7").count(), 0);
+    CHECK_EQUAL(target->get_object(target_keys[7]).get_backlink_count(), 0);
+    table->verify();
+    table->create_object(ObjKey(5)).set(col_str, "7");
+    CHECK_EQUAL(table->find_first_string(col_str, "7"), ObjKey(5));
+}
+
+TEST(Table_KeyRange)
+{
+    Group g;
+    auto target = g.add_table("target");
+    auto table = g.add_table("table");
+    auto col_int = table->add_column(type_Int, "int");
+
+    // Enough objects for the tree to have subtrees below the root holding only
+    // objects in the range removed below. Small nodes keep the tree deep.
+    const size_t node_size = 16;
+    table->set_cluster_node_size(node_size);
+    const size_t num_rows = 2 * node_size * node_size + 1000;
+    std::vector<ObjKey> keys;
+    ColumnValues values{col_int, {}};
+    for (size_t i = 0; i < num_rows; i++) {
+        keys.push_back(ObjKey(2 * i));
+        values.values.push_back(int64_t(i));
+    }
+    table->bulk_insert(keys, {values});
+
+    auto it = table->lower_bound(ObjKey(11));
+    CHECK_EQUAL(it->get_key(), ObjKey(12));
+    CHECK_EQUAL(it->get<Int>(col_int), 6);
+    ++it;
+    CHECK_EQUAL(it->get_key(), ObjKey(14));
+    CHECK(table->lower_bound(ObjKey(2 * num_rows)) == table->end());
+    CHECK(table->lower_bound(ObjKey(-5)) == table->begin());
+
+    Query q = table->where().key_range(ObjKey(100), ObjKey(200));
+    CHECK_EQUAL(q.count(), 50);
+    CHECK_EQUAL(q.find(), ObjKey(100));
+    CHECK_EQUAL(q.sum_int(col_int), (50 + 99) * 50 / 2);
+    CHECK_EQUAL(q.find_all().size(), 50);
+    CHECK_EQUAL(table->where().key_range(ObjKey(100), ObjKey(200)).greater(col_int, 89).count(), 10);
+    CHECK_EQUAL(table->where().key_range(ObjKey(0), ObjKey(200)).key_range(ObjKey(100), ObjKey(1000)).count(), 50);
+    CHECK_EQUAL(table->where().key_range(ObjKey(0), ObjKey(10)).Or().key_range(ObjKey(100), ObjKey(110)).count(),
+                10);
+    CHECK_EQUAL(table->where().key_range(ObjKey(2 * num_rows - 10), ObjKey(2 * num_rows + 10)).count(), 5);
+    CHECK_EQUAL(table->where().key_range(ObjKey(200), ObjKey(100)).count(), 0);
+
+    // Remove all but the first and last 500 objects
+    size_t removed = table->remove_object_range(ObjKey(1000), ObjKey(2 * num_rows - 1000));
+    CHECK_EQUAL(removed, num_rows - 1000);
+    CHECK_EQUAL(table->size(), 1000);
+    table->verify();
+    size_t ndx = 0;
+    for (auto o : *table) {
+        size_t i = ndx < 500 ? ndx : num_rows - 1000 + ndx;
+        CHECK_EQUAL(o.get_key(), ObjKey(2 * i));
+        CHECK_EQUAL(o.get<Int>(col_int), int64_t(i));
+        ndx++;
+    }
+    CHECK_EQUAL(table->remove_object_range(ObjKey(1000), ObjKey(2 * num_rows - 1000)), 0);
+    CHECK_EQUAL(table->where().key_range(ObjKey(0), ObjKey(2 * num_rows)).count(), 1000);
+    table->create_object(ObjKey(1001)).set(col_int, 1001);
+    CHECK_EQUAL(table->lower_bound(ObjKey(999))->get_key(), ObjKey(1001));
+
+    // Backlinks are removed from the targets of removed objects
+    auto col_link = table->add_column_link(type_Link, "link", *target);
+    ObjKey target_key = target->create_object().get_key();
+    for (auto o : *table)
+        o.set(col_link, target_key);
+    CHECK_EQUAL(table->remove_object_range(ObjKey(0), ObjKey(100)), 50);
+    CHECK_EQUAL(target->get_object(target_key).get_backlink_count(), 951);
+    table->verify();
+}
+
+TEST(Table_ColumnScan)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_int_null = table.add_column(type_Int, "int_null", true);
+    auto col_float = table.add_column(type_Float, "float");
+    auto col_double_null = table.add_column(type_Double, "double_null", true);
+    auto col_str = table.add_column(type_String, "str");
+
+    ColumnSpan<Int> int_span;
+    CHECK_NOT(table.scan<Int>(col_int).next(int_span));
+
+    const size_t num_rows = 3 * REALM_MAX_BPNODE_SIZE + 11;
+    for (size_t i = 0; i < num_rows; i++) {
+        Obj obj = table.create_object(ObjKey(2 * i));
+        // Values of different bit widths
+        obj.set(col_int, int64_t(i % 3 == 0 ? i : -int64_t(i % 17)));
+        obj.set(col_float, float(i) / 2);
+        if (i % 5) {
+            obj.set(col_int_null, int64_t(i));
+            obj.set(col_double_null, double(i) / 4);
+        }
+    }
+    table.remove_object(ObjKey(20));
+
+    size_t ndx = 0;
+    size_t num_spans = 0;
+    auto int_scan = table.scan<Int>(col_int);
+    while (int_scan.next(int_span)) {
+        CHECK_NOT(int_span.nulls);
+        for (size_t i = 0; i < int_span.size; ++i, ++ndx) {
+            ConstObj obj = table.get_object(ndx);
+            CHECK_EQUAL(int_scan.get_key(i), obj.get_key());
+            CHECK_EQUAL(int_span[i], obj.get<Int>(col_int));
+        }
+        num_spans++;
+    }
+    CHECK_EQUAL(ndx, table.size());
+    CHECK_GREATER_EQUAL(num_spans, 2);
+    CHECK_NOT(int_scan.next(int_span));
+
+    ndx = 0;
+    size_t nulls = 0;
+    auto int_null_scan = table.scan<Int>(col_int_null);
+    while (int_null_scan.next(int_span)) {
+        for (size_t i = 0; i < int_span.size; ++i, ++ndx) {
+            auto value = table.get_object(ndx).get<util::Optional<Int>>(col_int_null);
+            CHECK_EQUAL(int_span.is_null(i), !value);
+            CHECK_EQUAL(int_span[i], value ? *value : 0);
+            nulls += int_span.is_null(i);
+        }
+    }
+    CHECK_EQUAL(nulls, table.where().equal(col_int_null, null()).count());
+
+    ndx = 0;
+    ColumnSpan<float> float_span;
+    auto float_scan = table.scan<float>(col_float);
+    while (float_scan.next(float_span)) {
+        CHECK_NOT(float_span.nulls);
+        for (size_t i = 0; i < float_span.size; ++i, ++ndx)
+            CHECK_EQUAL(float_span[i], table.get_object(ndx).get<Float>(col_float));
+    }
+    CHECK_EQUAL(ndx, table.size());
+
+    ndx = 0;
+    double sum = 0;
+    ColumnSpan<double> double_span;
+    auto double_scan = table.scan<double>(col_double_null);
+    while (double_scan.next(double_span)) {
+        for (size_t i = 0; i < double_span.size; ++i, ++ndx) {
+            CHECK_EQUAL(double_span.is_null(i), table.get_object(ndx).is_null(col_double_null));
+            if (!double_span.is_null(i))
+                sum += double_span[i];
+        }
+    }
+    CHECK_EQUAL(sum, table.sum_double(col_double_null));
+
+    CHECK_THROW(table.scan<double>(col_int), LogicError);
+    CHECK_THROW(table.scan<Int>(col_str), LogicError);
+}
+
+TEST(Table_Projection)
+{
+    Group g;
+    TableRef table = g.add_table("table");
+    TableRef target = g.add_table("target");
+    auto col_int = table->add_column(type_Int, "int");
+    auto col_int_null = table->add_column(type_Int, "int_null", true);
+    auto col_bool = table->add_column(type_Bool, "bool");
+    auto col_double = table->add_column(type_Double, "double", true);
+    auto col_str = table->add_column(type_String, "str", true);
+    auto col_ts = table->add_column(type_Timestamp, "ts");
+    auto col_link = table->add_column_link(type_Link, "link", *target);
+    auto col_list = table->add_column_list(type_Int, "list");
+    ObjKey target_key = target->create_object().get_key();
+
+    {
+        Projection proj(table, {col_int});
+        CHECK_NOT(proj.next());
+        CHECK_THROW(proj.get<Int>(0), std::runtime_error);
+    }
+
+    const size_t num_rows = 3 * REALM_MAX_BPNODE_SIZE + 11;
+    for (size_t i = 0; i < num_rows; i++) {
+        Obj obj = table->create_object(ObjKey(2 * i));
+        obj.set(col_int, int64_t(i));
+        obj.set(col_bool, i % 2 == 0);
+        obj.set(col_ts, Timestamp(i, 0));
+        if (i % 3) {
+            obj.set(col_int_null, int64_t(i));
+            obj.set(col_double, double(i) / 2);
+            obj.set(col_str, StringData(util::to_string(i)));
+            obj.set(col_link, target_key);
+        }
+    }
+
+    std::vector<ColKey> cols = {col_int, col_int_null, col_bool, col_double, col_str, col_ts, col_link};
+    Projection proj(table, cols);
+    CHECK_EQUAL(proj.get_column_count(), cols.size());
+    size_t ndx = 0;
+    while (proj.next()) {
+        ConstObj obj = table->get_object(ndx++);
+        CHECK_EQUAL(proj.get_key(), obj.get_key());
+        CHECK_EQUAL(proj.get<Int>(0), obj.get<Int>(col_int));
+        CHECK_EQUAL(proj.get<util::Optional<Int>>(1), obj.get<util::Optional<Int>>(col_int_null));
+        CHECK_EQUAL(proj.get<Bool>(2), obj.get<Bool>(col_bool));
+        CHECK_EQUAL(proj.get<Timestamp>(5), obj.get<Timestamp>(col_ts));
+        CHECK_EQUAL(proj.get<ObjKey>(6), obj.get<ObjKey>(col_link));
+        for (size_t i = 0; i < cols.size(); i++)
+            CHECK_EQUAL(proj.is_null(i), obj.is_null(cols[i]));
+        if (!proj.is_null(3)) {
+            CHECK_EQUAL(proj.get<Double>(3), obj.get<Double>(col_double));
+            CHECK_EQUAL(proj.get<String>(4), obj.get<String>(col_str));
+        }
+    }
+    CHECK_EQUAL(ndx, num_rows);
+    CHECK_EQUAL(proj.get_key(), ObjKey());
+
+    // The projection follows its object through modifications
+    proj.set_key(ObjKey(10));
+    CHECK_EQUAL(proj.get<Int>(0), 5);
+    table->get_object(ObjKey(10)).set(col_int, 100);
+    table->create_object(ObjKey(1));
+    CHECK_EQUAL(proj.get<Int>(0), 100);
+    CHECK(proj.next());
+    CHECK_EQUAL(proj.get_key(), ObjKey(12));
+
+    // and continues after it if it has been removed
+    proj.set_key(ObjKey(10));
+    table->remove_object(ObjKey(10));
+    CHECK_THROW(proj.get<Int>(0), KeyNotFound);
+    CHECK(proj.next());
+    CHECK_EQUAL(proj.get_key(), ObjKey(12));
+    CHECK_EQUAL(proj.get<Int>(0), 6);
+
+    CHECK_THROW(proj.set_key(ObjKey(3)), KeyNotFound);
+    CHECK_THROW(Projection(table, {col_list}), LogicError);
+}
+
+TEST(Table_ArrowExport)
+{
+    Group g;
+    TableRef table = g.add_table("table");
+    TableRef target = g.add_table("target");
+    auto col_int = table->add_column(type_Int, "int");
+    auto col_int_null = table->add_column(type_Int, "int_null", true);
+    auto col_bool = table->add_column(type_Bool, "bool", true);
+    auto col_float = table->add_column(type_Float, "float");
+    auto col_double = table->add_column(type_Double, "double", true);
+    auto col_str = table->add_column(type_String, "str", true);
+    auto col_bin = table->add_column(type_Binary, "bin");
+    auto col_ts = table->add_column(type_Timestamp, "ts", true);
+    auto col_oid = table->add_column(type_ObjectId, "oid", true);
+    auto col_link = table->add_column_link(type_Link, "link", *target);
+    ObjKey target_key = target->create_object().get_key();
+
+    const size_t num_rows = 3 * REALM_MAX_BPNODE_SIZE + 11;
+    for (size_t i = 0; i < num_rows; i++) {
+        Obj obj = table->create_object(ObjKey(2 * i));
+        obj.set(col_int, int64_t(i) * 1000);
+        obj.set(col_float, float(i));
+        std::string bin(i % 4, 'x');
+        obj.set(col_bin, BinaryData(bin.data(), bin.size()));
+        if (i % 3) {
+            obj.set(col_int_null, int64_t(i));
+            obj.set(col_bool, i % 2 == 0);
+            obj.set(col_double, double(i) / 2);
+            obj.set(col_str, StringData(util::to_string(i)));
+            obj.set(col_ts, Timestamp(i, 5));
+            obj.set(col_oid, ObjectId("000000000000000000000001"));
+            obj.set(col_link, target_key);
+        }
+    }
+
+    auto is_valid = [](const ArrowArray* array, size_t ndx) {
+        auto bits = static_cast<const uint8_t*>(array->buffers[0]);
+        return !bits || (bits[ndx >> 3] >> (ndx & 7)) & 1;
+    };
+    auto get_string = [](const ArrowArray* array, size_t ndx) {
+        auto offsets = static_cast<const int32_t*>(array->buffers[1]);
+        auto data = static_cast<const char*>(array->buffers[2]);
+        return std::string(data + offsets[ndx], data + offsets[ndx + 1]);
+    };
+
+    ArrowArray array;
+    ArrowSchema schema;
+    export_to_arrow(*table, {}, &array, &schema);
+    CHECK_EQUAL(std::string(schema.format), "+s");
+    CHECK_EQUAL(schema.n_children, 10);
+    CHECK_EQUAL(array.n_children, 10);
+    CHECK_EQUAL(array.length, int64_t(num_rows));
+    const char* formats[] = {"l", "l", "b", "f", "g", "u", "z", "tsn:", "w:12", "l"};
+    for (size_t c = 0; c < 10; c++) {
+        CHECK_EQUAL(std::string(schema.children[c]->format), formats[c]);
+        CHECK_EQUAL(array.children[c]->length, int64_t(num_rows));
+    }
+    CHECK_EQUAL(std::string(schema.children[1]->name), "int_null");
+    CHECK_EQUAL(schema.children[0]->flags, 0);
+    CHECK_EQUAL(schema.children[1]->flags, ARROW_FLAG_NULLABLE);
+    CHECK_EQUAL(array.children[0]->null_count, 0);
+    CHECK_EQUAL(array.children[1]->null_count, int64_t((num_rows + 2) / 3));
+
+    auto ints = static_cast<const int64_t*>(array.children[0]->buffers[1]);
+    auto int_nulls = static_cast<const int64_t*>(array.children[1]->buffers[1]);
+    auto bools = static_cast<const uint8_t*>(array.children[2]->buffers[1]);
+    auto floats = static_cast<const float*>(array.children[3]->buffers[1]);
+    auto doubles = static_cast<const double*>(array.children[4]->buffers[1]);
+    auto bin_offsets = static_cast<const int32_t*>(array.children[6]->buffers[1]);
+    auto timestamps = static_cast<const int64_t*>(array.children[7]->buffers[1]);
+    auto oids = static_cast<const uint8_t*>(array.children[8]->buffers[1]);
+    auto links = static_cast<const int64_t*>(array.children[9]->buffers[1]);
+    for (size_t i = 0; i < num_rows; i++) {
+        CHECK_EQUAL(ints[i], int64_t(i) * 1000);
+        CHECK_EQUAL(floats[i], float(i));
+        CHECK_EQUAL(bin_offsets[i + 1] - bin_offsets[i], int32_t(i % 4));
+        bool valid = i % 3 != 0;
+        for (size_t c = 1; c < 10; c++) {
+            if (c != 3 && c != 6)
+                CHECK_EQUAL(is_valid(array.children[c], i), valid);
+        }
+        if (valid) {
+            CHECK_EQUAL(int_nulls[i], int64_t(i));
+            CHECK_EQUAL(((bools[i >> 3] >> (i & 7)) & 1) == 1, i % 2 == 0);
+            CHECK_EQUAL(doubles[i], double(i) / 2);
+            CHECK_EQUAL(get_string(array.children[5], i), util::to_string(i));
+            CHECK_EQUAL(timestamps[i], int64_t(i) * 1000000000 + 5);
+            CHECK_EQUAL(oids[i * 12 + 11], 1);
+            CHECK_EQUAL(links[i], target_key.value);
+        }
+    }
+
+    // The consumer may move a child out and release it independently
+    ArrowArray child = *array.children[5];
+    array.children[5]->release = nullptr;
+    array.release(&array);
+    CHECK(array.release == nullptr);
+    CHECK_EQUAL(get_string(&child, 1), "1");
+    child.release(&child);
+    schema.release(&schema);
+
+    // Views are exported in the order of the view
+    TableView tv = table->where().greater(col_int, 1000 * int64_t(REALM_MAX_BPNODE_SIZE)).find_all();
+    tv.sort(col_int, false);
+    export_to_arrow(tv, {col_int, col_str}, &array, &schema);
+    CHECK_EQUAL(array.length, int64_t(tv.size()));
+    CHECK_EQUAL(schema.n_children, 2);
+    ints = static_cast<const int64_t*>(array.children[0]->buffers[1]);
+    for (size_t i = 0; i < tv.size(); i++) {
+        CHECK_EQUAL(ints[i], tv.get_object(i).get<Int>(col_int));
+        CHECK_EQUAL(is_valid(array.children[1], i), !tv.get_object(i).is_null(col_str));
+    }
+    array.release(&array);
+    schema.release(&schema);
+
+    Query query = table->where().equal(col_bool, true);
+    export_to_arrow(query, {col_int}, &array, &schema);
+    CHECK_EQUAL(array.length, int64_t(query.count()));
+    ints = static_cast<const int64_t*>(array.children[0]->buffers[1]);
+    CHECK_EQUAL(ints[0], 2000);
+    array.release(&array);
+    schema.release(&schema);
+
+    table->remove_object(tv.get_key(0));
+    CHECK_THROW(export_to_arrow(tv, {col_int}, &array, &schema), KeyNotFound);
+    auto col_list = table->add_column_list(type_Int, "list");
+    auto col_decimal = table->add_column(type_Decimal, "decimal");
+    CHECK_THROW(export_to_arrow(*table, {col_list}, &array, &schema), LogicError);
+    CHECK_THROW(export_to_arrow(*table, {col_decimal}, &array, &schema), LogicError);
+}
+
+TEST(Table_SetColumnValues)
+{
+    Group g;
+    TableRef table = g.add_table("table");
+    TableRef target = g.add_table("target");
+    auto col_int = table->add_column(type_Int, "int");
+    auto col_str = table->add_column(type_String, "str", true);
+    auto col_double = table->add_column(type_Double, "double");
+    auto col_link = table->add_column_link(type_Link, "link", *target);
+    table->add_search_index(col_int);
+    table->add_search_index(col_str);
+    ObjKey target_key = target->create_object().get_key();
+
+    const size_t num_rows = 3 * REALM_MAX_BPNODE_SIZE + 11;
+    std::vector<ObjKey> keys;
+    for (size_t i = 0; i < num_rows; i++) {
+        keys.push_back(table->create_object(ObjKey(2 * i)).set(col_int, int64_t(i)).get_key());
+    }
+
+    // Keys in descending order, with the last value winning for a repeated key
+    std::vector<ObjKey> some_keys;
+    std::vector<Mixed> values;
+    for (size_t n = 0; 3 * n < num_rows; n++) {
+        size_t i = num_rows - 1 - 3 * n;
+        some_keys.push_back(keys[i]);
+        values.push_back(Mixed(int64_t(100000 + i)));
+    }
+    some_keys.push_back(keys[num_rows - 1]);
+    values.push_back(Mixed(int64_t(-1)));
+    table->set_column_values(col_int, some_keys, values);
+    for (size_t i = 0; i < num_rows; i++) {
+        int64_t expected = i;
+        if (i == num_rows - 1)
+            expected = -1;
+        else if ((num_rows - 1 - i) % 3 == 0)
+            expected = 100000 + i;
+        CHECK_EQUAL(table->get_object(keys[i]).get<Int>(col_int), expected);
+    }
+    CHECK_EQUAL(table->find_first_int(col_int, -1), keys[num_rows - 1]);
+    CHECK_EQUAL(table->find_first_int(col_int, int64_t(num_rows - 4)), ObjKey());
+    CHECK_EQUAL(table->where().greater(col_int, 100000).count(), some_keys.size() - 2);
+
+    // One value for all objects, including null
+    table->set_column_values(col_str, keys, Mixed(StringData("archived")));
+    CHECK_EQUAL(table->where().equal(col_str, "archived").count(), num_rows);
+    table->set_column_values(col_str, {keys[1], keys[2]}, Mixed());
+    CHECK(table->get_object(keys[1]).is_null(col_str));
+    CHECK_EQUAL(table->where().equal(col_str, realm::null()).count(), 2);
+    CHECK_EQUAL(table->find_first_string(col_str, "archived"), keys[0]);
+
+    table->set_column_values(col_link, {keys[0], keys[3]}, Mixed(target_key));
+    CHECK_EQUAL(target->get_object(target_key).get_backlink_count(), 2);
+    CHECK_THROW(table->set_column_values(col_link, {keys[1], ObjKey(1), keys[2]}, Mixed(target_key)), KeyNotFound);
+    CHECK_THROW(table->set_column_values(col_link, {keys[1], keys[2]},
+                                         std::vector<Mixed>{Mixed(target_key), Mixed(ObjKey(17))}),
+                LogicError);
+    CHECK_THROW(table->set_column_values(col_link, {keys[1]}, Mixed(int64_t(1))), LogicError);
+    CHECK_EQUAL(target->get_object(target_key).get_backlink_count(), 2);
+    CHECK_NOT(table->get_object(keys[1]).get<ObjKey>(col_link));
+
+    // Nothing is changed if the arguments are wrong
+    CHECK_THROW(table->set_column_values(col_double, {keys[0], ObjKey(1)}, Mixed(1.5)), KeyNotFound);
+    CHECK_THROW(table->set_column_values(col_double, {keys[0]}, Mixed(int64_t(1))), LogicError);
+    CHECK_THROW(table->set_column_values(col_double, {keys[0]}, Mixed()), LogicError);
+    CHECK_THROW(table->set_column_values(col_double, {keys[0]}, std::vector<Mixed>{}), LogicError);
+    CHECK_EQUAL(table->get_object(keys[0]).get<Double>(col_double), 0.);
+
+    size_t count = table->where().less(col_int, 100).set(col_double, Mixed(2.5));
+    CHECK_EQUAL(count, table->where().equal(col_double, 2.5).count());
+    CHECK_EQUAL(count, table->where().less(col_int, 100).count());
+    table->verify();
+}
+
 TEST(Table_IndexStringDelete)
 {
     Table t;
@@ -4277,6 +5095,85 @@ TEST(Table_SearchIndexFindAll)
     CHECK_EQUAL(tv.size(), 6);
 }
 
+TEST(Table_ColumnStatistics)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history(path));
+    DBRef db = DB::create(*hist, DBOptions(crypt_key()));
+    ColKey col_int;
+    ColKey col_double;
+    ColKey col_string;
+    ColKey col_link;
+    {
+        WriteTransaction wt(db);
+        auto table = wt.add_table("table");
+        col_int = table->add_column(type_Int, "int", true);
+        col_double = table->add_column(type_Double, "double");
+        col_string = table->add_column(type_String, "string");
+        col_link = table->add_column_link(type_Link, "link", *table);
+        for (int i = 0; i < 1000; ++i) {
+            Obj obj = table->create_object();
+            if (i % 4)
+                obj.set(col_int, i % 10);
+            obj.set(col_double, i * 0.5);
+            obj.set(col_string, util::format("s%1", i % 50));
+        }
+        CHECK_NOT(table->get_statistics(col_int));
+        CHECK_THROW_ANY(table->update_statistics(col_link));
+        table->update_statistics();
+        wt.commit();
+    }
+
+    // The statistics are read back from the file
+    ReadTransaction rt(db);
+    auto table = rt.get_table("table");
+    CHECK_NOT(table->get_statistics(col_link));
+
+    auto stats = table->get_statistics(col_int);
+    CHECK(stats);
+    CHECK_EQUAL(stats->row_count, 1000);
+    CHECK_EQUAL(stats->null_count, 250);
+    CHECK_EQUAL(stats->distinct_count, 10);
+    CHECK_EQUAL(stats->histogram.front(), 0);
+    CHECK_EQUAL(stats->histogram.back(), 9);
+    CHECK_APPROXIMATELY_EQUAL(stats->null_fraction(), 0.25, 1e-9);
+    CHECK_APPROXIMATELY_EQUAL(stats->equal_fraction(3.0), 0.075, 1e-9);
+    CHECK_EQUAL(stats->equal_fraction(10.0), 0);
+    CHECK_EQUAL(stats->less_fraction(0, false), 0);
+    CHECK_APPROXIMATELY_EQUAL(stats->less_fraction(9, true), 0.75, 1e-9);
+
+    stats = table->get_statistics(col_double);
+    CHECK(stats);
+    CHECK_EQUAL(stats->null_count, 0);
+    // The number of distinct values is an estimate
+    CHECK_GREATER(stats->distinct_count, 900);
+    CHECK_LESS(stats->distinct_count, 1100);
+    CHECK_EQUAL(stats->histogram.size(), 17);
+    CHECK_EQUAL(stats->histogram.front(), 0);
+    CHECK_EQUAL(stats->histogram.back(), 499.5);
+    CHECK_APPROXIMATELY_EQUAL(stats->less_fraction(125, false), 0.25, 0.01);
+    CHECK_APPROXIMATELY_EQUAL(stats->less_fraction(400, true), 0.8, 0.01);
+
+    stats = table->get_statistics(col_string);
+    CHECK(stats);
+    CHECK_GREATER(stats->distinct_count, 45);
+    CHECK_LESS(stats->distinct_count, 55);
+    CHECK(stats->histogram.empty());
+    CHECK_LESS(stats->less_fraction(0, false), 0);
+
+    // Statistics go away with their column
+    {
+        WriteTransaction wt(db);
+        auto t = wt.get_table("table");
+        t->remove_column(col_string);
+        CHECK_NOT(t->get_statistics(col_string));
+        CHECK(t->get_statistics(col_int));
+        t->update_statistics(col_int);
+        CHECK_EQUAL(t->get_statistics(col_int)->row_count, 1000);
+        wt.commit();
+    }
+}
+
 TEST(Table_QueryNullOnNonNullSearchIndex)
 {
     Group g;
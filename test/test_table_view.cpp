@@ -26,6 +26,8 @@
 #include <cwchar>
 
 #include <realm.hpp>
+#include <realm/history.hpp>
+#include <realm/object_change_set.hpp>
 
 #include "util/misc.hpp"
 
@@ -2931,4 +2933,200 @@ TEST(TableView_TimestampMaxRemoveRow)
     CHECK_EQUAL(tv.maximum_timestamp(col_date), Timestamp(8, 0));
 }
 
+TEST(TableView_IncrementalSync)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history(path));
+    DBRef db = DB::create(*hist);
+    ColKey col_age;
+    ColKey col_name;
+    std::vector<ObjKey> keys;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        col_age = table->add_column(type_Int, "age", true);
+        col_name = table->add_column(type_String, "name");
+        for (int i = 0; i < 3000; ++i) {
+            keys.push_back(table->create_object().set(col_age, i % 100).set(col_name, util::to_string(i % 7)).get_key());
+        }
+        wt->commit();
+    }
+
+    auto rt = db->start_read();
+    ConstTableRef table = rt->get_table("table");
+    ConstTableView unsorted = table->where().greater(col_age, 50).find_all();
+    ConstTableView sorted = table->where().greater(col_age, 50).find_all();
+    // Many objects compare equal on age
+    sorted.sort(col_age, false);
+    ConstTableView two_columns = table->where().equal(col_name, "3").find_all();
+    two_columns.sort(SortDescriptor({{col_name}, {col_age}}, {true, true}));
+
+    auto check_view = [&](const ConstTableView& view, const ConstTableView& expected) {
+        CHECK(view.is_in_sync());
+        if (CHECK_EQUAL(view.size(), expected.size())) {
+            for (size_t i = 0; i < view.size(); ++i) {
+                CHECK_EQUAL(view.get_key(i), expected.get_key(i));
+            }
+        }
+    };
+    auto check = [&](const ObjectChangeSet& changes) {
+        unsorted.sync_if_needed(changes);
+        sorted.sync_if_needed(changes);
+        two_columns.sync_if_needed(changes);
+
+        ConstTableView expected = table->where().greater(col_age, 50).find_all();
+        check_view(unsorted, expected);
+        expected.sort(col_age, false);
+        check_view(sorted, expected);
+        expected = table->where().equal(col_name, "3").find_all();
+        expected.sort(SortDescriptor({{col_name}, {col_age}}, {true, true}));
+        check_view(two_columns, expected);
+    };
+
+    for (int round = 0; round < 5; ++round) {
+        {
+            auto wt = db->start_write();
+            auto t = wt->get_table("table");
+            // Move objects into, out of and within the views
+            for (int i = round; i < 3000; i += 97) {
+                Obj obj = t->get_object(keys[i]);
+                obj.set(col_age, (i + round * 31) % 100);
+            }
+            t->get_object(keys[round * 10 + 1]).set_null(col_age);
+            t->get_object(keys[round * 10 + 2]).set(col_name, "3");
+            t->remove_object(keys[round * 10 + 5]);
+            t->create_object().set(col_age, 75).set(col_name, "3");
+            wt->commit();
+        }
+        ObjectChangeSet changes;
+        auto version = table->get_content_version();
+        rt->advance_read(&changes);
+        CHECK_NOT(changes.get_changed_objects(table->get_key()).empty());
+        CHECK(changes.covers_versions(table->get_key(), version, table->get_content_version()));
+        check(changes);
+    }
+
+    // Changes accumulated over several transactions
+    ObjectChangeSet changes;
+    for (int i = 0; i < 3; ++i) {
+        {
+            auto wt = db->start_write();
+            auto t = wt->get_table("table");
+            t->get_object(keys[100 + i]).set(col_age, 99 - i);
+            t->remove_object(keys[200 + i]);
+            wt->commit();
+        }
+        rt->advance_read(&changes);
+    }
+    check(changes);
+
+    // Too many changes, and changes to the columns, make the views rerun their queries
+    {
+        auto wt = db->start_write();
+        auto t = wt->get_table("table");
+        for (auto& obj : *t) {
+            obj.set(col_age, obj.get<util::Optional<Int>>(col_age).value_or(0) + 1);
+        }
+        wt->commit();
+    }
+    changes.clear();
+    rt->advance_read(&changes);
+    check(changes);
+    {
+        auto wt = db->start_write();
+        auto t = wt->get_table("table");
+        t->add_column(type_Int, "other");
+        t->get_object(keys[500]).set(col_age, 70);
+        wt->commit();
+    }
+    changes.clear();
+    rt->advance_read(&changes);
+    CHECK_NOT(changes.has_object_changes_only(table->get_key()));
+    check(changes);
+
+    // Changes missed by the change set make the views rerun their queries
+    for (int i = 0; i < 2; ++i) {
+        {
+            auto wt = db->start_write();
+            auto t = wt->get_table("table");
+            t->get_object(keys[600 + i]).set(col_age, 60 + i);
+            t->get_object(keys[700 + i]).set(col_name, "3");
+            wt->commit();
+        }
+        changes.clear();
+        if (i == 0)
+            rt->advance_read();
+        else
+            rt->advance_read(&changes);
+    }
+    CHECK_NOT(changes.covers_versions(table->get_key(), 0, table->get_content_version()));
+    check(changes);
+}
+
+TEST(TableView_IncrementalSyncSelfLinks)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history(path));
+    DBRef db = DB::create(*hist);
+    ColKey col_age;
+    ColKey col_parent;
+    ObjKey child;
+    ObjKey parent;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        col_age = table->add_column(type_Int, "age");
+        col_parent = table->add_column_link(type_Link, "parent", *table);
+        parent = table->create_object().set(col_age, 1).get_key();
+        child = table->create_object().set(col_age, 2).set(col_parent, parent).get_key();
+        for (int i = 0; i < 100; ++i)
+            table->create_object().set(col_age, 3);
+        wt->commit();
+    }
+
+    auto rt = db->start_read();
+    ConstTableRef table = rt->get_table("table");
+    Query by_parent = table->link(col_parent).column<Int>(col_age) > 5;
+    Query by_subquery = table->column<Link>(col_parent, table->column<Int>(col_age) > 5).count() >= 1;
+    Query by_child_age = table->backlink(*table, col_parent).column<Int>(col_age) > 5;
+    ConstTableView parent_view = by_parent.find_all();
+    ConstTableView child_view = by_child_age.find_all();
+    ConstTableView subquery_view = by_subquery.find_all();
+    CHECK_EQUAL(parent_view.size(), 0);
+    CHECK_EQUAL(child_view.size(), 0);
+    CHECK_EQUAL(subquery_view.size(), 0);
+
+    auto check = [&](ObjKey parent_view_match, ObjKey child_view_match) {
+        ObjectChangeSet changes;
+        rt->advance_read(&changes);
+        CHECK(changes.has_object_changes_only(table->get_key()));
+        parent_view.sync_if_needed(changes);
+        child_view.sync_if_needed(changes);
+        subquery_view.sync_if_needed(changes);
+        CHECK_EQUAL(parent_view.size(), by_parent.count());
+        CHECK_EQUAL(subquery_view.size(), by_subquery.count());
+        CHECK_EQUAL(child_view.size(), by_child_age.count());
+        if (CHECK_EQUAL(parent_view.size(), parent_view_match ? 1 : 0) && parent_view_match)
+            CHECK_EQUAL(parent_view.get_key(0), parent_view_match);
+        if (CHECK_EQUAL(subquery_view.size(), parent_view_match ? 1 : 0) && parent_view_match)
+            CHECK_EQUAL(subquery_view.get_key(0), parent_view_match);
+        if (CHECK_EQUAL(child_view.size(), child_view_match ? 1 : 0) && child_view_match)
+            CHECK_EQUAL(child_view.get_key(0), child_view_match);
+    };
+
+    // Only the linked object changes, so the views must rerun their queries
+    {
+        auto wt = db->start_write();
+        wt->get_table("table")->get_object(parent).set(col_age, 10);
+        wt->commit();
+    }
+    check(child, ObjKey());
+    {
+        auto wt = db->start_write();
+        wt->get_table("table")->get_object(child).set(col_age, 10);
+        wt->commit();
+    }
+    check(child, parent);
+}
+
 #endif // TEST_TABLE_VIEW